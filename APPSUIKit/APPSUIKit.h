@@ -41,6 +41,8 @@ FOUNDATION_EXPORT const unsigned char APPSUIKitVersionString[];
 #import <APPSUIKit/APPSSimplePresentationController.h>
 #import <APPSUIKit/APPSContainerView.h>
 #import <APPSUIKit/APPSTaggedNaming.h>
+#import <APPSUIKit/APPSPrewarming.h>
+#import <APPSUIKit/APPSTransitionMetrics.h>
 #import <APPSUIKit/APPSViewControllerInfoStackEntry.h>
 #import <APPSUIKit/APPSLayoutConstraintConfiguration.h>
 #import <APPSUIKit/APPSSegmentedDataSource.h>
@@ -69,6 +71,20 @@ FOUNDATION_EXPORT const unsigned char APPSUIKitVersionString[];
 #import <APPSUIKit/APPSCountryPickerField.h>
 #import <APPSUIKit/APPSBlurPresentingViewPresentationController.h>
 #import <APPSUIKit/APPSUIKitTypeDefs.h>
+#import <APPSUIKit/APPSInstantiationPool.h>
 #import <APPSUIKit/APPSSingleComponentPickerController.h>
 #import <APPSUIKit/APPSStateMachine.h>
+#import <APPSUIKit/APPSIdentifiable.h>
+#import <APPSUIKit/APPSDataSourceDiff.h>
+#import <APPSUIKit/APPSRowHeightCache.h>
+#import <APPSUIKit/APPSTextLayoutSpec.h>
+#import <APPSUIKit/APPSFilteredDataSource.h>
+#import <APPSUIKit/APPSSortedDataSource.h>
+#import <APPSUIKit/APPSCollationSorter.h>
+#import <APPSUIKit/APPSOutlineDataSource.h>
+#import <APPSUIKit/APPSMergedDataSource.h>
+#import <APPSUIKit/APPSStreamingDataSource.h>
+#import <APPSUIKit/APPSPagedDataSource.h>
+#import <APPSUIKit/APPSItemVector.h>
+#import <APPSUIKit/APPSItemPatch.h>
 
@@ -27,6 +27,10 @@
  If we don't find a storyboard that has the device specific name, we'll then
  return the storyboard (if found) with just the base name.
 
+ Resolved names and the storyboards themselves are cached for the life of the process,
+ per base name, bundle and device idiom, so that only the first request for a storyboard
+ probes the bundles. The storyboard instances are let go of under memory pressure.
+
  @param baseName The name of the storyboard to instantiate, without its device
  specific suffix.
  @return The device appropriate UIStoryboard.
@@ -75,6 +79,40 @@
                                             bundle:(NSBundle *)bundle;
 
 
+/**
+ Tells the shared APPSInstantiationPool to keep an instance of this view controller ready, for when we
+ next instantiate it through `apps_instantiateViewControllerWithIdentifier:fromStoryboardWithBaseName:bundle:`.
+ Use it for the screens the user is likely to go to next.
+
+ @param viewControllerIdentifier The identifier of the view controller in the storyboard.
+ @param storyboardBaseName The baseName of the storyboard without the device specific portion.
+ @param bundle The bundle to look for the storyboard in first.
+ @param loadsView Whether to load the pooled instance's view ahead of time too.
+ */
+- (void)apps_registerLikelyViewControllerWithIdentifier:(NSString *)viewControllerIdentifier
+                             fromStoryboardWithBaseName:(NSString *)storyboardBaseName
+                                                 bundle:(NSBundle *)bundle
+                                              loadsView:(BOOL)loadsView;
+
+
+
+#pragma mark - Storyboard Caching
+
+/**
+ Lists the storyboards in a bundle once, typically at launch, so that looking up storyboards
+ in that bundle never has to probe the file system for them.
+
+ @param bundle The bundle whose storyboards to list.
+ */
++ (void)apps_registerStoryboardManifestForBundle:(NSBundle *)bundle;
+
+
+/**
+ Forgets every resolved storyboard name, storyboard instance and bundle manifest we've cached.
+ */
++ (void)apps_purgeStoryboardCache;
+
+
 
 #pragma mark - Storyboard Convenience Wrappers
 
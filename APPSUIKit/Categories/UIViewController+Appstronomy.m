@@ -6,10 +6,74 @@
 //
 
 @import APPSFoundation;
+@import Darwin.os.lock;
 
 #import "UIViewController+Appstronomy.h"
+#import "APPSInstantiationPool.h"
 #import <APPSUIKit/APPSUIKit-Swift.h>
 
+/**
+ What a storyboard base name resolved to, for one bundle and device idiom: the storyboard's exact name and the bundle
+ it was found in (both nil when there's no such storyboard), and the storyboard itself, once instantiated.
+ */
+@interface APPSResolvedStoryboard : NSObject
+@property (copy, nonatomic) NSString *name;
+@property (strong, nonatomic) NSBundle *bundle;
+@property (strong, nonatomic) UIStoryboard *storyboard;
+@end
+
+@implementation APPSResolvedStoryboard
+@end
+
+
+// Process-wide storyboard caches, guarded by the lock:
+static os_unfair_lock APPSStoryboardCacheLock = OS_UNFAIR_LOCK_INIT;
+static NSMutableDictionary<NSString *, APPSResolvedStoryboard *> *APPSResolvedStoryboards; // "baseName|bundle path|idiom" -> resolution
+static NSMutableDictionary<NSString *, NSSet<NSString *> *> *APPSStoryboardManifests; // Bundle path -> names of the storyboards in it
+
+
+static void APPSStoryboardCachesInitialize(void)
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        APPSResolvedStoryboards = [NSMutableDictionary dictionary];
+        APPSStoryboardManifests = [NSMutableDictionary dictionary];
+
+        // The storyboard instances are cheap to recreate from their resolved names, so let them go under memory pressure:
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification *note) {
+            os_unfair_lock_lock(&APPSStoryboardCacheLock);
+            for (APPSResolvedStoryboard *resolved in APPSResolvedStoryboards.objectEnumerator) {
+                resolved.storyboard = nil;
+            }
+            os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+        }];
+    });
+}
+
+
+static NSString *APPSStoryboardCacheKey(NSString *baseName, NSBundle *bundle)
+{
+    return [NSString stringWithFormat:@"%@|%@|%ld", baseName, bundle.bundlePath ?: @"-",
+            (long)[UIDevice currentDevice].userInterfaceIdiom];
+}
+
+
+/// What baseName has resolved to in bundle so far, or nil when we haven't looked it up yet.
+static APPSResolvedStoryboard *APPSResolvedStoryboardForBaseName(NSString *baseName, NSBundle *bundle)
+{
+    APPSStoryboardCachesInitialize();
+    os_unfair_lock_lock(&APPSStoryboardCacheLock);
+    APPSResolvedStoryboard *resolved = APPSResolvedStoryboards[APPSStoryboardCacheKey(baseName, bundle)];
+    os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+
+    return resolved;
+}
+
+
+
 @implementation UIViewController (Appstronomy)
 
 
@@ -49,6 +113,19 @@
 
 - (BOOL)apps_doesStoryboardExistWithExactName:(NSString *)exactName bundle:(NSBundle *)bundle;
 {
+    // Do we have a manifest of this bundle's storyboards? If so, there's no need to go to the file system:
+    NSSet *manifest = nil;
+    if (bundle.bundlePath) {
+        APPSStoryboardCachesInitialize();
+        os_unfair_lock_lock(&APPSStoryboardCacheLock);
+        manifest = APPSStoryboardManifests[bundle.bundlePath];
+        os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+    }
+
+    if (manifest) {
+        return [manifest containsObject:exactName];
+    }
+
     NSString *path = [bundle pathForResource:exactName ofType:@"storyboard"];
     
     if (!path) { path = [bundle pathForResource:exactName ofType:@"storyboardc"]; };
@@ -77,8 +154,28 @@
 
 - (UIStoryboard *)apps_storyboardWithBaseName:(NSString *)baseName bundle:(NSBundle *)bundle;
 {
-    UIStoryboard *storyboard = nil;
-    
+    APPSStoryboardCachesInitialize();
+    NSString *cacheKey = APPSStoryboardCacheKey(baseName, bundle);
+
+    os_unfair_lock_lock(&APPSStoryboardCacheLock);
+    APPSResolvedStoryboard *resolved = APPSResolvedStoryboards[cacheKey];
+    UIStoryboard *storyboard = resolved.storyboard;
+    os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+
+    // Have we resolved this base name before?
+    if (resolved) {
+        // YES: If we let go of the storyboard instance under memory pressure, recreate it from its resolved name:
+        if (!storyboard && resolved.name) {
+            storyboard = [UIStoryboard storyboardWithName:resolved.name bundle:resolved.bundle];
+
+            os_unfair_lock_lock(&APPSStoryboardCacheLock);
+            resolved.storyboard = storyboard;
+            os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+        }
+
+        return storyboard;
+    }
+
     // Try finding the storyboard (device specific or just the base version) in the specified bundle:
     NSBundle *resolvedBundle = bundle;
     NSString *resolvedStoryboardName = [self resolvedNameForStoryboardWithBaseName:baseName bundle:resolvedBundle];
@@ -113,6 +210,16 @@
         // YES: So we know it is safe to attempt to load that storyboard.
         storyboard = [UIStoryboard storyboardWithName:resolvedStoryboardName bundle:resolvedBundle];
     }
+
+    // Remember the outcome, including not finding anything, so that we never probe the bundles for this name again:
+    resolved = [[APPSResolvedStoryboard alloc] init];
+    resolved.name = resolvedStoryboardName;
+    resolved.bundle = (resolvedStoryboardName ? resolvedBundle : nil);
+    resolved.storyboard = storyboard;
+
+    os_unfair_lock_lock(&APPSStoryboardCacheLock);
+    APPSResolvedStoryboards[cacheKey] = resolved;
+    os_unfair_lock_unlock(&APPSStoryboardCacheLock);
     
     return storyboard;
 }
@@ -223,9 +330,18 @@
     logDebug(@"Looking for view controller with identifier: '%@' in storyboard with base name: '%@' "
             "found in bundle with path: '%@'", viewControllerIdentifier, storyboardBaseName, bundle.bundleURL);
     
-    UIStoryboard     *storyboard = [self apps_storyboardWithBaseName:storyboardBaseName bundle:bundle];
-    UIViewController *viewController = [self apps_instantiateViewControllerWithIdentifier:viewControllerIdentifier
-                                                                           fromStoryboard:storyboard];
+    UIStoryboard           *storyboard = [self apps_storyboardWithBaseName:storyboardBaseName bundle:bundle];
+    APPSResolvedStoryboard *resolved   = APPSResolvedStoryboardForBaseName(storyboardBaseName, bundle);
+
+    // Is an instance already waiting for us in the pre-instantiation pool?
+    UIViewController *viewController = [[APPSInstantiationPool sharedPool] dequeueViewControllerWithIdentifier:viewControllerIdentifier
+                                                                                                storyboardName:resolved.name
+                                                                                                        bundle:resolved.bundle];
+    if (!viewController) {
+        // NO: Make one now.
+        viewController = [self apps_instantiateViewControllerWithIdentifier:viewControllerIdentifier
+                                                             fromStoryboard:storyboard];
+    }
 
     if (!viewController) {
         storyboard = [self apps_storyboardWithExactName:storyboardBaseName
@@ -246,6 +362,61 @@
 }
 
 
+- (void)apps_registerLikelyViewControllerWithIdentifier:(NSString *)viewControllerIdentifier
+                             fromStoryboardWithBaseName:(NSString *)storyboardBaseName
+                                                 bundle:(NSBundle *)bundle
+                                              loadsView:(BOOL)loadsView
+{
+    // Resolve the base name the same way instantiation will, so that the pool's instances are the ones it asks for:
+    [self apps_storyboardWithBaseName:storyboardBaseName bundle:bundle];
+    APPSResolvedStoryboard *resolved = APPSResolvedStoryboardForBaseName(storyboardBaseName, bundle);
+
+    if (!resolved.name) {
+        logInfo(@"Not pre-instantiating '%@': found no storyboard with base name '%@'.", viewControllerIdentifier, storyboardBaseName);
+        return;
+    }
+
+    [[APPSInstantiationPool sharedPool] registerViewControllerWithIdentifier:viewControllerIdentifier
+                                                              storyboardName:resolved.name
+                                                                      bundle:resolved.bundle
+                                                                   loadsView:loadsView];
+}
+
+
+
+
+
+#pragma mark - Storyboard Caching
+
++ (void)apps_registerStoryboardManifestForBundle:(NSBundle *)bundle
+{
+    if (!bundle.bundlePath) {
+        return;
+    }
+
+    // One walk of the bundle's resources, in place of every per-name probe we'd otherwise make:
+    NSMutableSet *names = [NSMutableSet set];
+    for (NSString *type in @[@"storyboardc", @"storyboard"]) {
+        for (NSString *path in [bundle pathsForResourcesOfType:type inDirectory:nil]) {
+            [names addObject:[[path lastPathComponent] stringByDeletingPathExtension]];
+        }
+    }
+
+    APPSStoryboardCachesInitialize();
+    os_unfair_lock_lock(&APPSStoryboardCacheLock);
+    APPSStoryboardManifests[bundle.bundlePath] = names;
+    os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+}
+
+
++ (void)apps_purgeStoryboardCache
+{
+    APPSStoryboardCachesInitialize();
+    os_unfair_lock_lock(&APPSStoryboardCacheLock);
+    [APPSResolvedStoryboards removeAllObjects];
+    [APPSStoryboardManifests removeAllObjects];
+    os_unfair_lock_unlock(&APPSStoryboardCacheLock);
+}
 
 
 
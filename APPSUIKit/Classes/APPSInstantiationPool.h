@@ -0,0 +1,79 @@
+//
+//  APPSInstantiationPool.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import UIKit;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A pool of view controllers, instantiated from storyboards and nibs before they're asked for, so that presenting a
+ heavy screen doesn't start with decoding its archive.
+
+ Callers register the view controllers likely to be needed next. Nib files are read on a background queue, and a
+ storyboard is opened once per registration. The instances themselves, which UIKit only allows on the main thread,
+ are made during idle passes of the main run loop, one per pass, and kept up to maximumInstancesPerRegistration.
+ Taking an instance for a registration counts as a hit, or as a miss when none was ready; unregistered requests
+ aren't counted.
+
+ Must be used from the main thread. Pooled instances are let go of under memory pressure.
+ */
+@interface APPSInstantiationPool : NSObject
+
+/// The pool the kit's own instantiation methods draw from.
++ (instancetype)sharedPool;
+
+/// The number of ready instances to keep per registration. Defaults to 1.
+@property (nonatomic) NSUInteger maximumInstancesPerRegistration;
+
+
+#pragma mark - Registering
+
+/// Keep instances of the view controller with identifier, in the storyboard named storyboardName in bundle, ready. When loadsView is YES, their views are loaded ahead of time too.
+- (void)registerViewControllerWithIdentifier:(NSString *)identifier storyboardName:(NSString *)storyboardName bundle:(nullable NSBundle *)bundle loadsView:(BOOL)loadsView;
+
+/// Keep instances of viewControllerClass, initialized with the nib named nibName in bundle, ready. When loadsView is YES, their views are loaded ahead of time too.
+- (void)registerViewControllerClass:(Class)viewControllerClass nibName:(NSString *)nibName bundle:(nullable NSBundle *)bundle loadsView:(BOOL)loadsView;
+
+/// Stop keeping instances ready for every registration, and let go of those that are.
+- (void)removeAllRegistrations;
+
+
+#pragma mark - Taking Instances
+
+/// A ready instance of the view controller with identifier, in the storyboard named storyboardName in bundle, or nil when there's none.
+- (nullable __kindof UIViewController *)dequeueViewControllerWithIdentifier:(NSString *)identifier storyboardName:(NSString *)storyboardName bundle:(nullable NSBundle *)bundle;
+
+/// A ready instance of viewControllerClass with the nib named nibName in bundle, or nil when there's none.
+- (nullable __kindof UIViewController *)dequeueViewControllerOfClass:(Class)viewControllerClass nibName:(NSString *)nibName bundle:(nullable NSBundle *)bundle;
+
+
+#pragma mark - Nibs
+
+/// The nib named nibName in bundle, read once and then shared.
+- (UINib *)nibWithNibName:(NSString *)nibName bundle:(nullable NSBundle *)bundle;
+
+/// Read the nib named nibName in bundle on a background queue, so that -nibWithNibName:bundle: finds it ready.
+- (void)prepareNibWithNibName:(NSString *)nibName bundle:(nullable NSBundle *)bundle;
+
+/// Load viewController's view from its nib as read by -nibWithNibName:bundle:, rather than have UIKit read the nib again by name. Call it from -loadView, falling back to super when it returns NO, as it does for controllers that don't come from a nib of their own.
+- (BOOL)loadViewFromNibOfViewController:(UIViewController *)viewController;
+
+
+#pragma mark - Statistics
+
+/// The number of requests for registered view controllers that found an instance ready.
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+/// The number of requests for registered view controllers that found none ready.
+@property (nonatomic, readonly) NSUInteger missCount;
+
+/// Each registration's description, mapped to a dictionary of its "hits", "misses" and "ready" instance counts.
+- (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,335 @@
+//
+//  APPSInstantiationPool.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSInstantiationPool.h"
+
+/// What the pool knows about one registered view controller: how to make it, and the instances made so far.
+@interface APPSPoolRegistration : NSObject
+@property (nonatomic, copy) UIViewController *(^makeInstance)(void);
+/// The nib instances load their views from, which is read before one is made. Nil for storyboards.
+@property (nonatomic, copy) NSString *nibName;
+@property (nonatomic, strong) NSBundle *nibBundle;
+@property (nonatomic) BOOL loadsView;
+@property (nonatomic, strong) NSMutableArray<UIViewController *> *instances;
+@property (nonatomic) NSUInteger hits;
+@property (nonatomic) NSUInteger misses;
+@end
+
+@implementation APPSPoolRegistration
+@end
+
+
+
+@implementation APPSInstantiationPool {
+    /// Registration key → registration, in the order registered.
+    NSMutableDictionary<NSString *, APPSPoolRegistration *> *_registrations;
+    NSMutableArray<NSString *> *_registrationKeys;
+    /// "nibName|bundle path" → the nib, read once.
+    NSMutableDictionary<NSString *, UINib *> *_nibs;
+    /// Keys of the nibs being read in the background.
+    NSMutableSet<NSString *> *_nibsBeingRead;
+    BOOL _refillScheduled;
+}
+
+
+#pragma mark - Instantiation
+
++ (instancetype)sharedPool
+{
+    static APPSInstantiationPool *sharedPool;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPool = [[self alloc] init];
+    });
+    return sharedPool;
+}
+
+
+- (instancetype)init
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _maximumInstancesPerRegistration = 1;
+    _registrations = [NSMutableDictionary dictionary];
+    _registrationKeys = [NSMutableArray array];
+    _nibs = [NSMutableDictionary dictionary];
+    _nibsBeingRead = [NSMutableSet set];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+}
+
+
+
+#pragma mark - Registering
+
+- (void)registerViewControllerWithIdentifier:(NSString *)identifier storyboardName:(NSString *)storyboardName bundle:(NSBundle *)bundle loadsView:(BOOL)loadsView
+{
+    NSParameterAssert(identifier != nil);
+    NSParameterAssert(storyboardName != nil);
+
+    // Check the name now, rather than have an idle pass raise on it later:
+    BOOL exists = [(bundle ?: [NSBundle mainBundle]) pathForResource:storyboardName ofType:@"storyboardc"] != nil;
+    NSAssert(exists, @"Found no storyboard named '%@' to pre-instantiate '%@' from", storyboardName, identifier);
+    if (!exists)
+        return;
+
+    // One storyboard serves every instance, so its Info.plist is only read once:
+    UIStoryboard *storyboard = [UIStoryboard storyboardWithName:storyboardName bundle:bundle];
+
+    [self registerKey:[self keyForIdentifier:identifier storyboardName:storyboardName bundle:bundle] nibName:nil bundle:nil loadsView:loadsView makeInstance:^UIViewController *{
+        return [storyboard instantiateViewControllerWithIdentifier:identifier];
+    }];
+}
+
+
+- (void)registerViewControllerClass:(Class)viewControllerClass nibName:(NSString *)nibName bundle:(NSBundle *)bundle loadsView:(BOOL)loadsView
+{
+    NSParameterAssert([viewControllerClass isSubclassOfClass:[UIViewController class]]);
+    NSParameterAssert(nibName != nil);
+
+    // Read the nib's file off the main thread while we wait for an idle moment to make the instance:
+    [self prepareNibWithNibName:nibName bundle:bundle];
+
+    // The instance's -loadView should call -loadViewFromNibOfViewController:, so that its view comes from the nib read here.
+    [self registerKey:[self keyForClass:viewControllerClass nibName:nibName bundle:bundle] nibName:nibName bundle:bundle loadsView:loadsView makeInstance:^UIViewController *{
+        return [[viewControllerClass alloc] initWithNibName:nibName bundle:bundle];
+    }];
+}
+
+
+- (void)removeAllRegistrations
+{
+    [_registrations removeAllObjects];
+    [_registrationKeys removeAllObjects];
+}
+
+
+
+#pragma mark - Taking Instances
+
+- (UIViewController *)dequeueViewControllerWithIdentifier:(NSString *)identifier storyboardName:(NSString *)storyboardName bundle:(NSBundle *)bundle
+{
+    if (!identifier || !storyboardName)
+        return nil;
+
+    return [self dequeueInstanceForKey:[self keyForIdentifier:identifier storyboardName:storyboardName bundle:bundle]];
+}
+
+
+- (UIViewController *)dequeueViewControllerOfClass:(Class)viewControllerClass nibName:(NSString *)nibName bundle:(NSBundle *)bundle
+{
+    if (!viewControllerClass || !nibName)
+        return nil;
+
+    return [self dequeueInstanceForKey:[self keyForClass:viewControllerClass nibName:nibName bundle:bundle]];
+}
+
+
+
+#pragma mark - Nibs
+
+- (UINib *)nibWithNibName:(NSString *)nibName bundle:(NSBundle *)bundle
+{
+    NSString *key = [self keyForNibName:nibName bundle:bundle];
+    UINib *nib = _nibs[key];
+    if (!nib) {
+        nib = [UINib nibWithNibName:nibName bundle:bundle];
+        _nibs[key] = nib;
+    }
+    return nib;
+}
+
+
+- (void)prepareNibWithNibName:(NSString *)nibName bundle:(NSBundle *)bundle
+{
+    NSString *key = [self keyForNibName:nibName bundle:bundle];
+    if (_nibs[key] || [_nibsBeingRead containsObject:key])
+        return;
+
+    [_nibsBeingRead addObject:key];
+
+    // Reading a nib is safe off the main thread; only instantiating its contents isn't.
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        UINib *nib = [UINib nibWithNibName:nibName bundle:bundle];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self->_nibsBeingRead removeObject:key];
+            if (!self->_nibs[key])
+                self->_nibs[key] = nib;
+
+            // Registrations waiting on this nib can make their instances now:
+            [self scheduleRefill];
+        });
+    });
+}
+
+
+- (BOOL)loadViewFromNibOfViewController:(UIViewController *)viewController
+{
+    // Storyboard scenes name nibs inside the compiled storyboard, which only UIKit can find.
+    if (!viewController.nibName || viewController.storyboard)
+        return NO;
+
+    UINib *nib = [self nibWithNibName:viewController.nibName bundle:viewController.nibBundle];
+    [nib instantiateWithOwner:viewController options:nil];
+    return viewController.isViewLoaded;
+}
+
+
+
+#pragma mark - Statistics
+
+- (NSUInteger)hitCount
+{
+    NSUInteger hitCount = 0;
+    for (APPSPoolRegistration *registration in _registrations.objectEnumerator)
+        hitCount += registration.hits;
+    return hitCount;
+}
+
+
+- (NSUInteger)missCount
+{
+    NSUInteger missCount = 0;
+    for (APPSPoolRegistration *registration in _registrations.objectEnumerator)
+        missCount += registration.misses;
+    return missCount;
+}
+
+
+- (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)statistics
+{
+    NSMutableDictionary *statistics = [NSMutableDictionary dictionary];
+    [_registrations enumerateKeysAndObjectsUsingBlock:^(NSString *key, APPSPoolRegistration *registration, BOOL *stop) {
+        statistics[key] = @{ @"hits" : @(registration.hits),
+                             @"misses" : @(registration.misses),
+                             @"ready" : @(registration.instances.count) };
+    }];
+    return statistics;
+}
+
+
+
+#pragma mark - Helper
+
+- (void)registerKey:(NSString *)key nibName:(NSString *)nibName bundle:(NSBundle *)bundle loadsView:(BOOL)loadsView makeInstance:(UIViewController *(^)(void))makeInstance
+{
+    NSAssert([NSThread isMainThread], @"APPSInstantiationPool must be used from the main thread");
+
+    APPSPoolRegistration *registration = _registrations[key];
+    if (!registration) {
+        registration = [[APPSPoolRegistration alloc] init];
+        registration.instances = [NSMutableArray array];
+        _registrations[key] = registration;
+        [_registrationKeys addObject:key];
+    }
+    registration.makeInstance = makeInstance;
+    registration.nibName = nibName;
+    registration.nibBundle = bundle;
+    registration.loadsView = loadsView;
+
+    [self scheduleRefill];
+}
+
+
+- (UIViewController *)dequeueInstanceForKey:(NSString *)key
+{
+    NSAssert([NSThread isMainThread], @"APPSInstantiationPool must be used from the main thread");
+
+    APPSPoolRegistration *registration = _registrations[key];
+    if (!registration)
+        return nil;
+
+    UIViewController *instance = registration.instances.firstObject;
+    if (instance) {
+        [registration.instances removeObjectAtIndex:0];
+        registration.hits++;
+    }
+    else {
+        registration.misses++;
+    }
+
+    [self scheduleRefill];
+    return instance;
+}
+
+
+/// Make instances one at a time, each in its own idle pass of the run loop, so that none holds up a frame for long.
+- (void)scheduleRefill
+{
+    if (_refillScheduled)
+        return;
+
+    _refillScheduled = YES;
+    [self performSelector:@selector(refillOneInstance) withObject:nil afterDelay:0 inModes:@[NSDefaultRunLoopMode]];
+}
+
+
+- (void)refillOneInstance
+{
+    _refillScheduled = NO;
+
+    for (NSString *key in _registrationKeys) {
+        APPSPoolRegistration *registration = _registrations[key];
+        if (registration.instances.count >= _maximumInstancesPerRegistration)
+            continue;
+
+        // Don't read the nib here on the main thread; its background read schedules another pass when it's done.
+        if (registration.nibName && !_nibs[[self keyForNibName:registration.nibName bundle:registration.nibBundle]]) {
+            [self prepareNibWithNibName:registration.nibName bundle:registration.nibBundle];
+            continue;
+        }
+
+        UIViewController *instance = registration.makeInstance();
+        if (!instance)
+            continue;
+
+        if (registration.loadsView)
+            [instance loadViewIfNeeded];
+        [registration.instances addObject:instance];
+
+        [self scheduleRefill];
+        return;
+    }
+}
+
+
+- (void)didReceiveMemoryWarning:(NSNotification *)notification
+{
+    for (APPSPoolRegistration *registration in _registrations.objectEnumerator)
+        [registration.instances removeAllObjects];
+    [_nibs removeAllObjects];
+}
+
+
+- (NSString *)keyForIdentifier:(NSString *)identifier storyboardName:(NSString *)storyboardName bundle:(NSBundle *)bundle
+{
+    return [NSString stringWithFormat:@"%@: %@", identifier, [self keyForNibName:storyboardName bundle:bundle]];
+}
+
+
+- (NSString *)keyForClass:(Class)viewControllerClass nibName:(NSString *)nibName bundle:(NSBundle *)bundle
+{
+    return [NSString stringWithFormat:@"%@: %@", NSStringFromClass(viewControllerClass), [self keyForNibName:nibName bundle:bundle]];
+}
+
+
+- (NSString *)keyForNibName:(NSString *)nibName bundle:(NSBundle *)bundle
+{
+    return [NSString stringWithFormat:@"%@|%@", nibName, (bundle ?: [NSBundle mainBundle]).bundlePath];
+}
+
+@end
@@ -0,0 +1,23 @@
+//
+//  APPSPrewarming.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Adopted by view controllers that can start loading their content ahead of being shown, such as when a container
+ controller prepares them for an upcoming transition.
+ */
+@protocol APPSPrewarming <NSObject>
+
+@required
+/**
+ Begin loading whatever content we'll show, typically by sending -setNeedsLoadContent to our data source.
+ Our view has already been loaded and laid out by the time this is called.
+ */
+- (void)prewarmContent;
+
+@end
@@ -0,0 +1,117 @@
+//
+//  APPSTransitionMetrics.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import UIKit;
+
+#import "APPSContainerViewController.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The phases of a container transition, in the order they happen.
+typedef NS_ENUM(NSUInteger, APPSTransitionPhase) {
+    /// Loading the incoming view controller's view, if it wasn't already.
+    APPSTransitionPhaseViewLoad = 0,
+    /// Sizing, positioning and laying out the incoming view.
+    APPSTransitionPhaseLayout,
+    /// The child and info stack bookkeeping, up to the animation having started.
+    APPSTransitionPhaseAnimationStart,
+    /// From the animation having started to the first frame being displayed.
+    APPSTransitionPhaseFirstFrame,
+    /// From the first frame to the transition's completion.
+    APPSTransitionPhaseCompletion,
+    
+    APPSTransitionPhaseCount
+};
+
+
+/**
+ The timing of one transition or placement in an APPSContainerViewController: how long each phase took, and how
+ many frames were dropped while it animated.
+ */
+@interface APPSTransitionTiming : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The class of the view controller transitioned from, or nil when there wasn't one.
+@property (nonatomic, readonly, nullable) NSString *fromClassName;
+
+/// The class of the view controller transitioned to.
+@property (nonatomic, readonly) NSString *toClassName;
+
+/// The type of the transition. Placements have APPSContainerControllerTransitionType_None.
+@property (nonatomic, readonly) APPSContainerControllerTransitionType transitionType;
+
+/// The kind of transition or placement, such as "Push" or "PlaceBelow".
+@property (nonatomic, readonly) NSString *transitionName;
+
+/// The route this timing is aggregated under: the from and to classes and the transition name.
+@property (nonatomic, readonly) NSString *route;
+
+/// Whether the transition was reversed interactively, back to where it started.
+@property (nonatomic, readonly, getter = isReversed) BOOL reversed;
+
+/// The number of frames that were missed while the transition animated.
+@property (nonatomic, readonly) NSUInteger droppedFrameCount;
+
+/// The time, in seconds, spent in phase.
+- (NSTimeInterval)durationOfPhase:(APPSTransitionPhase)phase;
+
+/// The time, in seconds, from the start of the transition to its completion.
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+@end
+
+
+
+/// Receives the timing of every transition of the container controllers it's given to. Called on the main thread.
+@protocol APPSTransitionMetricsSink <NSObject>
+
+- (void)recordTransitionTiming:(APPSTransitionTiming *)timing;
+
+@end
+
+
+
+/**
+ A sink that aggregates transition timings by route, keeping the most recent samples of each so that percentiles can
+ be asked for or exported. Should be used from the main thread only.
+ */
+@interface APPSTransitionMetrics : NSObject <APPSTransitionMetricsSink>
+
+/// The number of recent samples kept per route. Defaults to 256.
+@property (nonatomic) NSUInteger maximumSamplesPerRoute;
+
+/// Another sink, such as one that logs or uploads, that is given every timing after we've aggregated it.
+@property (nonatomic, strong, nullable) id<APPSTransitionMetricsSink> forwardingSink;
+
+/// The routes we've recorded timings for.
+@property (nonatomic, readonly) NSArray<NSString *> *routes;
+
+/// The number of samples kept for route.
+- (NSUInteger)numberOfSamplesForRoute:(NSString *)route;
+
+/// The given percentile, from 0 to 100, of the time spent in phase on route. Returns 0 for a route without samples.
+- (NSTimeInterval)percentile:(double)percentile ofPhase:(APPSTransitionPhase)phase forRoute:(NSString *)route;
+
+/// The given percentile, from 0 to 100, of the total duration of the transitions on route.
+- (NSTimeInterval)percentile:(double)percentile ofTotalDurationForRoute:(NSString *)route;
+
+/// The given percentile, from 0 to 100, of the number of frames dropped by the transitions on route.
+- (double)percentile:(double)percentile ofDroppedFramesForRoute:(NSString *)route;
+
+/**
+ A property list of every route's sample count, and its 50th, 90th and 99th percentiles for each phase, the total
+ duration and dropped frames. Suitable for NSJSONSerialization.
+ */
+- (NSDictionary<NSString *, NSDictionary *> *)exportedSummary;
+
+/// Discard every sample.
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
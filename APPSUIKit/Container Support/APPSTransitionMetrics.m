@@ -0,0 +1,302 @@
+//
+//  APPSTransitionMetrics.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSTransitionMetrics_Private.h"
+
+static NSString * const APPSTransitionPhaseNames[APPSTransitionPhaseCount] = {
+    @"viewLoad", @"layout", @"animationStart", @"firstFrame", @"completion"
+};
+
+
+@implementation APPSTransitionTiming {
+    NSTimeInterval _phaseDurations[APPSTransitionPhaseCount];
+    CFTimeInterval _startTime;
+    CFTimeInterval _lastMarkTime;
+    CFTimeInterval _lastFrameTimestamp;
+    CADisplayLink *_displayLink;
+    /// Set while waiting to finish on the first frame.
+    id<APPSTransitionMetricsSink> _pendingSink;
+    BOOL _waitingToFinish;
+    BOOL _finished;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithFromViewController:(UIViewController *)fromViewController
+                          toViewController:(UIViewController *)toViewController
+                            transitionType:(APPSContainerControllerTransitionType)transitionType
+                            transitionName:(NSString *)transitionName
+{
+    NSParameterAssert(toViewController != nil);
+    NSParameterAssert(transitionName != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _fromClassName = fromViewController ? NSStringFromClass([fromViewController class]) : nil;
+    _toClassName = NSStringFromClass([toViewController class]);
+    _transitionType = transitionType;
+    _transitionName = [transitionName copy];
+    _startTime = _lastMarkTime = CACurrentMediaTime();
+    return self;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSString *)route
+{
+    return [NSString stringWithFormat:@"%@ -> %@ (%@)", _fromClassName ?: @"-", _toClassName, _transitionName];
+}
+
+
+- (NSTimeInterval)durationOfPhase:(APPSTransitionPhase)phase
+{
+    NSParameterAssert(phase < APPSTransitionPhaseCount);
+    return _phaseDurations[phase];
+}
+
+
+- (NSTimeInterval)totalDuration
+{
+    NSTimeInterval total = 0;
+    for (NSUInteger phase = 0; phase < APPSTransitionPhaseCount; ++phase)
+        total += _phaseDurations[phase];
+    return total;
+}
+
+
+
+#pragma mark - Private Interface
+
+- (void)markPhase:(APPSTransitionPhase)phase
+{
+    NSParameterAssert(phase < APPSTransitionPhaseCount);
+
+    CFTimeInterval now = CACurrentMediaTime();
+    _phaseDurations[phase] += now - _lastMarkTime;
+    _lastMarkTime = now;
+}
+
+
+- (void)beginTrackingFrames
+{
+    if (_displayLink || _finished)
+        return;
+
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkDidFire:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+
+- (void)finishReversed:(BOOL)reversed recordingToSink:(id<APPSTransitionMetricsSink>)sink
+{
+    if (_finished)
+        return;
+
+    _finished = YES;
+    _reversed = reversed;
+    [self markPhase:APPSTransitionPhaseCompletion];
+
+    [_displayLink invalidate];
+    _displayLink = nil;
+
+    [sink recordTransitionTiming:self];
+}
+
+
+- (void)finishAfterFirstFrameRecordingToSink:(id<APPSTransitionMetricsSink>)sink
+{
+    _pendingSink = sink;
+    _waitingToFinish = YES;
+    [self beginTrackingFrames];
+}
+
+
+
+#pragma mark - Frames
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    // The first callback comes once the frame with the transition's start in it is on screen.
+    if (_lastFrameTimestamp == 0) {
+        [self markPhase:APPSTransitionPhaseFirstFrame];
+        _lastFrameTimestamp = displayLink.timestamp;
+
+        if (_waitingToFinish) {
+            id<APPSTransitionMetricsSink> sink = _pendingSink;
+            _pendingSink = nil;
+            [self finishReversed:NO recordingToSink:sink];
+        }
+        return;
+    }
+
+    // Every whole frame interval beyond the first between two callbacks is a frame that was missed.
+    NSTimeInterval frameDuration = displayLink.duration;
+    if (frameDuration > 0) {
+        NSTimeInterval elapsed = displayLink.timestamp - _lastFrameTimestamp;
+        NSInteger intervals = (NSInteger)round(elapsed / frameDuration);
+        if (intervals > 1)
+            _droppedFrameCount += (NSUInteger)(intervals - 1);
+    }
+    _lastFrameTimestamp = displayLink.timestamp;
+}
+
+@end
+
+
+
+@implementation APPSTransitionMetrics {
+    /// Route → the most recent timings recorded for it, oldest first.
+    NSMutableDictionary<NSString *, NSMutableArray<APPSTransitionTiming *> *> *_samplesByRoute;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)init
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _maximumSamplesPerRoute = 256;
+    _samplesByRoute = [NSMutableDictionary dictionary];
+    return self;
+}
+
+
+
+#pragma mark - APPSTransitionMetricsSink
+
+- (void)recordTransitionTiming:(APPSTransitionTiming *)timing
+{
+    NSMutableArray *samples = _samplesByRoute[timing.route];
+    if (!samples) {
+        samples = [NSMutableArray array];
+        _samplesByRoute[timing.route] = samples;
+    }
+
+    [samples addObject:timing];
+    if (samples.count > MAX(_maximumSamplesPerRoute, (NSUInteger)1))
+        [samples removeObjectsInRange:NSMakeRange(0, samples.count - MAX(_maximumSamplesPerRoute, (NSUInteger)1))];
+
+    [self.forwardingSink recordTransitionTiming:timing];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSArray<NSString *> *)routes
+{
+    return [_samplesByRoute.allKeys sortedArrayUsingSelector:@selector(compare:)];
+}
+
+
+- (NSUInteger)numberOfSamplesForRoute:(NSString *)route
+{
+    return _samplesByRoute[route].count;
+}
+
+
+- (NSTimeInterval)percentile:(double)percentile ofPhase:(APPSTransitionPhase)phase forRoute:(NSString *)route
+{
+    return [self percentile:percentile ofRoute:route value:^double(APPSTransitionTiming *timing) {
+        return [timing durationOfPhase:phase];
+    }];
+}
+
+
+- (NSTimeInterval)percentile:(double)percentile ofTotalDurationForRoute:(NSString *)route
+{
+    return [self percentile:percentile ofRoute:route value:^double(APPSTransitionTiming *timing) {
+        return timing.totalDuration;
+    }];
+}
+
+
+- (double)percentile:(double)percentile ofDroppedFramesForRoute:(NSString *)route
+{
+    return [self percentile:percentile ofRoute:route value:^double(APPSTransitionTiming *timing) {
+        return timing.droppedFrameCount;
+    }];
+}
+
+
+- (NSDictionary<NSString *, NSDictionary *> *)exportedSummary
+{
+    NSMutableDictionary *summary = [NSMutableDictionary dictionary];
+
+    for (NSString *route in _samplesByRoute) {
+        NSMutableDictionary *routeSummary = [NSMutableDictionary dictionary];
+        routeSummary[@"count"] = @([self numberOfSamplesForRoute:route]);
+
+        for (NSUInteger phase = 0; phase < APPSTransitionPhaseCount; ++phase) {
+            routeSummary[APPSTransitionPhaseNames[phase]] = [self percentilesOfRoute:route value:^double(APPSTransitionTiming *timing) {
+                return [timing durationOfPhase:phase];
+            }];
+        }
+        routeSummary[@"total"] = [self percentilesOfRoute:route value:^double(APPSTransitionTiming *timing) {
+            return timing.totalDuration;
+        }];
+        routeSummary[@"droppedFrames"] = [self percentilesOfRoute:route value:^double(APPSTransitionTiming *timing) {
+            return timing.droppedFrameCount;
+        }];
+
+        summary[route] = routeSummary;
+    }
+
+    return summary;
+}
+
+
+- (void)reset
+{
+    [_samplesByRoute removeAllObjects];
+}
+
+
+
+#pragma mark - Helper
+
+- (NSDictionary *)percentilesOfRoute:(NSString *)route value:(double (^)(APPSTransitionTiming *timing))value
+{
+    return @{ @"p50" : @([self percentile:50 ofRoute:route value:value]),
+              @"p90" : @([self percentile:90 ofRoute:route value:value]),
+              @"p99" : @([self percentile:99 ofRoute:route value:value]) };
+}
+
+
+/// Nearest-rank percentile of the values of the samples kept for route.
+- (double)percentile:(double)percentile ofRoute:(NSString *)route value:(double (^)(APPSTransitionTiming *timing))value
+{
+    NSArray *samples = _samplesByRoute[route];
+    NSUInteger count = samples.count;
+    if (!count)
+        return 0;
+
+    double *values = malloc(count * sizeof(double));
+    [samples enumerateObjectsUsingBlock:^(APPSTransitionTiming *timing, NSUInteger index, BOOL *stop) {
+        values[index] = value(timing);
+    }];
+    qsort_b(values, count, sizeof(double), ^int(const void *a, const void *b) {
+        double lhs = *(const double *)a, rhs = *(const double *)b;
+        return (lhs > rhs) - (lhs < rhs);
+    });
+
+    double rank = ceil(MIN(MAX(percentile, 0.0), 100.0) / 100.0 * count);
+    NSUInteger index = (NSUInteger)MAX(rank, 1.0) - 1;
+    double result = values[index];
+    free(values);
+    return result;
+}
+
+@end
@@ -0,0 +1,34 @@
+//
+//  APPSTransitionMetrics_Private.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSTransitionMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface APPSTransitionTiming ()
+
+/// Start timing a transition now.
+- (instancetype)initWithFromViewController:(nullable UIViewController *)fromViewController
+                          toViewController:(UIViewController *)toViewController
+                            transitionType:(APPSContainerControllerTransitionType)transitionType
+                            transitionName:(NSString *)transitionName NS_DESIGNATED_INITIALIZER;
+
+/// Attribute the time since the previous mark (or the start) to phase.
+- (void)markPhase:(APPSTransitionPhase)phase;
+
+/// Watch the display's frames: the first marks APPSTransitionPhaseFirstFrame, and later ones count dropped frames.
+- (void)beginTrackingFrames;
+
+/// Mark APPSTransitionPhaseCompletion, stop watching frames, and hand ourselves to sink.
+- (void)finishReversed:(BOOL)reversed recordingToSink:(nullable id<APPSTransitionMetricsSink>)sink;
+
+/// For transitions without an animation: wait for the first frame to be displayed, then finish.
+- (void)finishAfterFirstFrameRecordingToSink:(nullable id<APPSTransitionMetricsSink>)sink;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -14,6 +14,11 @@
  to reflect the position of child view controllers hosted by the containment controller that uses us.
  
  Controllers on higher layers are at the end of our array of entries.
+ 
+ Alongside the array, we index our entries by controller and by tagged name, and keep track of the closest modally
+ covered entry, so that the containment controller's bookkeeping queries don't have to scan the array.
+ A controller's tagged name is indexed when its entry is added, and re-indexed whenever it's set afterwards,
+ which we observe through key-value observing.
  */
 @interface APPSViewControllerInfoStack : NSObject
 
@@ -37,8 +42,23 @@
 
 - (BOOL)hasEntryForController:(UIViewController *)controller;
 
+/**
+ The entries whose controllers have the tagged name specified, in the order they were added.
+ */
+- (NSArray *)entriesWithTaggedName:(NSString *)taggedName;
+
+/**
+ The earliest added entry whose controller has the tagged name specified, otherwise nil.
+ */
+- (APPSViewControllerInfoStackEntry *)firstEntryWithTaggedName:(NSString *)taggedName;
+
 - (APPSViewControllerInfoStackEntry *)lastEntry;
 
+/**
+ All of our entries, lowest layer first.
+ */
+- (NSArray *)allEntries;
+
 /**
  Determines which of our entries, working backwards, is the first to claim to have been covered up modally.
  This is the entry whose associated child controller, will be the one our owning Container Controller will
@@ -50,6 +70,11 @@
 
 - (void)logContentsWithNote:(NSString *)note;
 
+/**
+ Called by an entry of ours whenever its modallyCovered flag changes.
+ */
+- (void)entryDidChangeModallyCovered:(APPSViewControllerInfoStackEntry *)entry;
+
 
 
 #pragma mark - Adding and Removing
@@ -60,6 +85,12 @@
 
 - (void)removeEntryForController:(UIViewController *)controller;
 
+/**
+ Removes the entries for all of the given controllers in a single pass over the stack,
+ rather than one search and shuffle per controller.
+ */
+- (void)removeEntriesForControllers:(NSArray *)controllers;
+
 
 
 #pragma mark - Rearranging Entries
@@ -12,9 +12,17 @@
 #import "APPSViewControllerInfoStackEntry.h"
 #import "APPSTaggedNaming.h"
 
+static void * const APPSInfoStackTaggedNameContext = (void *)&APPSInfoStackTaggedNameContext;
+
 @interface APPSViewControllerInfoStack ()
 // strong
 @property (strong, nonatomic) NSMutableArray *entries;
+@property (strong, nonatomic) NSMapTable *entriesByController; // Controller (weak, by identity) -> entry
+@property (strong, nonatomic) NSMutableDictionary *entriesByTaggedName; // Tagged name -> mutable array of entries, in the order added
+@property (strong, nonatomic) APPSViewControllerInfoStackEntry *closestModallyCoveredEntry;
+
+// scalar
+@property (assign, nonatomic) BOOL closestModallyCoveredEntryNeedsUpdate;
 @end
 
 
@@ -29,12 +37,24 @@
         APPSAssert(containmentController, @"We require a containment controller.");
         self.containmentController = containmentController;
         self.entries = [NSMutableArray array];
+        self.entriesByController = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                             valueOptions:NSPointerFunctionsStrongMemory
+                                                                 capacity:0];
+        self.entriesByTaggedName = [NSMutableDictionary dictionary];
     }
     
     return self;
 }
 
 
+- (void)dealloc
+{
+    for (APPSViewControllerInfoStackEntry *entry in self.entries) {
+        [self stopObservingTaggedNameOfEntry:entry];
+    }
+}
+
+
 
 #pragma mark - Property Overrides
 
@@ -79,13 +99,11 @@
 
 - (APPSViewControllerInfoStackEntry *)entryForController:(UIViewController *)controller
 {
-    for (APPSViewControllerInfoStackEntry *iteratedEntry in self.entries) {
-        if (iteratedEntry.controller == controller) {
-            return iteratedEntry; // We found it
-        }
+    if (!controller) {
+        return nil;
     }
 
-    return nil; // We must not have found it.
+    return [self.entriesByController objectForKey:controller];
 }
 
 
@@ -97,14 +115,54 @@
 }
 
 
+- (NSArray *)entriesWithTaggedName:(NSString *)taggedName
+{
+    NSMutableArray *matchingEntries = [NSMutableArray array];
+
+    for (APPSViewControllerInfoStackEntry *iteratedEntry in self.entriesByTaggedName[taggedName]) {
+        // Does the controller still go by the name we indexed it under?
+        if ([[self indexableTaggedNameForController:iteratedEntry.controller] isEqual:taggedName]) {
+            [matchingEntries addObject:iteratedEntry];
+        }
+    }
+
+    return matchingEntries;
+}
+
+
+- (APPSViewControllerInfoStackEntry *)firstEntryWithTaggedName:(NSString *)taggedName
+{
+    for (APPSViewControllerInfoStackEntry *iteratedEntry in self.entriesByTaggedName[taggedName]) {
+        // Does the controller still go by the name we indexed it under?
+        if ([[self indexableTaggedNameForController:iteratedEntry.controller] isEqual:taggedName]) {
+            return iteratedEntry;
+        }
+    }
+
+    return nil; // None found
+}
+
+
 - (APPSViewControllerInfoStackEntry *)lastEntry
 {
     return [self.entries lastObject];
 }
 
 
+- (NSArray *)allEntries
+{
+    return [self.entries copy];
+}
+
+
 - (APPSViewControllerInfoStackEntry *)closestModalDismissalReturnEntry
 {
+    // Has nothing happened since we last worked this out, that could have changed the answer?
+    if (!self.closestModallyCoveredEntryNeedsUpdate) {
+        // YES: Our maintained answer stands.
+        return self.closestModallyCoveredEntry;
+    }
+
     APPSViewControllerInfoStackEntry *closestEntry = nil;
 
     for (APPSViewControllerInfoStackEntry *iteratedEntry in [self.entries reverseObjectEnumerator]) {
@@ -115,6 +173,9 @@
         }
     }
 
+    self.closestModallyCoveredEntry = closestEntry;
+    self.closestModallyCoveredEntryNeedsUpdate = NO;
+
     return closestEntry;
 }
 
@@ -146,6 +207,21 @@
 }
 
 
+- (void)entryDidChangeModallyCovered:(APPSViewControllerInfoStackEntry *)entry
+{
+    // Is this the top entry being covered? That's what a modal presentation does, and it's simple to account for:
+    if ([entry wasModallyCovered] && entry == [self lastEntry]) {
+        // YES: Nothing above it could have been covered, so it is now the closest.
+        self.closestModallyCoveredEntry = entry;
+        self.closestModallyCoveredEntryNeedsUpdate = NO;
+        return;
+    }
+
+    // Otherwise, we'll work it out again the next time we're asked:
+    [self setClosestModallyCoveredEntryNeedsUpdate];
+}
+
+
 
 #pragma mark - Adding and Removing
 
@@ -158,7 +234,11 @@
     entry.appearingTransitionType = transitionType;
     entry.appearingTransitionDirection = transitionDirection;
 
+    // We don't expect more than one entry per controller; replace any prior one so our indices stay consistent:
+    [self removeEntryForController:controller];
+
     [self.entries addObject:entry];
+    [self indexEntry:entry];
 
     return entry;
 }
@@ -169,7 +249,30 @@
     APPSViewControllerInfoStackEntry *soughtEntry = [self entryForController:controller];
 
     if (soughtEntry) {
-        [self.entries removeObject:soughtEntry];
+        [self.entries removeObjectIdenticalTo:soughtEntry];
+        [self unindexEntry:soughtEntry];
+    }
+}
+
+
+- (void)removeEntriesForControllers:(NSArray *)controllers
+{
+    NSHashTable *doomedEntries = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+
+    for (UIViewController *controller in controllers) {
+        APPSViewControllerInfoStackEntry *soughtEntry = [self entryForController:controller];
+
+        if (soughtEntry) {
+            [doomedEntries addObject:soughtEntry];
+            [self unindexEntry:soughtEntry];
+        }
+    }
+
+    // Did we find anything to remove? If so, sweep it all out of the stack at once:
+    if (doomedEntries.count > 0) {
+        [self.entries removeObjectsAtIndexes:[self.entries indexesOfObjectsPassingTest:^BOOL(id entry, NSUInteger index, BOOL *stop) {
+            return [doomedEntries containsObject:entry];
+        }]];
     }
 }
 
@@ -186,8 +289,9 @@
     
     // Remove the lowerEntry before inserting it at its new position, because NSArray inserts
     // don't check for uniqueness, and would otherwise, gladly insert what would be a duplicate:
-    [self.entries removeObject:lowerEntry];
-    [self.entries insertObject:lowerEntry atIndex:[self.entries indexOfObject:higherEntry]];
+    [self.entries removeObjectIdenticalTo:lowerEntry];
+    [self.entries insertObject:lowerEntry atIndex:[self.entries indexOfObjectIdenticalTo:higherEntry]];
+    [self setClosestModallyCoveredEntryNeedsUpdate];
 }
 
 
@@ -210,8 +314,9 @@
     
     // Remove the lowerEntry before inserting it at its new position, because NSArray inserts
     // don't check for uniqueness, and would otherwise, gladly insert what would be a duplicate:
-    [self.entries removeObject:lowerEntry];
-    [self.entries insertObject:lowerEntry atIndex:[self.entries indexOfObject:higherEntry]];
+    [self.entries removeObjectIdenticalTo:lowerEntry];
+    [self.entries insertObject:lowerEntry atIndex:[self.entries indexOfObjectIdenticalTo:higherEntry]];
+    [self setClosestModallyCoveredEntryNeedsUpdate];
 }
 
 
@@ -231,7 +336,12 @@
 {
     APPSViewControllerInfoStackEntry *existingEntry = [self entryForController:existingViewController];
     APPSViewControllerInfoStackEntry *replacementEntry = [self entryForController:replacementViewController];
-    [self.entries apps_replaceObject:existingEntry withObject:replacementEntry];
+
+    // Move the replacement entry into the existing entry's position, rather than leave it in two places:
+    [self.entries removeObjectIdenticalTo:replacementEntry];
+    [self.entries replaceObjectAtIndex:[self.entries indexOfObjectIdenticalTo:existingEntry] withObject:replacementEntry];
+    [self unindexEntry:existingEntry];
+    [self setClosestModallyCoveredEntryNeedsUpdate];
 }
 
 
@@ -246,4 +356,108 @@
 }
 
 
+
+#pragma mark - Indexing
+
+- (void)indexEntry:(APPSViewControllerInfoStackEntry *)entry
+{
+    entry.infoStack = self;
+    [self.entriesByController setObject:entry forKey:entry.controller];
+    [self fileEntryUnderTaggedName:entry];
+
+    // Controllers can be renamed while on the stack, so we follow their tagged names to keep our index current:
+    if ([entry.controller conformsToProtocol:@protocol(APPSTaggedNaming)]) {
+        [entry.controller addObserver:self forKeyPath:@"taggedName" options:0 context:APPSInfoStackTaggedNameContext];
+    }
+}
+
+
+- (void)unindexEntry:(APPSViewControllerInfoStackEntry *)entry
+{
+    [self stopObservingTaggedNameOfEntry:entry];
+
+    entry.infoStack = nil;
+    [self.entriesByController removeObjectForKey:entry.controller];
+    [self unfileEntryFromTaggedName:entry];
+
+    // Was this the entry a modal dismissal would return to?
+    if (entry == self.closestModallyCoveredEntry) {
+        [self setClosestModallyCoveredEntryNeedsUpdate];
+    }
+}
+
+
+- (void)stopObservingTaggedNameOfEntry:(APPSViewControllerInfoStackEntry *)entry
+{
+    if ([entry.controller conformsToProtocol:@protocol(APPSTaggedNaming)]) {
+        [entry.controller removeObserver:self forKeyPath:@"taggedName" context:APPSInfoStackTaggedNameContext];
+    }
+}
+
+
+- (void)fileEntryUnderTaggedName:(APPSViewControllerInfoStackEntry *)entry
+{
+    NSString *taggedName = [self indexableTaggedNameForController:entry.controller];
+    entry.indexedTaggedName = taggedName;
+
+    if (taggedName) {
+        NSMutableArray *namedEntries = self.entriesByTaggedName[taggedName];
+        if (!namedEntries) {
+            namedEntries = [NSMutableArray array];
+            self.entriesByTaggedName[taggedName] = namedEntries;
+        }
+        [namedEntries addObject:entry];
+    }
+}
+
+
+- (void)unfileEntryFromTaggedName:(APPSViewControllerInfoStackEntry *)entry
+{
+    // Look for the entry under the name we filed it under, in case the controller has been renamed since:
+    NSString *taggedName = entry.indexedTaggedName;
+    if (taggedName) {
+        NSMutableArray *namedEntries = self.entriesByTaggedName[taggedName];
+        [namedEntries removeObjectIdenticalTo:entry];
+
+        if (namedEntries.count == 0) {
+            [self.entriesByTaggedName removeObjectForKey:taggedName];
+        }
+        entry.indexedTaggedName = nil;
+    }
+}
+
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if (context != APPSInfoStackTaggedNameContext) {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        return;
+    }
+
+    // A controller on our stack was renamed, so file its entry under the new name:
+    APPSViewControllerInfoStackEntry *entry = [self entryForController:object];
+    if (entry) {
+        [self unfileEntryFromTaggedName:entry];
+        [self fileEntryUnderTaggedName:entry];
+    }
+}
+
+
+- (NSString *)indexableTaggedNameForController:(UIViewController *)controller
+{
+    if ([controller conformsToProtocol:@protocol(APPSTaggedNaming)]) {
+        return ((id <APPSTaggedNaming>)controller).taggedName;
+    }
+
+    return nil;
+}
+
+
+- (void)setClosestModallyCoveredEntryNeedsUpdate
+{
+    self.closestModallyCoveredEntry = nil;
+    self.closestModallyCoveredEntryNeedsUpdate = YES;
+}
+
+
 @end
@@ -8,6 +8,8 @@
 
 #import "APPSContainerViewController.h"
 
+@class APPSViewControllerInfoStack;
+
 @interface APPSViewControllerInfoStackEntry : NSObject
 
 #pragma mark scalar
@@ -20,10 +22,17 @@
 #pragma mark weak
 
 @property (weak, nonatomic) NSString *taggedName;
+@property (weak, nonatomic) APPSViewControllerInfoStack *infoStack; // The stack we belong to, told when we're modally covered.
+
+
+#pragma mark copy
+
+@property (copy, nonatomic) NSString *indexedTaggedName; // The tagged name our stack filed us under, if any.
 
 
 #pragma mark strong
 
 @property (strong, nonatomic) UIViewController *controller; // The container retains controllers added to it.
+@property (strong, nonatomic) UIView *evictedViewSnapshot; // Stands in for the controller's view after the container unloads it under memory pressure.
 
 @end
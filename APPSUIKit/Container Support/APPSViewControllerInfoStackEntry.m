@@ -7,6 +7,7 @@
 //
 
 #import "APPSViewControllerInfoStackEntry.h"
+#import "APPSViewControllerInfoStack.h"
 #import "APPSTaggedNaming.h"
 
 @implementation APPSViewControllerInfoStackEntry
@@ -25,4 +26,13 @@
     return taggedName;
 }
 
+
+- (void)setModallyCovered:(BOOL)modallyCovered
+{
+    _modallyCovered = modallyCovered;
+
+    // Let our stack keep its notion of the closest modally covered entry current:
+    [self.infoStack entryDidChangeModallyCovered:self];
+}
+
 @end
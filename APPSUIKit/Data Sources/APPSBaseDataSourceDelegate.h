@@ -7,6 +7,8 @@
 
 #import <UIKit/UIKit.h>
 
+@class APPSRowHeightCache;
+
 
 /**
  This class provides a base implementation of APPSDataSourceDelegate that
@@ -103,6 +105,63 @@
 @property (nonatomic, assign) UITableViewRowAnimation updateItemAnimation;
 
 
+
+#pragma mark - Scrolling
+
+/**
+ *  Set this to YES to keep the table view pinned to its last row as rows are added, as in a chat or log. The table
+ *  only follows when it was already scrolled to the bottom before the update, so a user reading older rows stays put.
+ *  @note Defaults to NO.
+ */
+@property (nonatomic, assign) BOOL keepsScrolledToBottom;
+
+
+
+#pragma mark - Row Heights
+
+/**
+ *  Optional. When set, measured row heights are cached by item and table width. Entries are invalidated
+ *  when the data source refreshes the corresponding items or sections. A reload keeps the heights of
+ *  APPSIdentifiable items whose content hash hasn't changed.
+ *  @note Defaults to nil, leaving row layout entirely to the table view's self-sizing.
+ */
+@property (nonatomic, strong) APPSRowHeightCache *rowHeightCache;
+
+
+/**
+ *  Call from -tableView:estimatedHeightForRowAtIndexPath:.
+ *
+ *  @return The cached height of the item at indexPath, or the table view's estimated row height when none is cached.
+ */
+- (CGFloat)estimatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath;
+
+
+/**
+ *  Call from -tableView:heightForRowAtIndexPath:.
+ *
+ *  @return The cached height of the item at indexPath, or UITableViewAutomaticDimension so the cell is measured.
+ */
+- (CGFloat)heightForRowAtIndexPath:(NSIndexPath *)indexPath;
+
+
+/**
+ *  Call from -tableView:willDisplayCell:forRowAtIndexPath: to record the measured height of the cell.
+ */
+- (void)recordHeightOfCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath;
+
+
+/**
+ *  Measures upcoming rows on a background queue with TextKit, using the text and text layout spec their
+ *  data sources declare, and stores the results in rowHeightCache. Text is measured at the width a cell's
+ *  content view gets in this table view, less whatever the spec's accessory takes. Rows that are already
+ *  cached, or whose data source declares no text layout, are skipped. Results are discarded if the rows are invalidated
+ *  before the measurement finishes.
+ *
+ *  @param indexPaths Global index paths of the rows that are about to be displayed.
+ */
+- (void)precomputeRowHeightsForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths;
+
+
 @end
 
 
@@ -8,6 +8,8 @@
 #import "APPSBaseDataSourceDelegate.h"
 #import "APPSDataSourceDebug.h"
 #import "APPSDataSource_Private.h"
+#import "APPSRowHeightCache.h"
+#import "APPSTextLayoutSpec.h"
 
 #define UPDATE_DEBUGGING 0
 
@@ -26,12 +28,27 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 @property (nonatomic, strong) NSMutableIndexSet *reloadedSections;
 @property (nonatomic, strong) NSMutableIndexSet *deletedSections;
 @property (nonatomic, strong) NSMutableIndexSet *insertedSections;
+/// Rows whose visible cells are reconfigured in place once the batch update ends, in the coordinates after it.
+@property (nonatomic, strong) NSMutableArray<NSIndexPath *> *reconfiguredIndexPaths;
 @property (nonatomic, copy) dispatch_block_t updateCompletionHandler;
 @property (nonatomic) BOOL performingUpdates;
 @property (nonatomic, weak) APPSTablePlaceholderView *placeholderView;
+/// The prefetch data source we gave the table view, as opposed to one set by someone else.
+@property (nonatomic, weak) APPSDataSource *installedPrefetchDataSource;
+/// The placeholder changes reported, applied together at the end of the run loop turn: the data source, every section it reported, and whether the latest change was a dismissal.
+@property (nonatomic, strong) APPSDataSource *pendingPlaceholderDataSource;
+@property (nonatomic, strong) NSMutableIndexSet *pendingPlaceholderSections;
+@property (nonatomic) BOOL pendingPlaceholderDismissal;
+/// Serial queue for measuring row heights off the main thread.
+@property (nonatomic, strong) dispatch_queue_t textLayoutQueue;
+/// Incremented whenever cached row heights are invalidated, so in-flight measurements can be discarded.
+@property (nonatomic) NSUInteger rowHeightGeneration;
 @end
 
-@implementation APPSBaseDataSourceDelegate
+@implementation APPSBaseDataSourceDelegate {
+    /// Applies the pending placeholder change before the main run loop next waits.
+    CFRunLoopObserverRef _placeholderUpdateObserver;
+}
 
 
 #pragma mark - Instantiation
@@ -56,6 +73,9 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 
         self.animateTableChanges = YES;
         [self setAllAnimations:UITableViewRowAnimationFade];
+        
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _textLayoutQueue = dispatch_queue_create("com.appstronomy.APPSUIKit.textLayout", attributes);
     }
     return self;
 }
@@ -64,6 +84,7 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 - (void)dealloc
 {
     [self.tableView removeObserver:self forKeyPath:@"dataSource" context:APPSDataSourceContext];
+    [self removePlaceholderUpdateObserver];
 }
 
 
@@ -77,12 +98,20 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     
     UITableView *tableView = object;
     id<UITableViewDataSource> dataSource = tableView.dataSource;
+    APPSDataSource *appsDataSource = nil;
     
     if ([dataSource isKindOfClass:[APPSDataSource class]]) {
-        APPSDataSource *appsDataSource = (APPSDataSource *)dataSource;
+        appsDataSource = (APPSDataSource *)dataSource;
         if (!appsDataSource.delegate)
             appsDataSource.delegate = self;
     }
+    
+    // Route prefetching through the data source tree, following it as it changes. A prefetch data source someone else set is theirs to manage.
+    id<UITableViewDataSourcePrefetching> prefetchDataSource = tableView.prefetchDataSource;
+    if (!prefetchDataSource || prefetchDataSource == self.installedPrefetchDataSource) {
+        tableView.prefetchDataSource = appsDataSource;
+        self.installedPrefetchDataSource = appsDataSource;
+    }
 }
 
 
@@ -112,6 +141,201 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 
 
 
+#pragma mark - Row Heights
+
+- (CGFloat)estimatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    CGFloat height = [self cachedHeightForRowAtIndexPath:indexPath];
+    if (height >= 0)
+        return height;
+    
+    CGFloat estimatedRowHeight = self.tableView.estimatedRowHeight;
+    return estimatedRowHeight > 0 ? estimatedRowHeight : self.tableView.rowHeight;
+}
+
+
+- (CGFloat)heightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    CGFloat height = [self cachedHeightForRowAtIndexPath:indexPath];
+    return height >= 0 ? height : UITableViewAutomaticDimension;
+}
+
+
+- (void)recordHeightOfCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    APPSRowHeightCache *rowHeightCache = self.rowHeightCache;
+    if (!rowHeightCache)
+        return;
+    
+    id item = [self itemAtIndexPath:indexPath];
+    if (item)
+        [rowHeightCache setHeight:CGRectGetHeight(cell.bounds) forItem:item width:CGRectGetWidth(self.tableView.bounds)];
+}
+
+
+- (void)precomputeRowHeightsForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    NSAssert([NSThread isMainThread], @"You can only call -precomputeRowHeightsForRowsAtIndexPaths: from the main thread.");
+    
+    APPSRowHeightCache *rowHeightCache = self.rowHeightCache;
+    id<UITableViewDataSource> dataSource = self.tableView.dataSource;
+    if (!rowHeightCache || ![dataSource isKindOfClass:[APPSDataSource class]])
+        return;
+    
+    APPSDataSource *rootDataSource = (APPSDataSource *)dataSource;
+    CGFloat width = CGRectGetWidth(self.tableView.bounds);
+    // The cell's height includes the separator drawn below its content view.
+    CGFloat separatorHeight = (self.tableView.separatorStyle == UITableViewCellSeparatorStyleNone) ? 0 : 1.0 / [UIScreen mainScreen].scale;
+    
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    NSMutableArray<NSString *> *texts = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    NSMutableArray<APPSTextLayoutSpec *> *specs = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    NSMutableArray<NSNumber *> *contentWidths = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    NSMutableDictionary<NSNumber *, NSNumber *> *contentWidthsByAccessoryType = [NSMutableDictionary dictionary];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        APPSDataSourceSectionRoute *route = [rootDataSource sectionRouteForGlobalSection:indexPath.section];
+        if (!route)
+            continue;
+        
+        APPSDataSource *leafDataSource = route.dataSource;
+        NSIndexPath *localIndexPath = [route localIndexPathForGlobalIndexPath:indexPath];
+        id item = [leafDataSource itemAtIndexPath:localIndexPath];
+        if (!item || [rowHeightCache heightForItem:item width:width] >= 0)
+            continue;
+        
+        NSString *text = [leafDataSource heightDeterminingTextForItemAtIndexPath:localIndexPath];
+        APPSTextLayoutSpec *spec = [leafDataSource textLayoutSpecForItemAtIndexPath:localIndexPath];
+        if (!text || !spec)
+            continue;
+        
+        NSNumber *accessoryType = @(spec.accessoryType);
+        NSNumber *contentWidth = contentWidthsByAccessoryType[accessoryType];
+        if (!contentWidth) {
+            contentWidth = @([self contentViewWidthOfCellWithAccessoryType:spec.accessoryType]);
+            contentWidthsByAccessoryType[accessoryType] = contentWidth;
+        }
+        
+        [items addObject:item];
+        [texts addObject:[text copy]];
+        [specs addObject:spec];
+        [contentWidths addObject:contentWidth];
+    }
+    
+    if (!items.count)
+        return;
+    
+    NSUInteger generation = self.rowHeightGeneration;
+    __weak typeof(&*self) weakself = self;
+    
+    dispatch_async(self.textLayoutQueue, ^{
+        NSUInteger count = texts.count;
+        CGFloat *heights = calloc(count, sizeof(CGFloat));
+        
+        dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^(size_t index) {
+            heights[index] = [specs[index] heightForText:texts[index] width:contentWidths[index].doubleValue] + separatorHeight;
+        });
+        
+        NSMutableArray<NSNumber *> *results = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger index = 0; index < count; ++index)
+            [results addObject:@(heights[index])];
+        free(heights);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            APPSBaseDataSourceDelegate *me = weakself;
+            // Drop the results if anything was invalidated while measuring, or the cache was replaced.
+            if (!me || me.rowHeightGeneration != generation || me.rowHeightCache != rowHeightCache)
+                return;
+            
+            [items enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
+                [rowHeightCache setHeight:results[index].doubleValue forItem:item width:width];
+            }];
+        });
+    });
+}
+
+
+/// The width a cell's content view gets in this table view once the accessory has taken its share.
+- (CGFloat)contentViewWidthOfCellWithAccessoryType:(UITableViewCellAccessoryType)accessoryType
+{
+    UITableView *tableView = self.tableView;
+    UITableViewCell *cell = [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:nil];
+    cell.frame = CGRectMake(0, 0, CGRectGetWidth(tableView.bounds), tableView.estimatedRowHeight > 0 ? tableView.estimatedRowHeight : 44);
+    cell.accessoryType = accessoryType;
+    cell.preservesSuperviewLayoutMargins = NO;
+    cell.layoutMargins = tableView.layoutMargins;
+    [cell layoutIfNeeded];
+    return CGRectGetWidth(cell.contentView.bounds);
+}
+
+
+- (CGFloat)cachedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    APPSRowHeightCache *rowHeightCache = self.rowHeightCache;
+    if (!rowHeightCache)
+        return -1;
+    
+    id item = [self itemAtIndexPath:indexPath];
+    if (!item)
+        return -1;
+    
+    return [rowHeightCache heightForItem:item width:CGRectGetWidth(self.tableView.bounds)];
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    id<UITableViewDataSource> dataSource = self.tableView.dataSource;
+    if (![dataSource isKindOfClass:[APPSDataSource class]])
+        return nil;
+    
+    return [(APPSDataSource *)dataSource itemAtIndexPath:indexPath];
+}
+
+
+/// Only the refreshed rows are looked up, as they're reported. Within a batch the data source may already hold a shifted item at such a row, which then just gets measured again; an APPSIdentifiable item whose content changed is caught by its content hash wherever it lands.
+- (void)invalidateRowHeightsAtIndexPaths:(NSArray *)indexPaths
+{
+    self.rowHeightGeneration++;
+    
+    APPSRowHeightCache *rowHeightCache = self.rowHeightCache;
+    if (!rowHeightCache)
+        return;
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        id item = [self itemAtIndexPath:indexPath];
+        if (item)
+            [rowHeightCache invalidateHeightsForItem:item];
+    }
+}
+
+
+- (void)invalidateRowHeightsInSections:(NSIndexSet *)sections
+{
+    self.rowHeightGeneration++;
+    
+    APPSRowHeightCache *rowHeightCache = self.rowHeightCache;
+    id<UITableViewDataSource> dataSource = self.tableView.dataSource;
+    if (!rowHeightCache || ![dataSource isKindOfClass:[APPSDataSource class]])
+        return;
+    
+    APPSDataSource *appsDataSource = (APPSDataSource *)dataSource;
+    NSInteger numberOfSections = appsDataSource.numberOfSections;
+    [sections enumerateIndexesUsingBlock:^(NSUInteger sectionIndex, BOOL *stop) {
+        if ((NSInteger)sectionIndex >= numberOfSections)
+            return;
+        
+        NSInteger numberOfRows = [appsDataSource numberOfRowsInSection:sectionIndex];
+        for (NSInteger rowIndex = 0; rowIndex < numberOfRows; ++rowIndex) {
+            id item = [appsDataSource itemAtIndexPath:[NSIndexPath indexPathForRow:rowIndex inSection:sectionIndex]];
+            if (item)
+                [rowHeightCache invalidateHeightsForItem:item];
+        }
+    }];
+}
+
+
+
 #pragma mark - Protocol: APPSDataSourceDelegate
 
 #if UPDATE_DEBUGGING
@@ -151,12 +375,50 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     // to scroll back and forth. If you get the offset and reset it without animation
     // you don't see the scrolling.
     
+    [self invalidateRowHeightsAtIndexPaths:indexPaths];
+    
     CGPoint offset = self.tableView.contentOffset;
     [self.tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:self.updateItemAnimation];
     self.tableView.contentOffset = offset;
 }
 
 
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    UPDATE_LOG(@"RECONFIGURE ITEMS: %@ DATASOURCE: %@", [self stringFromArrayOfIndexPaths:indexPaths], dataSource);
+    // The table view only knows the rows after the update once the batch ends, so the cells are reconfigured then.
+    if (self.performingUpdates)
+        [self.reconfiguredIndexPaths addObjectsFromArray:indexPaths];
+    else
+        [self reconfigureVisibleRowsAtIndexPaths:indexPaths];
+}
+
+
+/// Configure the visible cells of these rows again without dequeuing new ones. Rows the data source can't reconfigure in place are reloaded.
+- (void)reconfigureVisibleRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    UITableView *tableView = self.tableView;
+    id<UITableViewDataSource> dataSource = tableView.dataSource;
+    if (!indexPaths.count || ![dataSource isKindOfClass:[APPSDataSource class]])
+        return;
+    
+    NSSet<NSIndexPath *> *visibleIndexPaths = [NSSet setWithArray:tableView.indexPathsForVisibleRows];
+    NSMutableArray<NSIndexPath *> *reloadedIndexPaths = [NSMutableArray array];
+    
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (![visibleIndexPaths containsObject:indexPath])
+            continue;
+        
+        UITableViewCell *cell = [tableView cellForRowAtIndexPath:indexPath];
+        if (cell && ![(APPSDataSource *)dataSource tableView:tableView reconfigureCell:cell forRowAtIndexPath:indexPath])
+            [reloadedIndexPaths addObject:indexPath];
+    }
+    
+    if (reloadedIndexPaths.count)
+        [tableView reloadRowsAtIndexPaths:reloadedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+}
+
+
 - (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath
 {
     UPDATE_LOG(@"MOVE ITEM: %@ TO: %@ DATASOURCE: %@", APPSStringFromNSIndexPath(fromIndexPath), APPSStringFromNSIndexPath(newIndexPath), dataSource);
@@ -196,6 +458,8 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 - (void)dataSource:(APPSDataSource *)dataSource didRefreshSections:(NSIndexSet *)sections
 {
     UPDATE_LOG(@"REFRESH SECTIONS: %@ DATASOURCE: %@", APPSStringFromNSIndexSet(sections), dataSource);
+    [self invalidateRowHeightsInSections:sections];
+    
     // It's not "legal" to reload a section if you also delete the section later in the same batch update. So we'll just remember that we want to reload these sections when we're performing a batch update and reload them only if they weren't also deleted.
     if (self.performingUpdates)
         [self.reloadedSections addIndexes:sections];
@@ -207,6 +471,8 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 - (void)dataSourceDidReloadData:(APPSDataSource *)dataSource
 {
     UPDATE_LOG(@"RELOAD DATASOURCE: %@", dataSource);
+    // Cached heights are checked against each item's content when they're read, so only in-flight measurements are discarded.
+    self.rowHeightGeneration++;
     [self.tableView reloadData];
 }
 
@@ -252,9 +518,13 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     self.reloadedSections = [NSMutableIndexSet indexSet];
     self.deletedSections = [NSMutableIndexSet indexSet];
     self.insertedSections = [NSMutableIndexSet indexSet];
+    self.reconfiguredIndexPaths = [NSMutableArray array];
     
     __block dispatch_block_t completionHandler = nil;
     
+    // Decide before the rows change whether the table should follow them to the bottom.
+    BOOL shouldScrollToBottom = self.keepsScrolledToBottom && [self isScrolledToBottom];
+    
     [CATransaction begin];
     
     [CATransaction setCompletionBlock:^{
@@ -292,9 +562,38 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     }
     [self.tableView endUpdates];
     
+    NSArray<NSIndexPath *> *reconfiguredIndexPaths = self.reconfiguredIndexPaths;
+    self.reconfiguredIndexPaths = nil;
+    [self reconfigureVisibleRowsAtIndexPaths:reconfiguredIndexPaths];
+    
     [CATransaction commit];
     
+    if (shouldScrollToBottom)
+        [self scrollToBottom];
+}
+
+
+- (BOOL)isScrolledToBottom
+{
+    UITableView *tableView = self.tableView;
+    CGFloat visibleBottom = tableView.contentOffset.y + CGRectGetHeight(tableView.bounds) - tableView.contentInset.bottom;
     
+    // Allow a few points of slack so a table resting just shy of the end, or bouncing, still counts.
+    return visibleBottom >= tableView.contentSize.height - 8.0;
+}
+
+
+- (void)scrollToBottom
+{
+    UITableView *tableView = self.tableView;
+    for (NSInteger section = tableView.numberOfSections - 1; section >= 0; --section) {
+        NSInteger numberOfRows = [tableView numberOfRowsInSection:section];
+        if (numberOfRows) {
+            NSIndexPath *lastIndexPath = [NSIndexPath indexPathForRow:numberOfRows - 1 inSection:section];
+            [tableView scrollToRowAtIndexPath:lastIndexPath atScrollPosition:UITableViewScrollPositionBottom animated:YES];
+            return;
+        }
+    }
 }
 
 
@@ -303,8 +602,7 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     UPDATE_LOG(@"Dismiss placeholder: sections=%@ DATASOURCE: %@", APPSStringFromNSIndexSet(sections), dataSource);
     [self.reloadedSections addIndexes:sections];
     
-    [self dataSource:dataSource updatePlaceholderViewForSections:sections];
-    self.placeholderView = nil;
+    [self setNeedsUpdatePlaceholderViewForDataSource:dataSource sections:sections dismissal:YES];
 }
 
 
@@ -313,11 +611,7 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     UPDATE_LOG(@"Present activity indicator: sections=%@ DATASOURCE: %@", APPSStringFromNSIndexSet(sections), dataSource);
     [self.reloadedSections addIndexes:sections];
     
-    if (!_placeholderView) {
-        _placeholderView = [dataSource dequeuePlaceholderViewForTableView:self.tableView];
-    }
-    
-    [self dataSource:dataSource updatePlaceholderViewForSections:sections];
+    [self setNeedsUpdatePlaceholderViewForDataSource:dataSource sections:sections dismissal:NO];
 }
 
 
@@ -326,11 +620,7 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
     UPDATE_LOG(@"Present placeholder: sections=%@ DATASOURCE: %@", APPSStringFromNSIndexSet(sections), dataSource);
     [self.reloadedSections addIndexes:sections];
     
-    if (!_placeholderView) {
-        _placeholderView = [dataSource dequeuePlaceholderViewForTableView:self.tableView];
-    }
-    
-    [self dataSource:dataSource updatePlaceholderViewForSections:sections];
+    [self setNeedsUpdatePlaceholderViewForDataSource:dataSource sections:sections dismissal:NO];
 }
 
 
@@ -356,6 +646,62 @@ static void * const APPSDataSourceContext = @"DataSourceContext";
 
 #pragma mark - Helper
 
+/// Note a placeholder change, and apply all of this run loop turn's changes at once at its end. A dashboard of many children loading at once reports a flurry of changes; the data source's state after the last one is what the user should see, across every section reported.
+- (void)setNeedsUpdatePlaceholderViewForDataSource:(APPSDataSource *)dataSource sections:(NSIndexSet *)sections dismissal:(BOOL)dismissal
+{
+    if (self.pendingPlaceholderDataSource != dataSource) {
+        self.pendingPlaceholderDataSource = dataSource;
+        self.pendingPlaceholderSections = [NSMutableIndexSet indexSet];
+    }
+    [self.pendingPlaceholderSections addIndexes:sections];
+    self.pendingPlaceholderDismissal = dismissal;
+    
+    if (_placeholderUpdateObserver)
+        return;
+    
+    // Before waiting, in the common modes, so the change lands in this frame's commit even while a scroll is tracking:
+    __weak typeof(self) weakSelf = self;
+    _placeholderUpdateObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, NO, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [weakSelf updatePendingPlaceholderView];
+    });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), _placeholderUpdateObserver, kCFRunLoopCommonModes);
+}
+
+
+- (void)removePlaceholderUpdateObserver
+{
+    if (!_placeholderUpdateObserver)
+        return;
+    
+    CFRunLoopObserverInvalidate(_placeholderUpdateObserver);
+    CFRelease(_placeholderUpdateObserver);
+    _placeholderUpdateObserver = NULL;
+}
+
+
+- (void)updatePendingPlaceholderView
+{
+    [self removePlaceholderUpdateObserver];
+    
+    APPSDataSource *dataSource = self.pendingPlaceholderDataSource;
+    if (!dataSource)
+        return;
+    
+    self.pendingPlaceholderDataSource = nil;
+    
+    // The data source works out what to show from its current state, which by now reflects every child's loading state.
+    if (!self.pendingPlaceholderDismissal && !_placeholderView) {
+        _placeholderView = [dataSource dequeuePlaceholderViewForTableView:self.tableView];
+    }
+    
+    [self dataSource:dataSource updatePlaceholderViewForSections:self.pendingPlaceholderSections];
+    
+    if (self.pendingPlaceholderDismissal) {
+        self.placeholderView = nil;
+    }
+}
+
+
 - (void)dataSource:(APPSDataSource *)dataSource updatePlaceholderViewForSections:(NSIndexSet *)sections
 {
     NSInteger sectionIndex = 0;
@@ -18,9 +18,13 @@
 
 
 #import "APPSDataSource.h"
+#import "APPSItemPatch.h"
+#import "APPSItemVector.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class APPSDataSourceDiff;
+
 
 /**
  A subclass of APPSDataSource which permits only one section but manages its items in an NSArray. This class will perform all the necessary updates to animate changes to the array of items if they are updated using -setItems:animated:.
@@ -33,6 +37,25 @@ NS_ASSUME_NONNULL_BEGIN
 /// Set the items with optional animation. By default, setting the items is not animated.
 - (void)setItems:(NSArray *)items animated:(BOOL)animated;
 
+/// Move a single item, notifying one move. Must be called within -performUpdate:.
+- (void)moveItemAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+/// The current items. Items are stored in an APPSItemVector, so a snapshot costs O(1) and never changes afterwards. Unlike items, this may be read from any thread.
+@property (readonly) APPSItemVector *itemsSnapshot;
+
+/**
+ Install items prepared off the main thread. A background producer takes itemsSnapshot, derives the next snapshot from it with the vector's editing methods, and may compute the diff between the two with APPSDataSourceDiff, all without blocking the main thread. Applying the result is then just a pointer swap plus the diff's notifications. If the items changed after baseSnapshot was taken, the change is re-diffed against the current items instead. A nil diff refreshes the section. Must be called within -performUpdate:.
+ */
+- (void)applySnapshot:(APPSItemVector *)snapshot basedOnSnapshot:(APPSItemVector *)baseSnapshot diff:(nullable APPSDataSourceDiff *)diff;
+
+/// Incremented whenever the items change. Record it alongside the items a patch will be computed against.
+@property (nonatomic, readonly) NSUInteger itemsGeneration;
+
+/**
+ Apply a patch of edits to APPSIdentifiable items, notifying exactly the rows it touches without diffing the whole list. Each operation costs O(log n): the position of every identifier is kept in an index that patches update in place, and that's only rebuilt after some other kind of change. Nothing is changed and NO is returned when the patch was made against another generation or doesn't apply to the items. Must be called within -performUpdate:.
+ */
+- (BOOL)applyPatch:(APPSItemPatch *)patch error:(NSError **)error;
+
 @end
 
 
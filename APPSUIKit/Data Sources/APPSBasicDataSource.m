@@ -16,9 +16,27 @@
  */
 
 #import "APPSBasicDataSource.h"
+#import "APPSDataSourceDiff.h"
+#import "APPSIdentityIndex.h"
+#import "APPSItemPatch_Private.h"
+#import "APPSItemVector.h"
 
+@import Darwin.os.lock;
 
-@implementation APPSBasicDataSource
+
+@interface APPSBasicDataSource ()
+/// Identifier → content hash of the items as last set, when they adopt APPSIdentifiable. Lets changes to items mutated in place be detected.
+@property (nonatomic, copy) NSDictionary<id, NSNumber *> *itemContentHashes;
+/// The position of each item's identifier, built on demand for patches and kept current by them. Any other change discards it.
+@property (nonatomic, strong) APPSIdentityIndex *identityIndex;
+@property (nonatomic, readwrite) NSUInteger itemsGeneration;
+@end
+
+
+@implementation APPSBasicDataSource {
+    /// Guards reads of _items from other threads against the swap on the main thread.
+    os_unfair_lock _itemsLock;
+}
 
 
 #pragma mark - APPSDataSource
@@ -28,7 +46,8 @@
     self = [super init];
     if (!self)
         return nil;
-    _items = @[];
+    _items = [APPSItemVector vectorWithArray:@[]];
+    _itemsLock = OS_UNFAIR_LOCK_INIT;
     return self;
 }
 
@@ -80,64 +99,228 @@
 
 - (void)setItems:(NSArray *)items animated:(BOOL)animated
 {
-	if (_items == items || [_items isEqualToArray:items])
+	NSDictionary *contentHashes = [APPSDataSourceDiff contentHashesForItems:items];
+	BOOL contentUnchanged = !contentHashes || [contentHashes isEqualToDictionary:_itemContentHashes];
+	if ((_items == items || [_items isEqualToArray:items]) && contentUnchanged)
 		return;
 	
     APPS_ASSERT_IN_DATASOURCE_UPDATE();
 
-	if (!animated) {
-		_items = [items copy];
-		[self updateLoadingStateFromItems];
-		[self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
-		return;
-	}
-	
-	NSOrderedSet *oldItemSet = [NSOrderedSet orderedSetWithArray:_items];
-	NSOrderedSet *newItemSet = [NSOrderedSet orderedSetWithArray:items];
-	
-	NSMutableOrderedSet *deletedItems = [oldItemSet mutableCopy];
-	[deletedItems minusOrderedSet:newItemSet];
+	// Duplicate items can't be diffed by identity, so those changes are applied without animation.
+	APPSDataSourceDiff *diff = animated ? [APPSDataSourceDiff diffFromItems:_items toItems:items previousContentHashes:_itemContentHashes] : nil;
 	
-	NSMutableOrderedSet *newItems = [newItemSet mutableCopy];
-	[newItems minusOrderedSet:oldItemSet];
-	
-	NSMutableOrderedSet *movedItems = [newItemSet mutableCopy];
-	[movedItems intersectOrderedSet:oldItemSet];
-	
-	NSMutableArray *deletedIndexPaths = [NSMutableArray arrayWithCapacity:[deletedItems count]];
-	for (id deletedItem in deletedItems) {
-		[deletedIndexPaths addObject:[NSIndexPath indexPathForItem:[oldItemSet indexOfObject:deletedItem] inSection:0]];
-	}
-	
-	NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:[newItems count]];
-	for (id newItem in newItems) {
-		[insertedIndexPaths addObject:[NSIndexPath indexPathForItem:[newItemSet indexOfObject:newItem] inSection:0]];
-	}
+	[self swapItems:[APPSItemVector vectorWithArray:items]];
+	_itemContentHashes = contentHashes;
+	[self updateLoadingStateFromItems];
 	
-	NSMutableArray *fromMovedIndexPaths = [NSMutableArray arrayWithCapacity:[movedItems count]];
-	NSMutableArray *toMovedIndexPaths = [NSMutableArray arrayWithCapacity:[movedItems count]];
-	for (id movedItem in movedItems) {
-		[fromMovedIndexPaths addObject:[NSIndexPath indexPathForItem:[oldItemSet indexOfObject:movedItem] inSection:0]];
-		[toMovedIndexPaths addObject:[NSIndexPath indexPathForItem:[newItemSet indexOfObject:movedItem] inSection:0]];
+	if (!diff) {
+		[self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
+		return;
 	}
 	
-	_items = [items copy];
-	[self updateLoadingStateFromItems];
-	
+	[diff notifyDataSource:self section:0];
+}
+
+
+- (APPSItemVector *)itemsSnapshot
+{
+    os_unfair_lock_lock(&_itemsLock);
+    APPSItemVector *items = (APPSItemVector *)_items;
+    os_unfair_lock_unlock(&_itemsLock);
+    return items;
+}
+
+
+- (void)applySnapshot:(APPSItemVector *)snapshot basedOnSnapshot:(APPSItemVector *)baseSnapshot diff:(APPSDataSourceDiff *)diff
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+    
+    // Something else changed the items after the snapshot was taken, so the precomputed diff no longer describes the change.
+    if (_items != baseSnapshot) {
+        [self setItems:snapshot animated:diff != nil];
+        return;
+    }
     
-    if ([deletedIndexPaths count])
-        [self notifyItemsRemovedAtIndexPaths:deletedIndexPaths];
+    [self swapItems:snapshot];
+    _itemContentHashes = nil;
+    [self updateLoadingStateFromItems];
+    
+    if (!diff) {
+        [self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
+        return;
+    }
+    
+    [diff notifyDataSource:self section:0];
+}
+
+
+/// Every change to the items ends here. Only the pointer swap is locked; the new items were built beforehand without touching the old ones.
+- (void)swapItems:(APPSItemVector *)items
+{
+    os_unfair_lock_lock(&_itemsLock);
+    _items = items;
+    os_unfair_lock_unlock(&_itemsLock);
+    
+    ++_itemsGeneration;
+    _identityIndex = nil;
+}
+
+
+
+#pragma mark - Patches
+
+- (BOOL)applyPatch:(APPSItemPatch *)patch error:(NSError **)error
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
     
-    if ([insertedIndexPaths count])
+    if (patch.baseGeneration != _itemsGeneration)
+        return [self patchFailedWithCode:APPSItemPatchErrorGenerationMismatch description:@"The items changed after the patch was made." error:error];
+    
+    APPSIdentityIndex *identityIndex = [self currentIdentityIndex];
+    if (!identityIndex)
+        return [self patchFailedWithCode:APPSItemPatchErrorItemsNotIdentifiable description:@"The items must adopt APPSIdentifiable, with unique identifiers." error:error];
+    
+    // Where each touched identifier started, looked up before anything moves. NSNotFound marks identifiers new to the list.
+    NSMutableDictionary<id, NSNumber *> *originalIndexes = [NSMutableDictionary dictionary];
+    for (APPSItemPatchOperation *operation in patch.operations) {
+        if (!originalIndexes[operation.identifier])
+            originalIndexes[operation.identifier] = @([identityIndex indexOfIdentifier:operation.identifier]);
+    }
+    
+    APPSItemVector *items = (APPSItemVector *)_items;
+    NSMutableSet *movedIdentifiers = [NSMutableSet set];
+    NSMutableSet *updatedIdentifiers = [NSMutableSet set];
+    NSMutableSet *reinsertedIdentifiers = [NSMutableSet set];
+    
+    for (APPSItemPatchOperation *operation in patch.operations) {
+        id identifier = operation.identifier;
+        NSUInteger index = NSNotFound;
+        BOOL valid = YES;
+        
+        switch (operation.type) {
+            case APPSItemPatchOperationTypeInsert:
+                valid = [identityIndex indexOfIdentifier:identifier] == NSNotFound && operation.index <= identityIndex.count;
+                if (valid) {
+                    items = [items vectorByInsertingObjects:@[operation.item] atIndex:operation.index];
+                    [identityIndex insertIdentifier:identifier atIndex:operation.index];
+                    if ([originalIndexes[identifier] unsignedIntegerValue] != NSNotFound)
+                        [reinsertedIdentifiers addObject:identifier];
+                }
+                break;
+                
+            case APPSItemPatchOperationTypeDelete:
+                index = [identityIndex removeIdentifier:identifier];
+                valid = index != NSNotFound;
+                if (valid)
+                    items = [items vectorByRemovingObjectsInRange:NSMakeRange(index, 1)];
+                break;
+                
+            case APPSItemPatchOperationTypeMove:
+                index = [identityIndex indexOfIdentifier:identifier];
+                valid = index != NSNotFound && operation.index < identityIndex.count;
+                if (valid) {
+                    items = [items vectorByMovingObjectAtIndex:index toIndex:operation.index];
+                    [identityIndex removeIdentifier:identifier];
+                    [identityIndex insertIdentifier:identifier atIndex:operation.index];
+                    [movedIdentifiers addObject:identifier];
+                }
+                break;
+                
+            case APPSItemPatchOperationTypeUpdate:
+                index = [identityIndex indexOfIdentifier:identifier];
+                valid = index != NSNotFound;
+                if (valid) {
+                    items = [items vectorByReplacingObjectAtIndex:index withObject:operation.item];
+                    [updatedIdentifiers addObject:identifier];
+                }
+                break;
+        }
+        
+        // The items haven't been touched yet, but the index has, so it's rebuilt the next time it's needed.
+        if (!valid) {
+            _identityIndex = nil;
+            return [self patchFailedWithCode:APPSItemPatchErrorInvalidOperation description:[NSString stringWithFormat:@"The patch doesn't apply to the current items at the operation for %@.", identifier] error:error];
+        }
+    }
+    
+    // Translate the touched identifiers' start and end positions into one batch: removals in old coordinates, insertions in new ones, and the table view shifts everything else.
+    NSMutableArray *removedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+    NSMutableArray *refreshedIndexPaths = [NSMutableArray array];
+    NSMutableArray *moves = [NSMutableArray array];
+    
+    [originalIndexes enumerateKeysAndObjectsUsingBlock:^(id identifier, NSNumber *originalIndex, BOOL *stop) {
+        NSUInteger fromIndex = originalIndex.unsignedIntegerValue;
+        NSUInteger toIndex = [identityIndex indexOfIdentifier:identifier];
+        BOOL moved = [movedIdentifiers containsObject:identifier];
+        BOOL updated = [updatedIdentifiers containsObject:identifier];
+        
+        if (fromIndex == NSNotFound && toIndex == NSNotFound)
+            return;
+        
+        NSIndexPath *fromIndexPath = [NSIndexPath indexPathForItem:fromIndex inSection:0];
+        NSIndexPath *toIndexPath = [NSIndexPath indexPathForItem:toIndex inSection:0];
+        
+        if (fromIndex == NSNotFound) {
+            [insertedIndexPaths addObject:toIndexPath];
+        }
+        else if (toIndex == NSNotFound) {
+            [removedIndexPaths addObject:fromIndexPath];
+        }
+        else if ([reinsertedIdentifiers containsObject:identifier] || (moved && updated)) {
+            // A table view can't reload and move the same row in one batch.
+            [removedIndexPaths addObject:fromIndexPath];
+            [insertedIndexPaths addObject:toIndexPath];
+        }
+        else if (moved) {
+            [moves addObject:@[fromIndexPath, toIndexPath]];
+        }
+        else if (updated) {
+            [refreshedIndexPaths addObject:fromIndexPath];
+        }
+    }];
+    
+    [self swapItems:items];
+    _identityIndex = identityIndex;
+    _itemContentHashes = nil;
+    [self updateLoadingStateFromItems];
+    
+    if (removedIndexPaths.count)
+        [self notifyItemsRemovedAtIndexPaths:removedIndexPaths];
+    if (insertedIndexPaths.count)
         [self notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
+    for (NSArray<NSIndexPath *> *move in moves)
+        [self notifyItemMovedFromIndexPath:move[0] toIndexPaths:move[1]];
+    if (refreshedIndexPaths.count)
+        [self notifyItemsRefreshedAtIndexPaths:refreshedIndexPaths];
     
-    NSUInteger count = [fromMovedIndexPaths count];
-    for (NSUInteger i = 0; i < count; ++i) {
-        NSIndexPath *fromIndexPath = fromMovedIndexPaths[i];
-        NSIndexPath *toIndexPath = toMovedIndexPaths[i];
-        if (![fromIndexPath isEqual:toIndexPath])
-            [self notifyItemMovedFromIndexPath:fromIndexPath toIndexPaths:toIndexPath];
+    return YES;
+}
+
+
+/// The identity index for the current items, building it if a change other than a patch discarded it. Returns nil when the items can't be indexed by identifier.
+- (APPSIdentityIndex *)currentIdentityIndex
+{
+    if (_identityIndex)
+        return _identityIndex;
+    
+    NSMutableArray *identifiers = [NSMutableArray arrayWithCapacity:[_items count]];
+    for (id item in _items) {
+        if (![item conformsToProtocol:@protocol(APPSIdentifiable)])
+            return nil;
+        [identifiers addObject:[(id<APPSIdentifiable>)item itemIdentifier]];
     }
+    
+    _identityIndex = [[APPSIdentityIndex alloc] initWithIdentifiers:identifiers];
+    return _identityIndex;
+}
+
+
+- (BOOL)patchFailedWithCode:(APPSItemPatchError)code description:(NSString *)description error:(NSError **)error
+{
+    if (error)
+        *error = [NSError errorWithDomain:APPSItemPatchErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey : description }];
+    return NO;
 }
 
 
@@ -175,8 +358,13 @@
 
 - (void)insertItems:(NSArray *)array atIndexes:(NSIndexSet *)indexes
 {
-    NSMutableArray *newItems = [_items mutableCopy];
-    [newItems insertObjects:array atIndexes:indexes];
+    // Indexes are in final coordinates, so inserting each run in ascending order puts every item in place.
+    __block APPSItemVector *newItems = (APPSItemVector *)_items;
+    __block NSUInteger offset = 0;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        newItems = [newItems vectorByInsertingObjects:[array subarrayWithRange:NSMakeRange(offset, range.length)] atIndex:range.location];
+        offset += range.length;
+    }];
     
     NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:[indexes count]];
     [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
@@ -185,7 +373,8 @@
     
     APPS_ASSERT_IN_DATASOURCE_UPDATE();
     
-    _items = newItems;
+    [self swapItems:newItems];
+    _itemContentHashes = nil;
     [self updateLoadingStateFromItems];
     [self notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
 }
@@ -193,46 +382,34 @@
 
 - (void)removeItemsAtIndexes:(NSIndexSet *)indexes
 {
-	NSInteger newCount = [_items count] - [indexes count];
-	NSMutableArray *newItems = [[NSMutableArray alloc] initWithCapacity:newCount];
-	
-	// set up a delayed set of batch update calls for later execution
-	__block dispatch_block_t batchUpdates = ^{};
-	batchUpdates = [batchUpdates copy];
-	
-	[_items enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-		dispatch_block_t oldUpdates = batchUpdates;
-		if ([indexes containsIndex:idx]) {
-			// we're removing this item
-			batchUpdates = ^{
-				oldUpdates();
-				[self notifyItemsRemovedAtIndexPaths:@[[NSIndexPath indexPathForItem:idx inSection:0]]];
-			};
-		}
-		else {
-			// we're keeping this item
-			NSUInteger newIdx = [newItems count];
-			[newItems addObject:obj];
-			batchUpdates = ^{
-				oldUpdates();
-				[self notifyItemMovedFromIndexPath:[NSIndexPath indexPathForItem:idx inSection:0] toIndexPaths:[NSIndexPath indexPathForItem:newIdx inSection:0]];
-			};
-		}
-		batchUpdates = [batchUpdates copy];
-	}];
-	
+    // Removing runs from the end first keeps the earlier indexes valid.
+    __block APPSItemVector *newItems = (APPSItemVector *)_items;
+    [indexes enumerateRangesWithOptions:NSEnumerationReverse usingBlock:^(NSRange range, BOOL *stop) {
+        newItems = [newItems vectorByRemovingObjectsInRange:range];
+    }];
+    
+    // The table view shifts the remaining rows itself, so a single removal is all it needs to hear about.
+    NSMutableArray *removedIndexPaths = [NSMutableArray arrayWithCapacity:[indexes count]];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        [removedIndexPaths addObject:[NSIndexPath indexPathForItem:idx inSection:0]];
+    }];
+    
     APPS_ASSERT_IN_DATASOURCE_UPDATE();
     
-	_items = newItems;
-    batchUpdates();
+    [self swapItems:newItems];
+    _itemContentHashes = nil;
     [self updateLoadingStateFromItems];
+    [self notifyItemsRemovedAtIndexPaths:removedIndexPaths];
 }
 
 
 - (void)replaceItemsAtIndexes:(NSIndexSet *)indexes withItems:(NSArray *)array
 {
-    NSMutableArray *newItems = [_items mutableCopy];
-    [newItems replaceObjectsAtIndexes:indexes withObjects:array];
+    __block APPSItemVector *newItems = (APPSItemVector *)_items;
+    __block NSUInteger offset = 0;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        newItems = [newItems vectorByReplacingObjectAtIndex:idx withObject:array[offset++]];
+    }];
     
     NSMutableArray *replacedIndexPaths = [NSMutableArray arrayWithCapacity:[indexes count]];
     [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
@@ -241,7 +418,8 @@
     
     APPS_ASSERT_IN_DATASOURCE_UPDATE();
     
-    _items = newItems;
+    [self swapItems:newItems];
+    _itemContentHashes = nil;
     [self notifyItemsRefreshedAtIndexPaths:replacedIndexPaths];
 }
 
@@ -252,6 +430,23 @@
 }
 
 
+- (void)moveItemAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex
+{
+    NSParameterAssert(fromIndex < [_items count] && toIndex < [_items count]);
+    
+    if (fromIndex == toIndex)
+        return;
+    
+    APPSItemVector *newItems = [(APPSItemVector *)_items vectorByMovingObjectAtIndex:fromIndex toIndex:toIndex];
+    
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+    
+    [self swapItems:newItems];
+    _itemContentHashes = nil;
+    [self notifyItemMovedFromIndexPath:[NSIndexPath indexPathForItem:fromIndex inSection:0] toIndexPaths:[NSIndexPath indexPathForItem:toIndex inSection:0]];
+}
+
+
 #pragma mark - Protocol: UITableViewDataSource
 
 - (void)collectionView:(UICollectionView *)collectionView moveItemAtIndexPath:(NSIndexPath *)indexPath toIndexPath:(NSIndexPath *)destinationIndexPath
@@ -269,14 +464,7 @@
     if (toIndex >= numberOfItems)
         toIndex = numberOfItems - 1;
     
-    NSMutableArray *items = [_items mutableCopy];
-    
-    id movingObject = items[fromIndex];
-    
-    [items removeObjectAtIndex:fromIndex];
-    [items insertObject:movingObject atIndex:toIndex];
-    
-    _items = items;
+    [self swapItems:[(APPSItemVector *)_items vectorByMovingObjectAtIndex:fromIndex toIndex:toIndex]];
     [self notifyItemMovedFromIndexPath:indexPath toIndexPaths:destinationIndexPath];
 }
 
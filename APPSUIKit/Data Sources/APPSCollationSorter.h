@@ -0,0 +1,65 @@
+//
+//  APPSCollationSorter.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import UIKit;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns the string an item is sorted by, or nil to sort it as an empty string.
+typedef NSString * __nullable (^APPSCollationStringBlock)(id item);
+
+
+/// Items partitioned into alphabetical sections, ready for -[APPSRobustArrayDataSource initWithSectionPartitionedModelItems:defaultCellIdentifier:customCellIdentifiers:sectionNames:configureCellBlock:].
+@interface APPSCollatedSections : NSObject
+
+/// The titles of the non-empty sections, taken from UILocalizedIndexedCollation for the app's localization. In English, these are A–Z followed by "#".
+@property (nonatomic, copy, readonly) NSArray<NSString *> *sectionTitles;
+
+/// One sorted array of items per section title.
+@property (nonatomic, copy, readonly) NSArray<NSArray *> *partitionedItems;
+
+@end
+
+
+/**
+ Sorts items by a string in a locale-aware, case-, diacritic- and width-insensitive order, much faster than sorting with -localizedCaseInsensitiveCompare:.
+
+ Each item's string is turned into an ICU collation sort key for the locale once, and the key is cached against the item's identity, so later sorts of the same items skip that work entirely. Sorting compares the key bytes, never collating the strings again, and large arrays are sorted with a merge sort spread across the available cores. Sections come from UILocalizedIndexedCollation.
+
+ The cache holds items weakly. When an item's string changes, invalidate its key. A sorter may be used from any single queue at a time, so sorting can happen off the main thread.
+ */
+@interface APPSCollationSorter : NSObject
+
+/// Create a sorter that orders items by the string at keyPath. A nil locale uses the current locale.
+- (instancetype)initWithKeyPath:(NSString *)keyPath locale:(nullable NSLocale *)locale;
+
+/// Create a sorter that orders items by the string returned from stringBlock, which is always called on the thread doing the sort. A nil locale uses the current locale.
+- (instancetype)initWithStringBlock:(APPSCollationStringBlock)stringBlock locale:(nullable NSLocale *)locale NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The locale the collation keys are made for.
+@property (nonatomic, strong, readonly) NSLocale *locale;
+
+/// The cached collation sort key of item, computing it if needed. Comparing two keys byte by byte orders their items.
+- (NSData *)collationKeyForItem:(id)item;
+
+/// Return items sorted by collation key. Items with equal keys keep their relative order.
+- (NSArray *)sortedArrayFromArray:(NSArray *)items;
+
+/// Sort items and partition them into the sections of the current UILocalizedIndexedCollation.
+- (APPSCollatedSections *)collatedSectionsFromArray:(NSArray *)items;
+
+/// Forget the cached key of item, after the string it is sorted by has changed.
+- (void)invalidateCollationKeyForItem:(id)item;
+
+/// Forget every cached key.
+- (void)invalidateAllCollationKeys;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,348 @@
+//
+//  APPSCollationSorter.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSCollationSorter.h"
+#include <stdlib.h>
+
+/// Below this many items per core, sorting on a single thread is faster than coordinating several.
+static const NSUInteger APPSCollationParallelSortThreshold = 4096;
+
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger index;
+} APPSCollationEntry;
+
+
+
+#pragma mark - ICU Collation
+
+// libicucore ships with iOS but without its headers. These are the few collation calls the sorter uses, as ICU declares them.
+typedef struct UCollator UCollator;
+typedef int UErrorCode;
+enum { U_ZERO_ERROR = 0 };
+enum { UCOL_PRIMARY = 0 };
+
+extern UCollator *ucol_open(const char *locale, UErrorCode *status);
+extern void ucol_close(UCollator *collator);
+extern void ucol_setStrength(UCollator *collator, int strength);
+extern int32_t ucol_getSortKey(const UCollator *collator, const UniChar *source, int32_t sourceLength, uint8_t *result, int32_t resultLength);
+
+
+/// A collator for locale at primary strength, which ignores case, diacritics and width. Returns NULL if ICU can't make one.
+static UCollator *APPSCollationOpenCollator(NSLocale *locale)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *collator = ucol_open(locale.localeIdentifier.UTF8String, &status);
+    if (status > U_ZERO_ERROR) {
+        ucol_close(collator);
+        return NULL;
+    }
+
+    ucol_setStrength(collator, UCOL_PRIMARY);
+    return collator;
+}
+
+
+/// The ICU sort key of string. Comparing two keys byte by byte orders their strings as the collator would, without collating again.
+static NSData *APPSCollationSortKey(const UCollator *collator, NSString *string)
+{
+    if (!collator)
+        return [NSData data];
+
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    const UniChar *characters = CFStringGetCharactersPtr(cfString);
+    UniChar *characterBuffer = NULL;
+    if (!characters) {
+        characterBuffer = malloc(MAX(length, 1) * sizeof(UniChar));
+        CFStringGetCharacters(cfString, CFRangeMake(0, length), characterBuffer);
+        characters = characterBuffer;
+    }
+
+    // Most keys fit on the stack; a longer one reports its length and is fetched again.
+    uint8_t stackKey[256];
+    int32_t keyLength = ucol_getSortKey(collator, characters, (int32_t)length, stackKey, sizeof(stackKey));
+    NSData *key;
+    if (keyLength <= (int32_t)sizeof(stackKey))
+        key = [NSData dataWithBytes:stackKey length:keyLength];
+    else {
+        uint8_t *heapKey = malloc(keyLength);
+        ucol_getSortKey(collator, characters, (int32_t)length, heapKey, keyLength);
+        key = [NSData dataWithBytesNoCopy:heapKey length:keyLength freeWhenDone:YES];
+    }
+
+    free(characterBuffer);
+    return key;
+}
+
+
+
+#pragma mark - Sorting
+
+/// Order entries by sort key bytes, then by original position so the sort is stable.
+static int APPSCollationCompareEntries(const APPSCollationEntry *entry1, const APPSCollationEntry *entry2)
+{
+    int result = memcmp(entry1->bytes, entry2->bytes, MIN(entry1->length, entry2->length));
+    if (result)
+        return result;
+    if (entry1->length != entry2->length)
+        return entry1->length < entry2->length ? -1 : 1;
+    return entry1->index < entry2->index ? -1 : (entry1->index > entry2->index ? 1 : 0);
+}
+
+
+static void APPSCollationSortRun(APPSCollationEntry *entries, NSUInteger count)
+{
+    qsort_b(entries, count, sizeof(APPSCollationEntry), ^int(const void *entry1, const void *entry2) {
+        return APPSCollationCompareEntries(entry1, entry2);
+    });
+}
+
+
+/// Sort each core's share of the entries concurrently, then merge neighbouring runs pairwise, each round in parallel, until one run remains.
+static void APPSCollationSortEntries(APPSCollationEntry *entries, NSUInteger count)
+{
+    NSUInteger runCount = MIN([NSProcessInfo processInfo].activeProcessorCount, count / APPSCollationParallelSortThreshold);
+    if (runCount < 2) {
+        APPSCollationSortRun(entries, count);
+        return;
+    }
+
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    NSUInteger runLength = (count + runCount - 1) / runCount;
+
+    dispatch_apply(runCount, queue, ^(size_t run) {
+        NSUInteger start = run * runLength;
+        APPSCollationSortRun(entries + start, MIN(runLength, count - start));
+    });
+
+    APPSCollationEntry *buffer = malloc(count * sizeof(APPSCollationEntry));
+    APPSCollationEntry *source = entries;
+    APPSCollationEntry *destination = buffer;
+
+    for (NSUInteger width = runLength; width < count; width *= 2) {
+        NSUInteger pairCount = (count + 2 * width - 1) / (2 * width);
+        APPSCollationEntry *from = source;
+        APPSCollationEntry *to = destination;
+
+        dispatch_apply(pairCount, queue, ^(size_t pair) {
+            NSUInteger start = pair * 2 * width;
+            NSUInteger middle = MIN(start + width, count);
+            NSUInteger end = MIN(start + 2 * width, count);
+            NSUInteger left = start, right = middle, out = start;
+
+            while (left < middle && right < end)
+                to[out++] = APPSCollationCompareEntries(&from[left], &from[right]) <= 0 ? from[left++] : from[right++];
+            while (left < middle)
+                to[out++] = from[left++];
+            while (right < end)
+                to[out++] = from[right++];
+        });
+
+        source = to;
+        destination = from;
+    }
+
+    if (source != entries)
+        memcpy(entries, source, count * sizeof(APPSCollationEntry));
+    free(buffer);
+}
+
+
+
+@interface APPSCollatedSections ()
+@property (nonatomic, copy, readwrite) NSArray<NSString *> *sectionTitles;
+@property (nonatomic, copy, readwrite) NSArray<NSArray *> *partitionedItems;
+@end
+
+@implementation APPSCollatedSections
+@end
+
+
+
+@interface APPSCollationSorter ()
+@property (nonatomic, strong, readwrite) NSLocale *locale;
+@property (nonatomic, copy) APPSCollationStringBlock stringBlock;
+/// Item (by identity, held weakly) → ICU sort key.
+@property (nonatomic, strong) NSMapTable *keysByItem;
+@end
+
+@implementation APPSCollationSorter
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath locale:(NSLocale *)locale
+{
+    NSParameterAssert(keyPath != nil);
+
+    return [self initWithStringBlock:^NSString *(id item) {
+        id value = [item valueForKeyPath:keyPath];
+        return [value isKindOfClass:[NSString class]] ? value : nil;
+    } locale:locale];
+}
+
+
+- (instancetype)initWithStringBlock:(APPSCollationStringBlock)stringBlock locale:(NSLocale *)locale
+{
+    NSParameterAssert(stringBlock != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _stringBlock = [stringBlock copy];
+    _locale = locale ?: [NSLocale currentLocale];
+    _keysByItem = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                        valueOptions:NSPointerFunctionsStrongMemory];
+    return self;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSData *)collationKeyForItem:(id)item
+{
+    NSData *key = [_keysByItem objectForKey:item];
+    if (!key) {
+        UCollator *collator = APPSCollationOpenCollator(self.locale);
+        key = APPSCollationSortKey(collator, self.stringBlock(item) ?: @"");
+        if (collator)
+            ucol_close(collator);
+        [_keysByItem setObject:key forKey:item];
+    }
+    return key;
+}
+
+
+- (NSArray *)sortedArrayFromArray:(NSArray *)items
+{
+    NSArray<NSData *> *keys = [self collationKeysForItems:items];
+    NSUInteger count = items.count;
+    if (count < 2)
+        return [items copy];
+
+    APPSCollationEntry *entries = malloc(count * sizeof(APPSCollationEntry));
+    // keys holds the sort keys, so their bytes stay valid through the sort.
+    for (NSUInteger index = 0; index < count; ++index)
+        entries[index] = (APPSCollationEntry){ keys[index].bytes, keys[index].length, index };
+
+    APPSCollationSortEntries(entries, count);
+
+    NSMutableArray *sortedItems = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; ++index)
+        [sortedItems addObject:items[entries[index].index]];
+
+    free(entries);
+    return sortedItems;
+}
+
+
+- (APPSCollatedSections *)collatedSectionsFromArray:(NSArray *)items
+{
+    NSArray *sortedItems = [self sortedArrayFromArray:items];
+    UILocalizedIndexedCollation *collation = [UILocalizedIndexedCollation currentCollation];
+    NSArray<NSString *> *collationTitles = collation.sectionTitles;
+
+    NSMutableArray<NSMutableArray *> *buckets = [NSMutableArray arrayWithCapacity:collationTitles.count];
+    for (NSUInteger bucketIndex = 0; bucketIndex < collationTitles.count; ++bucketIndex)
+        [buckets addObject:[NSMutableArray array]];
+
+    // The collation reads the string through a selector, so hand it the string itself. Items go into their buckets in sorted order, keeping each bucket sorted.
+    for (id item in sortedItems) {
+        NSString *string = self.stringBlock(item) ?: @"";
+        [buckets[[collation sectionForObject:string collationStringSelector:@selector(self)]] addObject:item];
+    }
+
+    NSMutableArray *sectionTitles = [NSMutableArray array];
+    NSMutableArray *partitionedItems = [NSMutableArray array];
+    [buckets enumerateObjectsUsingBlock:^(NSMutableArray *bucket, NSUInteger bucketIndex, BOOL *stop) {
+        if (!bucket.count)
+            return;
+        [sectionTitles addObject:collationTitles[bucketIndex]];
+        [partitionedItems addObject:[bucket copy]];
+    }];
+
+    APPSCollatedSections *sections = [[APPSCollatedSections alloc] init];
+    sections.sectionTitles = sectionTitles;
+    sections.partitionedItems = partitionedItems;
+    return sections;
+}
+
+
+- (void)invalidateCollationKeyForItem:(id)item
+{
+    [_keysByItem removeObjectForKey:item];
+}
+
+
+- (void)invalidateAllCollationKeys
+{
+    [_keysByItem removeAllObjects];
+}
+
+
+
+#pragma mark - Helper
+
+/// The keys of items in order. The strings of items missing from the cache are fetched on the calling thread, since the string block needn't be thread-safe; only the sort keys are made concurrently, each chunk with its own collator. The new keys are then cached.
+- (NSArray<NSData *> *)collationKeysForItems:(NSArray *)items
+{
+    NSUInteger count = items.count;
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:count];
+    NSMutableIndexSet *missingIndexes = [NSMutableIndexSet indexSet];
+
+    for (NSUInteger index = 0; index < count; ++index) {
+        NSData *key = [_keysByItem objectForKey:items[index]];
+        if (!key)
+            [missingIndexes addIndex:index];
+        [keys addObject:key ?: [NSData data]];
+    }
+
+    NSUInteger missingCount = missingIndexes.count;
+    if (!missingCount)
+        return keys;
+
+    NSUInteger *indexes = malloc(missingCount * sizeof(NSUInteger));
+    [missingIndexes getIndexes:indexes maxCount:missingCount inIndexRange:NULL];
+
+    NSMutableArray<NSString *> *strings = [NSMutableArray arrayWithCapacity:missingCount];
+    for (NSUInteger position = 0; position < missingCount; ++position)
+        [strings addObject:self.stringBlock(items[indexes[position]]) ?: @""];
+
+    CFDataRef *sortKeys = calloc(missingCount, sizeof(CFDataRef));
+    NSUInteger chunkCount = MAX((NSUInteger)1, MIN([NSProcessInfo processInfo].activeProcessorCount * 4, missingCount / 256));
+    NSUInteger chunkLength = (missingCount + chunkCount - 1) / chunkCount;
+    NSLocale *locale = self.locale;
+
+    dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        UCollator *collator = APPSCollationOpenCollator(locale);
+        NSUInteger end = MIN((chunk + 1) * chunkLength, missingCount);
+        for (NSUInteger position = chunk * chunkLength; position < end; ++position) {
+            @autoreleasepool {
+                sortKeys[position] = (CFDataRef)CFBridgingRetain(APPSCollationSortKey(collator, strings[position]));
+            }
+        }
+        if (collator)
+            ucol_close(collator);
+    });
+
+    for (NSUInteger position = 0; position < missingCount; ++position) {
+        NSData *key = CFBridgingRelease(sortKeys[position]);
+        id item = items[indexes[position]];
+        keys[indexes[position]] = key;
+        [_keysByItem setObject:key forKey:item];
+    }
+
+    free(sortKeys);
+    free(indexes);
+    return keys;
+}
+
+@end
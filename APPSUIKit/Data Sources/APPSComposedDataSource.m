@@ -134,13 +134,43 @@
 }
 
 
-- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+- (void)appendSectionRoutesToArray:(NSMutableArray *)routes
 {
-    APPSDataSourceMapping *mapping = [self mappingForGlobalSection:indexPath.section];
+    for (APPSDataSourceMapping *mapping in _mappings)
+        [self appendSectionRoutesOfDataSource:mapping.dataSource toArray:routes];
+}
+
+
+/// The data source that answers for a global section, and the section there: the leaf from the route table, else the child from the mappings.
+- (APPSDataSource *)routedDataSourceForGlobalSection:(NSInteger)section localSection:(NSInteger *)localSection
+{
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:section];
+    if (route) {
+        *localSection = route.localSection;
+        return route.dataSource;
+    }
     
-    NSIndexPath *mappedIndexPath = [mapping localIndexPathForGlobalIndexPath:indexPath];
+    APPSDataSourceMapping *mapping = [self mappingForGlobalSection:section];
+    *localSection = [mapping localSectionForGlobalSection:section];
+    return mapping.dataSource;
+}
+
+
+- (APPSDataSource *)routedDataSourceForGlobalIndexPath:(NSIndexPath *)indexPath localIndexPath:(NSIndexPath **)localIndexPath
+{
+    NSInteger localSection;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalSection:indexPath.section localSection:&localSection];
+    *localIndexPath = [NSIndexPath indexPathForRow:indexPath.row inSection:localSection];
+    return dataSource;
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *localIndexPath;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalIndexPath:indexPath localIndexPath:&localIndexPath];
     
-    return [mapping.dataSource itemAtIndexPath:mappedIndexPath];
+    return [dataSource itemAtIndexPath:localIndexPath];
 }
 
 
@@ -288,6 +318,53 @@
 }
 
 
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self enumerateLocalIndexPathsForGlobalIndexPaths:indexPaths withBlock:^(APPSDataSource *dataSource, NSArray *localIndexPaths) {
+        [dataSource prefetchRowsAtIndexPaths:localIndexPaths];
+    }];
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self enumerateLocalIndexPathsForGlobalIndexPaths:indexPaths withBlock:^(APPSDataSource *dataSource, NSArray *localIndexPaths) {
+        [dataSource cancelPrefetchingForRowsAtIndexPaths:localIndexPaths];
+    }];
+}
+
+
+/// Partition global index paths by child data source, calling the block once per child with its sorted local index paths.
+- (void)enumerateLocalIndexPathsForGlobalIndexPaths:(NSArray<NSIndexPath *> *)indexPaths withBlock:(void(^)(APPSDataSource *dataSource, NSArray *localIndexPaths))block
+{
+    NSMapTable *localIndexPathsByMapping = [NSMapTable strongToStrongObjectsMapTable];
+    
+    for (NSIndexPath *globalIndexPath in indexPaths) {
+        APPSDataSourceMapping *mapping = [self mappingForGlobalSection:globalIndexPath.section];
+        NSIndexPath *localIndexPath = [mapping localIndexPathForGlobalIndexPath:globalIndexPath];
+        if (!localIndexPath)
+            continue;
+        
+        NSMutableArray *localIndexPaths = [localIndexPathsByMapping objectForKey:mapping];
+        if (!localIndexPaths) {
+            localIndexPaths = [NSMutableArray array];
+            [localIndexPathsByMapping setObject:localIndexPaths forKey:mapping];
+        }
+        [localIndexPaths addObject:localIndexPath];
+    }
+    
+    // Walk the mappings in order so children are asked in the order their rows appear.
+    for (APPSDataSourceMapping *mapping in _mappings) {
+        NSMutableArray *localIndexPaths = [localIndexPathsByMapping objectForKey:mapping];
+        if (!localIndexPaths)
+            continue;
+        
+        [localIndexPaths sortUsingSelector:@selector(compare:)];
+        block(mapping.dataSource, localIndexPaths);
+    }
+}
+
+
 - (void)registerReusableViewsWithTableView:(UITableView *)tableView
 {
 	[super registerReusableViewsWithTableView:tableView];
@@ -388,19 +465,27 @@
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
-	APPSDataSourceMapping *mapping = [self mappingForGlobalSection:indexPath.section];
-	APPSDataSource *dataSource = mapping.dataSource;
-	NSIndexPath *localIndexPath = [mapping localIndexPathForGlobalIndexPath:indexPath];
+    // Go straight to the leaf data source rather than walking every level of nesting for each cell.
+	NSIndexPath *localIndexPath;
+	APPSDataSource *dataSource = [self routedDataSourceForGlobalIndexPath:indexPath localIndexPath:&localIndexPath];
 	
 	return [dataSource tableView:tableView cellForRowAtIndexPath:localIndexPath];
 }
 
 
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *localIndexPath;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalIndexPath:indexPath localIndexPath:&localIndexPath];
+    
+    return [dataSource tableView:tableView reconfigureCell:cell forRowAtIndexPath:localIndexPath];
+}
+
+
 - (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section
 {
-	APPSDataSourceMapping *mapping = [self mappingForGlobalSection:section];
-	APPSDataSource *dataSource = mapping.dataSource;
-    NSUInteger localSection = [mapping localSectionForGlobalSection:section];
+    NSInteger localSection;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalSection:section localSection:&localSection];
 
     if ([dataSource respondsToSelector:@selector(tableView:titleForHeaderInSection:)]) {
         return [dataSource tableView:tableView titleForHeaderInSection:localSection];
@@ -412,9 +497,8 @@
 
 - (NSString *)tableView:(UITableView *)tableView titleForFooterInSection:(NSInteger)section
 {
-	APPSDataSourceMapping *mapping = [self mappingForGlobalSection:section];
-	APPSDataSource *dataSource = mapping.dataSource;
-    NSUInteger localSection = [mapping localSectionForGlobalSection:section];
+    NSInteger localSection;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalSection:section localSection:&localSection];
 
     if ([dataSource respondsToSelector:@selector(tableView:titleForFooterInSection:)]) {
         return [dataSource tableView:tableView titleForFooterInSection:localSection];
@@ -426,9 +510,8 @@
 
 - (BOOL)tableView:(UITableView *)tableView canEditRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    APPSDataSourceMapping *mapping = [self mappingForGlobalSection:indexPath.section];
-    APPSDataSource *dataSource = mapping.dataSource;
-    NSIndexPath *localIndexPath = [mapping localIndexPathForGlobalIndexPath:indexPath];
+    NSIndexPath *localIndexPath;
+    APPSDataSource *dataSource = [self routedDataSourceForGlobalIndexPath:indexPath localIndexPath:&localIndexPath];
     
     if ([dataSource respondsToSelector:@selector(tableView:canEditRowAtIndexPath:)]) {
         return[dataSource tableView:tableView canEditRowAtIndexPath:localIndexPath];
@@ -469,6 +552,15 @@
 }
 
 
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths
+{
+	APPSDataSourceMapping *mapping = [self mappingForDataSource:dataSource];
+	NSArray *globalIndexPaths = [mapping globalIndexPathsForLocalIndexPaths:indexPaths];
+	
+	[self notifyItemsReconfiguredAtIndexPaths:globalIndexPaths];
+}
+
+
 - (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath
 {
 	APPSDataSourceMapping *mapping = [self mappingForDataSource:dataSource];
@@ -550,6 +642,10 @@
 
 - (void)dataSource:(APPSDataSource *)dataSource didPresentActivityIndicatorForSections:(NSIndexSet *)sections
 {
+    // While we're loading, our activity indicator already covers every section, so another child starting to load changes nothing anyone can see.
+    if ([self.loadingState isEqualToString:APPSLoadStateLoadingContent] && self.showingActivityIndicatorPlaceholder)
+        return;
+    
     APPSDataSourceMapping *mapping = [self mappingForDataSource:dataSource];
     
     NSMutableIndexSet *globalSections = [NSMutableIndexSet indexSet];
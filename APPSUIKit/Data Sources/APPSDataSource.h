@@ -20,6 +20,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class APPSTextLayoutSpec;
+
 
 /**
  A general purpose placeholder class for representing the no content or error message placeholders in a data source.
@@ -89,7 +91,7 @@ NS_ASSUME_NONNULL_BEGIN
  }
  
  */
-@interface APPSDataSource : NSObject <UITableViewDataSource, APPSContentLoading>
+@interface APPSDataSource : NSObject <UITableViewDataSource, UITableViewDataSourcePrefetching, APPSContentLoading>
 
 - (instancetype)init NS_DESIGNATED_INITIALIZER;
 
@@ -139,6 +141,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)notifyItemsRefreshedAtIndexPaths:(NSArray *)refreshedIndexPaths;
 /// Alert parent data sources and the table view that the item at indexPath was moved to newIndexPath.
 - (void)notifyItemMovedFromIndexPath:(NSIndexPath *)indexPath toIndexPaths:(NSIndexPath *)newIndexPath;
+/// Notify parent data sources and the table view that the visible cells of the items at reconfiguredIndexPaths should be configured again in place, rather than reloaded. Unlike refreshes, the index paths are those after the update, and the cells are reconfigured once the batch update ends.
+- (void)notifyItemsReconfiguredAtIndexPaths:(NSArray *)reconfiguredIndexPaths;
 
 /// Notify parent data sources and the table view that the sections were inserted.
 - (void)notifySectionsInserted:(NSIndexSet *)sections;
@@ -167,6 +171,21 @@ NS_ASSUME_NONNULL_BEGIN
 /// Register reusable views needed by this data source
 - (void)registerReusableViewsWithTableView:(UITableView *)tableView NS_REQUIRES_SUPER;
 
+/// Called ahead of the rows at indexPaths being displayed, so the data source can warm images, faults or layouts. Container data sources hand each child one batch of its own local index paths, sorted in ascending order. The default implementation does nothing.
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths;
+
+/// Called when rows previously passed to -prefetchRowsAtIndexPaths: are no longer expected to be displayed. The default implementation does nothing.
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths;
+
+/// Return the text that determines the height of the cell for the item at indexPath, so the row height can be measured on a background queue. The default implementation returns nil, which leaves the row to self-sizing.
+- (nullable NSString *)heightDeterminingTextForItemAtIndexPath:(NSIndexPath *)indexPath;
+
+/// Return the text layout of the cell used for the item at indexPath, typically `[MyCell textLayoutSpec]`. The default implementation returns nil.
+- (nullable APPSTextLayoutSpec *)textLayoutSpecForItemAtIndexPath:(NSIndexPath *)indexPath;
+
+/// Configure cell, already on screen, for the item now at indexPath, without dequeuing another. Return NO when the cell can't be configured in place, and the row is reloaded instead. The default implementation returns NO.
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath;
+
 #pragma mark - Content loading
 
 /// Signal that the datasource SHOULD reload its content
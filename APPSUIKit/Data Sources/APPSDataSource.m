@@ -18,6 +18,7 @@
 #import "APPSLoadableContentPlaceholderView.h"
 #import <libkern/OSAtomic.h>
 #import <stdatomic.h>
+#import <objc/runtime.h>
 
 #if DEBUG
 static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecificKey";
@@ -61,6 +62,29 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
 @end
 
 
+@implementation APPSDataSourceSectionRoute
+
+- (instancetype)initWithDataSource:(APPSDataSource *)dataSource localSection:(NSInteger)localSection
+{
+    NSParameterAssert(dataSource != nil);
+    
+    self = [super init];
+    if (!self)
+        return nil;
+    
+    _dataSource = dataSource;
+    _localSection = localSection;
+    return self;
+}
+
+- (NSIndexPath *)localIndexPathForGlobalIndexPath:(NSIndexPath *)globalIndexPath
+{
+    return [NSIndexPath indexPathForItem:globalIndexPath.item inSection:_localSection];
+}
+
+@end
+
+
 @interface APPSLoadingProgress()
 @property (nonatomic, readwrite, getter = isCancelled) BOOL cancelled;
 @end
@@ -75,6 +99,8 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
 @property (nonatomic, weak) APPSLoadingProgress *loadingProgress;
 @property (nonatomic, copy) APPSDataSourcePlaceholder *placeholder;
 @property (nonatomic) BOOL resettingContent;
+/// Flattened table of section → (leaf data source, local section). Built lazily by -sectionRouteForGlobalSection:.
+@property (nonatomic, copy) NSArray *sectionRoutes;
 @end
 
 @implementation APPSDataSource
@@ -115,6 +141,87 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
 }
 
 
+static void APPSAppendOwnSectionRoutes(APPSDataSource *dataSource, NSMutableArray *routes)
+{
+    NSInteger numberOfSections = dataSource.numberOfSections;
+    for (NSInteger sectionIndex = 0; sectionIndex < numberOfSections; ++sectionIndex)
+        [routes addObject:[[APPSDataSourceSectionRoute alloc] initWithDataSource:dataSource localSection:sectionIndex]];
+}
+
+
+- (void)appendSectionRoutesToArray:(NSMutableArray *)routes
+{
+    APPSAppendOwnSectionRoutes(self, routes);
+}
+
+
+- (void)appendSectionRoutesOfDataSource:(APPSDataSource *)dataSource toArray:(NSMutableArray *)routes
+{
+    // A subclass that customises how its sections present has to be asked itself, so the routes end at it.
+    if ([dataSource.class overridesRoutedMethods])
+        APPSAppendOwnSectionRoutes(dataSource, routes);
+    else
+        [dataSource appendSectionRoutesToArray:routes];
+}
+
+
+/// Does this class override any method that routes skip, compared to the class that provides its -appendSectionRoutesToArray:? Leaf data sources always do, which ends the routes at them as usual.
++ (BOOL)overridesRoutedMethods
+{
+    // Find the class the routing comes from, such as APPSComposedDataSource for a subclass of it.
+    SEL appendSelector = @selector(appendSectionRoutesToArray:);
+    Class routingClass = self;
+    while (class_getSuperclass(routingClass) && [class_getSuperclass(routingClass) instanceMethodForSelector:appendSelector] == [routingClass instanceMethodForSelector:appendSelector])
+        routingClass = class_getSuperclass(routingClass);
+    
+    if (routingClass == [APPSDataSource class])
+        return YES;
+    
+    SEL routedSelectors[] = {
+        @selector(itemAtIndexPath:),
+        @selector(tableView:cellForRowAtIndexPath:),
+        @selector(tableView:titleForHeaderInSection:),
+        @selector(tableView:titleForFooterInSection:),
+        @selector(tableView:canEditRowAtIndexPath:),
+        @selector(heightDeterminingTextForItemAtIndexPath:),
+        @selector(textLayoutSpecForItemAtIndexPath:),
+        @selector(tableView:reconfigureCell:forRowAtIndexPath:),
+    };
+    for (size_t index = 0; index < sizeof(routedSelectors) / sizeof(routedSelectors[0]); ++index) {
+        if ([self instanceMethodForSelector:routedSelectors[index]] != [routingClass instanceMethodForSelector:routedSelectors[index]])
+            return YES;
+    }
+    return NO;
+}
+
+
+- (APPSDataSourceSectionRoute *)sectionRouteForGlobalSection:(NSInteger)sectionIndex
+{
+    NSArray *sectionRoutes = _sectionRoutes;
+    if (!sectionRoutes) {
+        NSMutableArray *routes = [NSMutableArray array];
+        [self appendSectionRoutesToArray:routes];
+        sectionRoutes = [routes copy];
+        _sectionRoutes = sectionRoutes;
+    }
+    
+    if (sectionIndex < 0 || sectionIndex >= (NSInteger)sectionRoutes.count)
+        return nil;
+    return sectionRoutes[sectionIndex];
+}
+
+
+- (void)invalidateSectionRoutes
+{
+    _sectionRoutes = nil;
+    
+    // Parent data sources have flattened our routes into theirs.
+    id delegate = self.delegate;
+    if ([delegate isKindOfClass:[APPSDataSource class]])
+        [(APPSDataSource *)delegate invalidateSectionRoutes];
+}
+
+
 - (NSArray *)indexPathsForItem:(id)object
 {
 	NSAssert(NO, @"Should be implemented by subclasses");
@@ -153,6 +260,28 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
 }
 
 
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+}
+
+
+- (NSString *)heightDeterminingTextForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    return nil;
+}
+
+
+- (APPSTextLayoutSpec *)textLayoutSpecForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    return nil;
+}
+
+
 
 #pragma mark - Protocol: APPSContentLoading
 
@@ -369,6 +498,11 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
     return self.placeholder ? YES : NO;
 }
 
+- (BOOL)isShowingActivityIndicatorPlaceholder
+{
+    return self.placeholder.activityIndicator;
+}
+
 - (void)presentActivityIndicatorForSections:(NSIndexSet *)sections
 {
     id<APPSDataSourceDelegate> delegate = self.delegate;
@@ -458,13 +592,22 @@ static void *APPSPerformUpdateQueueSpecificKey = "APPSPerformUpdateQueueSpecific
 
 - (APPSTablePlaceholderView *)dequeuePlaceholderViewForTableView:(UITableView *)tableView
 {
-    APPSTablePlaceholderView *placeholderView = (APPSTablePlaceholderView*)[tableView viewWithTag:APPSDataSourcePlaceholderTag];
-    if (!placeholderView) {
+    APPS_ASSERT_MAIN_THREAD;
+
+    // Table view → its placeholder view, shared by every data source that shows in it. Both weak: the table view keeps the placeholder as a subview.
+    static NSMapTable *placeholderViewsByTableView;
+    if (!placeholderViewsByTableView)
+        placeholderViewsByTableView = [NSMapTable weakToWeakObjectsMapTable];
+
+    // Look the placeholder up directly, rather than searching the table's subviews for its tag
+    APPSTablePlaceholderView *placeholderView = [placeholderViewsByTableView objectForKey:tableView];
+    if (placeholderView.superview != tableView) {
         placeholderView = [[APPSTablePlaceholderView alloc] initWithFrame:tableView.bounds];
         placeholderView.tag = APPSDataSourcePlaceholderTag;
         placeholderView.userInteractionEnabled = NO;
         placeholderView.autoresizingMask = UIViewAutoresizingFlexibleHeight | UIViewAutoresizingFlexibleWidth;
         [tableView addSubview:placeholderView];
+        [placeholderViewsByTableView setObject:placeholderView forKey:tableView];
     }
     return placeholderView;
 }
@@ -622,6 +765,16 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 }
 
 
+- (void)notifyItemsReconfiguredAtIndexPaths:(NSArray *)reconfiguredIndexPaths
+{
+    APPS_ASSERT_MAIN_THREAD;
+    id<APPSDataSourceDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(dataSource:didReconfigureItemsAtIndexPaths:)]) {
+        [delegate dataSource:self didReconfigureItemsAtIndexPaths:reconfiguredIndexPaths];
+    }
+}
+
+
 - (void)notifyItemMovedFromIndexPath:(NSIndexPath *)indexPath toIndexPaths:(NSIndexPath *)newIndexPath
 {
     APPS_ASSERT_MAIN_THREAD;
@@ -635,6 +788,7 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 - (void)notifySectionsInserted:(NSIndexSet *)sections
 {
 	APPS_ASSERT_MAIN_THREAD;
+	[self invalidateSectionRoutes];
 	
 	id<APPSDataSourceDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(dataSource:didInsertSections:)]) {
@@ -646,6 +800,7 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 - (void)notifySectionsRemoved:(NSIndexSet *)sections
 {
 	APPS_ASSERT_MAIN_THREAD;
+	[self invalidateSectionRoutes];
 	
 	id<APPSDataSourceDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(dataSource:didRemoveSections:)]) {
@@ -657,6 +812,7 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 - (void)notifySectionsRefreshed:(NSIndexSet *)sections
 {
 	APPS_ASSERT_MAIN_THREAD;
+	[self invalidateSectionRoutes];
 	
 	id<APPSDataSourceDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(dataSource:didRefreshSections:)]) {
@@ -667,6 +823,7 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 - (void)notifySectionMovedFrom:(NSInteger)section to:(NSInteger)newSection
 {
 	APPS_ASSERT_MAIN_THREAD;
+	[self invalidateSectionRoutes];
 	
 	id<APPSDataSourceDelegate> delegate = self.delegate;
 	if ([delegate respondsToSelector:@selector(dataSource:didMoveSection:toSection:)]) {
@@ -678,6 +835,7 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 - (void)notifyDidReloadData
 {
     APPS_ASSERT_MAIN_THREAD;
+    [self invalidateSectionRoutes];
     
     id<APPSDataSourceDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(dataSourceDidReloadData:)]) {
@@ -717,6 +875,9 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
 {
+    // The table view always asks for its sections again after a reload or batch update, so resolve the routes afresh from here on.
+    if (self.isRootDataSource)
+        [self invalidateSectionRoutes];
     return self.numberOfSections;
 }
 
@@ -736,6 +897,27 @@ BOOL APPSInDataSourceUpdate(APPSDataSource *dataSource)
 }
 
 
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    return NO;
+}
+
+
+
+#pragma mark - Protocol: UITableViewDataSourcePrefetching
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self prefetchRowsAtIndexPaths:indexPaths];
+}
+
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self cancelPrefetchingForRowsAtIndexPaths:indexPaths];
+}
+
+
 
 #pragma mark - Debugging Support
 
@@ -0,0 +1,60 @@
+//
+//  APPSDataSourceDiff.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class APPSDataSource;
+
+/**
+ The item diff engine used by the data sources. Computes the removals, insertions and moves required to transform one array of items into another, matching items by identity (-isEqual:).
+
+ When every item adopts APPSIdentifiable, items are matched by identifier instead, and items whose content hash changed are reported as well. A changed item that keeps its place among its neighbours is refreshed at its old index, even when insertions and removals around it shift that index; a changed item that also moves relative to them is removed and inserted, because a table view can't reload and move the same row in one batch.
+
+ Removed and moved-from indexes are expressed in the coordinates of the old items; inserted and moved-to indexes are expressed in the coordinates of the new items. This matches what UITableView expects inside a batch update.
+ */
+@interface APPSDataSourceDiff : NSObject
+
+/// Compute the diff between two arrays of items. Returns nil when either array contains the same item more than once, because a diff by identity can't describe that change.
++ (nullable instancetype)diffFromItems:(NSArray *)oldItems toItems:(NSArray *)newItems;
+
+/// Compute the diff between two arrays of items, comparing the new content hashes of APPSIdentifiable items against previousContentHashes. Use this when items are mutated in place, since the old items then report their new hash. Identifiers missing from previousContentHashes fall back to the old item's hash.
++ (nullable instancetype)diffFromItems:(NSArray *)oldItems toItems:(NSArray *)newItems previousContentHashes:(nullable NSDictionary<id, NSNumber *> *)previousContentHashes;
+
+/// Identifier → content hash for items that all adopt APPSIdentifiable, or nil when any item doesn't.
++ (nullable NSDictionary<id, NSNumber *> *)contentHashesForItems:(NSArray *)items;
+
+/// Indexes of items in the old array that are not in the new array.
+@property (nonatomic, readonly) NSIndexSet *removedIndexes;
+
+/// Indexes of items in the new array that were not in the old array.
+@property (nonatomic, readonly) NSIndexSet *insertedIndexes;
+
+/// Indexes, in the old array, of identifiable items whose content changed but whose place among their neighbours did not.
+@property (nonatomic, readonly) NSIndexSet *refreshedIndexes;
+
+/// The number of items present in both arrays whose index changed.
+@property (nonatomic, readonly) NSUInteger numberOfMoves;
+
+/// Are there any removals, insertions, refreshes or moves?
+@property (nonatomic, readonly) BOOL hasChanges;
+
+/// Call the block once for each item present in both arrays whose index changed.
+- (void)enumerateMovesUsingBlock:(void(^)(NSUInteger fromIndex, NSUInteger toIndex))block;
+
+/// Call the block once for each unchanged item present in both arrays that changes order relative to the others, those outside a longest run of items whose new indexes increase with their old ones. Moving only these, a table view shifts the rest into place with the insertions and removals, and the refreshed items stay unmoved.
+- (void)enumerateReorderingMovesUsingBlock:(void(^)(NSUInteger fromIndex, NSUInteger toIndex))block;
+
+/// Send the notifications describing this diff for the given section of the data source. Must be called within an update block.
+- (void)notifyDataSource:(APPSDataSource *)dataSource section:(NSInteger)sectionIndex;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,306 @@
+//
+//  APPSDataSourceDiff.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSourceDiff.h"
+#import "APPSDataSource.h"
+#import "APPSIdentifiable.h"
+
+typedef struct {
+    NSUInteger fromIndex;
+    NSUInteger toIndex;
+} APPSDataSourceDiffMove;
+
+/// Positions, among count values, of a longest strictly increasing run of them, found by patience sorting.
+static NSIndexSet *APPSLongestIncreasingSubsequence(const NSUInteger *values, NSUInteger count)
+{
+    NSUInteger *tails = malloc(count * sizeof(NSUInteger));
+    NSUInteger *previous = malloc(count * sizeof(NSUInteger));
+    NSUInteger length = 0;
+
+    for (NSUInteger position = 0; position < count; ++position) {
+        // tails[i] is the position ending the smallest-valued increasing run of length i + 1 so far.
+        NSUInteger low = 0;
+        NSUInteger high = length;
+        while (low < high) {
+            NSUInteger middle = low + (high - low) / 2;
+            if (values[tails[middle]] < values[position])
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        previous[position] = low ? tails[low - 1] : NSNotFound;
+        tails[low] = position;
+        if (low == length)
+            ++length;
+    }
+
+    NSMutableIndexSet *positions = [NSMutableIndexSet indexSet];
+    for (NSUInteger position = length ? tails[length - 1] : NSNotFound; position != NSNotFound; position = previous[position])
+        [positions addIndex:position];
+
+    free(tails);
+    free(previous);
+    return positions;
+}
+
+
+@interface APPSDataSourceDiff ()
+@property (nonatomic, readwrite) NSIndexSet *removedIndexes;
+@property (nonatomic, readwrite) NSIndexSet *insertedIndexes;
+@property (nonatomic, readwrite) NSIndexSet *refreshedIndexes;
+@property (nonatomic, strong) NSMutableData *moves;
+/// The moves of just the unchanged items that change order relative to the others.
+@property (nonatomic, strong) NSMutableData *reorderingMoves;
+@end
+
+@implementation APPSDataSourceDiff
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithRemovedIndexes:(NSIndexSet *)removedIndexes insertedIndexes:(NSIndexSet *)insertedIndexes refreshedIndexes:(NSIndexSet *)refreshedIndexes moves:(NSMutableData *)moves reorderingMoves:(NSMutableData *)reorderingMoves
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _removedIndexes = [removedIndexes copy];
+    _insertedIndexes = [insertedIndexes copy];
+    _refreshedIndexes = [refreshedIndexes copy];
+    _moves = moves;
+    _reorderingMoves = reorderingMoves;
+    return self;
+}
+
+
++ (instancetype)diffFromItems:(NSArray *)oldItems toItems:(NSArray *)newItems
+{
+    return [self diffFromItems:oldItems toItems:newItems previousContentHashes:nil];
+}
+
+
++ (instancetype)diffFromItems:(NSArray *)oldItems toItems:(NSArray *)newItems previousContentHashes:(NSDictionary<id, NSNumber *> *)previousContentHashes
+{
+    // Identifiable items are matched by identifier, so an item whose content changed is still recognised as the same item.
+    BOOL identifiable = [self itemsAreIdentifiable:oldItems] && [self itemsAreIdentifiable:newItems];
+    NSArray *oldKeys = identifiable ? [self identifiersForItems:oldItems] : oldItems;
+    NSArray *newKeys = identifiable ? [self identifiersForItems:newItems] : newItems;
+
+    NSOrderedSet *oldItemSet = [NSOrderedSet orderedSetWithArray:oldKeys];
+    NSOrderedSet *newItemSet = [NSOrderedSet orderedSetWithArray:newKeys];
+
+    // Duplicates collapse in the ordered sets, so the resulting indexes would not line up with the arrays.
+    if (oldItemSet.count != oldItems.count || newItemSet.count != newItems.count)
+        return nil;
+
+    NSMutableIndexSet *removedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *insertedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *refreshedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableData *moves = [NSMutableData data];
+
+    // Where each old item went, if it stayed; the unchanged items left at their index; and the changed items, as (oldIndex, newIndex).
+    NSMutableData *newIndexesByOldIndex = [NSMutableData dataWithLength:oldItems.count * sizeof(NSUInteger)];
+    NSMutableIndexSet *stationaryIndexes = [NSMutableIndexSet indexSet];
+    NSMutableData *changes = [NSMutableData data];
+
+    [oldItemSet enumerateObjectsUsingBlock:^(id oldItem, NSUInteger oldIndex, BOOL *stop) {
+        if (![newItemSet containsObject:oldItem])
+            [removedIndexes addIndex:oldIndex];
+    }];
+
+    [newItemSet enumerateObjectsUsingBlock:^(id newItem, NSUInteger newIndex, BOOL *stop) {
+        NSUInteger oldIndex = [oldItemSet indexOfObject:newItem];
+        if (NSNotFound == oldIndex) {
+            [insertedIndexes addIndex:newIndex];
+            return;
+        }
+
+        ((NSUInteger *)newIndexesByOldIndex.mutableBytes)[oldIndex] = newIndex;
+
+        if (identifiable) {
+            NSNumber *previousHash = previousContentHashes[newItem];
+            NSUInteger oldHash = previousHash ? previousHash.unsignedIntegerValue : [oldItems[oldIndex] contentHash];
+            if (oldHash != [newItems[newIndex] contentHash]) {
+                APPSDataSourceDiffMove change = { oldIndex, newIndex };
+                [changes appendBytes:&change length:sizeof(change)];
+                return;
+            }
+        }
+
+        if (oldIndex != newIndex) {
+            APPSDataSourceDiffMove move = { oldIndex, newIndex };
+            [moves appendBytes:&move length:sizeof(move)];
+        }
+        else {
+            [stationaryIndexes addIndex:oldIndex];
+        }
+    }];
+
+    NSIndexSet *inOrderIndexes = [self inOrderIndexesOfNewIndexesByOldIndex:newIndexesByOldIndex removedIndexes:removedIndexes];
+    NSMutableData *reorderingMoves = [self reorderingMovesOfMoves:moves stationaryIndexes:stationaryIndexes inOrderIndexes:inOrderIndexes];
+
+    [self sortChanges:changes inOrderIndexes:inOrderIndexes stationaryIndexes:stationaryIndexes intoRefreshedIndexes:refreshedIndexes removedIndexes:removedIndexes insertedIndexes:insertedIndexes];
+
+    return [[self alloc] initWithRemovedIndexes:removedIndexes insertedIndexes:insertedIndexes refreshedIndexes:refreshedIndexes moves:moves reorderingMoves:reorderingMoves];
+}
+
+
++ (NSDictionary<id, NSNumber *> *)contentHashesForItems:(NSArray *)items
+{
+    if (![self itemsAreIdentifiable:items])
+        return nil;
+
+    NSMutableDictionary *contentHashes = [NSMutableDictionary dictionaryWithCapacity:items.count];
+    for (id<APPSIdentifiable> item in items)
+        contentHashes[item.itemIdentifier] = @(item.contentHash);
+    return contentHashes;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSUInteger)numberOfMoves
+{
+    return _moves.length / sizeof(APPSDataSourceDiffMove);
+}
+
+
+- (BOOL)hasChanges
+{
+    return _removedIndexes.count || _insertedIndexes.count || _refreshedIndexes.count || self.numberOfMoves;
+}
+
+
+- (void)enumerateMovesUsingBlock:(void (^)(NSUInteger, NSUInteger))block
+{
+    NSParameterAssert(block != nil);
+
+    const APPSDataSourceDiffMove *moves = _moves.bytes;
+    NSUInteger numberOfMoves = self.numberOfMoves;
+    for (NSUInteger moveIndex = 0; moveIndex < numberOfMoves; ++moveIndex)
+        block(moves[moveIndex].fromIndex, moves[moveIndex].toIndex);
+}
+
+
+- (void)enumerateReorderingMovesUsingBlock:(void (^)(NSUInteger, NSUInteger))block
+{
+    NSParameterAssert(block != nil);
+
+    const APPSDataSourceDiffMove *moves = _reorderingMoves.bytes;
+    NSUInteger numberOfMoves = _reorderingMoves.length / sizeof(APPSDataSourceDiffMove);
+    for (NSUInteger moveIndex = 0; moveIndex < numberOfMoves; ++moveIndex)
+        block(moves[moveIndex].fromIndex, moves[moveIndex].toIndex);
+}
+
+
+- (void)notifyDataSource:(APPSDataSource *)dataSource section:(NSInteger)sectionIndex
+{
+    if (_removedIndexes.count)
+        [dataSource notifyItemsRemovedAtIndexPaths:[self indexPathsForIndexes:_removedIndexes section:sectionIndex]];
+
+    if (_insertedIndexes.count)
+        [dataSource notifyItemsInsertedAtIndexPaths:[self indexPathsForIndexes:_insertedIndexes section:sectionIndex]];
+
+    if (_refreshedIndexes.count)
+        [dataSource notifyItemsRefreshedAtIndexPaths:[self indexPathsForIndexes:_refreshedIndexes section:sectionIndex]];
+
+    [self enumerateMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+        [dataSource notifyItemMovedFromIndexPath:[NSIndexPath indexPathForItem:fromIndex inSection:sectionIndex] toIndexPaths:[NSIndexPath indexPathForItem:toIndex inSection:sectionIndex]];
+    }];
+}
+
+
+
+#pragma mark - Helper
+
+/// Old indexes of a longest run of the remaining items whose new indexes increase with their old ones. These keep their place among their neighbours.
++ (NSIndexSet *)inOrderIndexesOfNewIndexesByOldIndex:(NSData *)newIndexesByOldIndex removedIndexes:(NSIndexSet *)removedIndexes
+{
+    // The new indexes of the remaining items, in old order, and which old index each came from.
+    NSUInteger numberOfOldItems = newIndexesByOldIndex.length / sizeof(NSUInteger);
+    const NSUInteger *newIndexesByOld = newIndexesByOldIndex.bytes;
+    NSMutableData *newIndexes = [NSMutableData dataWithCapacity:numberOfOldItems * sizeof(NSUInteger)];
+    NSMutableData *oldIndexes = [NSMutableData dataWithCapacity:numberOfOldItems * sizeof(NSUInteger)];
+    for (NSUInteger oldIndex = 0; oldIndex < numberOfOldItems; ++oldIndex) {
+        if ([removedIndexes containsIndex:oldIndex])
+            continue;
+
+        [newIndexes appendBytes:&newIndexesByOld[oldIndex] length:sizeof(NSUInteger)];
+        [oldIndexes appendBytes:&oldIndex length:sizeof(NSUInteger)];
+    }
+
+    const NSUInteger *oldIndexesByPosition = oldIndexes.bytes;
+    NSMutableIndexSet *inOrderIndexes = [NSMutableIndexSet indexSet];
+    [APPSLongestIncreasingSubsequence(newIndexes.bytes, newIndexes.length / sizeof(NSUInteger)) enumerateIndexesUsingBlock:^(NSUInteger position, BOOL *stop) {
+        [inOrderIndexes addIndex:oldIndexesByPosition[position]];
+    }];
+    return inOrderIndexes;
+}
+
+
+/// The unchanged items outside the in-order run, whether their index changed or not: moving just these, the insertions and removals shift the rest into place.
++ (NSMutableData *)reorderingMovesOfMoves:(NSData *)moves stationaryIndexes:(NSIndexSet *)stationaryIndexes inOrderIndexes:(NSIndexSet *)inOrderIndexes
+{
+    NSMutableData *reorderingMoves = [NSMutableData data];
+
+    const APPSDataSourceDiffMove *allMoves = moves.bytes;
+    NSUInteger numberOfMoves = moves.length / sizeof(APPSDataSourceDiffMove);
+    for (NSUInteger moveIndex = 0; moveIndex < numberOfMoves; ++moveIndex) {
+        if (![inOrderIndexes containsIndex:allMoves[moveIndex].fromIndex])
+            [reorderingMoves appendBytes:&allMoves[moveIndex] length:sizeof(APPSDataSourceDiffMove)];
+    }
+
+    [stationaryIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if ([inOrderIndexes containsIndex:index])
+            return;
+
+        APPSDataSourceDiffMove move = { index, index };
+        [reorderingMoves appendBytes:&move length:sizeof(move)];
+    }];
+
+    return reorderingMoves;
+}
+
+
+/**
+ A changed item is refreshed at its old index when it keeps its place among its neighbours, with the insertions and removals around it shifting it: when it's in a longest run of remaining items whose new indexes increase with their old ones, and doesn't cross an item that's left where it was. Any other changed item also moves, and since a table view can't reload and move the same row in one batch, it's removed and inserted.
+ */
++ (void)sortChanges:(NSData *)changes inOrderIndexes:(NSIndexSet *)inOrderIndexes stationaryIndexes:(NSIndexSet *)stationaryIndexes intoRefreshedIndexes:(NSMutableIndexSet *)refreshedIndexes removedIndexes:(NSMutableIndexSet *)removedIndexes insertedIndexes:(NSMutableIndexSet *)insertedIndexes
+{
+    NSUInteger numberOfChanges = changes.length / sizeof(APPSDataSourceDiffMove);
+    if (!numberOfChanges)
+        return;
+
+    const APPSDataSourceDiffMove *changed = changes.bytes;
+    for (NSUInteger changeIndex = 0; changeIndex < numberOfChanges; ++changeIndex) {
+        APPSDataSourceDiffMove change = changed[changeIndex];
+        NSUInteger low = MIN(change.fromIndex, change.toIndex);
+        BOOL crossesStationaryItem = [stationaryIndexes countOfIndexesInRange:NSMakeRange(low, MAX(change.fromIndex, change.toIndex) - low + 1)] > 0;
+
+        if ([inOrderIndexes containsIndex:change.fromIndex] && !crossesStationaryItem) {
+            [refreshedIndexes addIndex:change.fromIndex];
+        }
+        else {
+            [removedIndexes addIndex:change.fromIndex];
+            [insertedIndexes addIndex:change.toIndex];
+        }
+    }
+}
+
+
+- (NSArray *)indexPathsForIndexes:(NSIndexSet *)indexes section:(NSInteger)sectionIndex
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForItem:idx inSection:sectionIndex]];
+    }];
+    return indexPaths;
+}
+
+@end
@@ -41,6 +41,24 @@ enum {
 
 
 
+/// A resolved route from a global section to the leaf data source that owns it.
+@interface APPSDataSourceSectionRoute : NSObject
+
+- (instancetype)initWithDataSource:(APPSDataSource *)dataSource localSection:(NSInteger)localSection NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The leaf data source that owns the section.
+@property (nonatomic, strong, readonly) APPSDataSource *dataSource;
+/// The section index within the leaf data source.
+@property (nonatomic, readonly) NSInteger localSection;
+
+/// Return the leaf index path for a global index path in the routed section.
+- (NSIndexPath *)localIndexPathForGlobalIndexPath:(NSIndexPath *)globalIndexPath;
+
+@end
+
+
+
 @interface APPSDataSource ()
 
 /// Create an instance of the placeholder view for this data source.
@@ -71,6 +89,9 @@ enum {
 /// Dismiss a placeholder or activity indicator
 - (void)dismissPlaceholderForSections:(nullable NSIndexSet *)sections;
 
+/// Is the placeholder covering this whole data source currently an activity indicator?
+@property (nonatomic, readonly, getter = isShowingActivityIndicatorPlaceholder) BOOL showingActivityIndicatorPlaceholder;
+
 /// Update the placeholder view for a given section.
 - (void)updatePlaceholderView:(APPSTablePlaceholderView *)placeholderView forSectionAtIndex:(NSInteger)sectionIndex;
 
@@ -82,6 +103,18 @@ enum {
 /// Get an index path for the data source represented by the global index path. This works with -dataSourceForSectionAtIndex:.
 - (NSIndexPath *)localIndexPathForGlobalIndexPath:(NSIndexPath *)globalIndexPath;
 
+/// Append one route per section of this data source, resolved down to leaf data sources. Container data sources override this to append the routes of their children in section order.
+- (void)appendSectionRoutesToArray:(NSMutableArray *)routes;
+
+/// Append the routes of a child data source. Containers call this for each child rather than asking the child directly, so that a child whose class overrides cell, title, editing or item methods ends the routes at itself instead of being skipped.
+- (void)appendSectionRoutesOfDataSource:(APPSDataSource *)dataSource toArray:(NSMutableArray *)routes;
+
+/// Find the leaf route for a global section, regardless of how deeply the data sources are nested. The flattened route table is built lazily and discarded by section-level notifications. Returns nil when the section is out of range.
+- (nullable APPSDataSourceSectionRoute *)sectionRouteForGlobalSection:(NSInteger)sectionIndex;
+
+/// Discard the resolved section routes of this data source and its parents. Call this when the sections of this data source change without a section-level notification.
+- (void)invalidateSectionRoutes;
+
 /// Is this data source the root data source? This depends on proper set up of the delegate property. Container data sources ALWAYS act as the delegate for their contained data sources.
 @property (nonatomic, readonly, getter = isRootDataSource) BOOL rootDataSource;
 
@@ -110,6 +143,8 @@ enum {
 - (void)dataSource:(APPSDataSource *)dataSource didRemoveItemsAtIndexPaths:(NSArray *)indexPaths;
 - (void)dataSource:(APPSDataSource *)dataSource didRefreshItemsAtIndexPaths:(NSArray *)indexPaths;
 - (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath;
+/// The index paths are those after the update.
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths;
 
 - (void)dataSource:(APPSDataSource *)dataSource didInsertSections:(NSIndexSet *)sections;
 - (void)dataSource:(APPSDataSource *)dataSource didRemoveSections:(NSIndexSet *)sections;
@@ -0,0 +1,53 @@
+//
+//  APPSFilteredDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Return YES when item matches query. Called on a background queue, so it must only read thread-safe state of the item.
+typedef BOOL (^APPSFilteredDataSourceMatchingBlock)(id item, NSString *query);
+
+
+/**
+ A data source that presents the items of another data source that match a search query.
+
+ The wrapped data source keeps its sections and continues to provide the cells; this data source only hides the rows that don't match. Filtering runs on a background queue. When a query extends the previously applied one (for example "app" after "ap"), only the previously matching rows are re-examined. Queries that are superseded before they finish are cancelled. The result is applied as item removals and insertions through the normal notification methods, so only the rows that changed animate.
+
+ Item changes made to the wrapped data source are reflected immediately, using the current query; only the touched rows are matched. When the wrapped data source reloads or refreshes whole sections while a query is applied, those sections show no rows until they have been filtered in the background.
+ */
+@interface APPSFilteredDataSource : APPSDataSource
+
+/// Create a filtered data source over dataSource. The matching block must satisfy the narrowing rule: if an item matches a query, it also matches every prefix of that query.
+- (instancetype)initWithDataSource:(APPSDataSource *)dataSource matchingBlock:(APPSFilteredDataSourceMatchingBlock)matchingBlock NS_DESIGNATED_INITIALIZER;
+
+/// Create a filtered data source matching items whose string value at keyPath contains the query, ignoring case and diacritics.
++ (instancetype)filteredDataSourceWithDataSource:(APPSDataSource *)dataSource keyPath:(NSString *)keyPath;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The wrapped data source.
+@property (nonatomic, strong, readonly) APPSDataSource *dataSource;
+
+/// The most recently requested query. Setting this begins filtering in the background. A nil or empty query shows every item.
+@property (nullable, nonatomic, copy) NSString *query;
+
+/// Set the query, calling completion on the main thread once its result has been applied. The completion is not called if the query is superseded.
+- (void)setQuery:(nullable NSString *)query completion:(nullable dispatch_block_t)completion;
+
+/// Is a query being filtered in the background?
+@property (nonatomic, readonly, getter = isFiltering) BOOL filtering;
+
+/// Should a query that extends the applied query only re-examine the rows that currently match? Set to NO when the matching block doesn't satisfy the narrowing rule. Default is YES.
+@property (nonatomic) BOOL narrowsExtendedQueries;
+
+/// When a result changes more rows than this in a section, the section is refreshed instead of animating each row. Default is 500.
+@property (nonatomic) NSUInteger maximumAnimatedChanges;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,925 @@
+//
+//  APPSFilteredDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource_Private.h"
+#import "APPSFilteredDataSource.h"
+#import "APPSBasicDataSource.h"
+
+/// How many items are examined between checks for cancellation.
+static const NSUInteger APPSFilteredDataSourceCancellationInterval = 1024;
+
+/// The position of the first row in rows that is not less than value.
+static NSUInteger APPSFilteredRowsLowerBound(const NSUInteger *rows, NSUInteger count, NSUInteger value)
+{
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (rows[middle] < value)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+
+/// Every row of a section with count rows, for when there's no query to filter by.
+static NSData *APPSFilteredAllRows(NSUInteger count)
+{
+    NSMutableData *rows = [NSMutableData dataWithLength:count * sizeof(NSUInteger)];
+    NSUInteger *bytes = rows.mutableBytes;
+    for (NSUInteger row = 0; row < count; ++row)
+        bytes[row] = row;
+    return rows;
+}
+
+
+/// rows after the wrapped rows in removedRows (old coordinates) are removed: those are dropped and the rest shift down. The positions of the dropped rows are added to removedPositions.
+static NSData *APPSFilteredRowsByRemovingRows(NSData *rows, NSIndexSet *removedRows, NSMutableIndexSet *removedPositions)
+{
+    const NSUInteger *bytes = rows.bytes;
+    NSUInteger count = rows.length / sizeof(NSUInteger);
+    NSMutableData *result = [NSMutableData dataWithCapacity:rows.length];
+    NSUInteger removedRow = removedRows.firstIndex;
+    NSUInteger removedBefore = 0;
+
+    for (NSUInteger position = 0; position < count; ++position) {
+        NSUInteger row = bytes[position];
+        for (; removedRow < row; removedRow = [removedRows indexGreaterThanIndex:removedRow])
+            ++removedBefore;
+
+        if (removedRow == row) {
+            [removedPositions addIndex:position];
+            continue;
+        }
+
+        row -= removedBefore;
+        [result appendBytes:&row length:sizeof(NSUInteger)];
+    }
+    return result;
+}
+
+
+/// rows after the wrapped rows in insertedRows (new coordinates) are inserted: the rest shift up, and those in matchingRows join them. The positions they take are added to insertedPositions.
+static NSData *APPSFilteredRowsByInsertingRows(NSData *rows, NSIndexSet *insertedRows, NSIndexSet *matchingRows, NSMutableIndexSet *insertedPositions)
+{
+    const NSUInteger *bytes = rows.bytes;
+    NSUInteger count = rows.length / sizeof(NSUInteger);
+    NSMutableData *result = [NSMutableData dataWithCapacity:rows.length + matchingRows.count * sizeof(NSUInteger)];
+    NSUInteger insertedRow = insertedRows.firstIndex;
+    NSUInteger insertedBefore = 0;
+
+    for (NSUInteger position = 0; position <= count; ++position) {
+        // Insertions are in final coordinates, so one lands ahead of a row when it takes that row's final slot or an earlier one.
+        NSUInteger row = position < count ? bytes[position] + insertedBefore : NSNotFound;
+        for (; insertedRow <= row && insertedRow != NSNotFound; insertedRow = [insertedRows indexGreaterThanIndex:insertedRow]) {
+            if ([matchingRows containsIndex:insertedRow]) {
+                [insertedPositions addIndex:result.length / sizeof(NSUInteger)];
+                [result appendBytes:&insertedRow length:sizeof(NSUInteger)];
+            }
+            ++insertedBefore;
+            if (row != NSNotFound)
+                ++row;
+        }
+
+        if (row != NSNotFound)
+            [result appendBytes:&row length:sizeof(NSUInteger)];
+    }
+    return result;
+}
+
+
+/// rows with droppedRows taken out and addedRows merged in, without shifting any other row. The positions of the dropped rows (before) and the added ones (after) are collected.
+static NSData *APPSFilteredRowsByReplacingRows(NSData *rows, NSIndexSet *droppedRows, NSIndexSet *addedRows, NSMutableIndexSet *removedPositions, NSMutableIndexSet *insertedPositions)
+{
+    const NSUInteger *bytes = rows.bytes;
+    NSUInteger count = rows.length / sizeof(NSUInteger);
+    NSMutableData *result = [NSMutableData dataWithCapacity:rows.length + addedRows.count * sizeof(NSUInteger)];
+    NSUInteger addedRow = addedRows.firstIndex;
+
+    for (NSUInteger position = 0; position <= count; ++position) {
+        NSUInteger row = position < count ? bytes[position] : NSNotFound;
+        for (; addedRow < row; addedRow = [addedRows indexGreaterThanIndex:addedRow]) {
+            [insertedPositions addIndex:result.length / sizeof(NSUInteger)];
+            [result appendBytes:&addedRow length:sizeof(NSUInteger)];
+        }
+
+        if (row == NSNotFound)
+            break;
+        if ([droppedRows containsIndex:row]) {
+            [removedPositions addIndex:position];
+            continue;
+        }
+        [result appendBytes:&row length:sizeof(NSUInteger)];
+    }
+    return result;
+}
+
+
+/// Both row lists are ascending, so a single merge finds the rows that left (positions in the old list) and the rows that arrived (positions in the new list).
+static void APPSFilteredDataSourceComputeChanges(NSArray<NSData *> *oldRowsBySection, NSArray<NSData *> *newRowsBySection, NSUInteger maximumAnimatedChanges, NSMutableArray *removedIndexPaths, NSMutableArray *insertedIndexPaths, NSMutableIndexSet *refreshedSections)
+{
+    NSUInteger numberOfSections = MIN(oldRowsBySection.count, newRowsBySection.count);
+
+    for (NSUInteger section = 0; section < numberOfSections; ++section) {
+        const NSUInteger *oldRows = oldRowsBySection[section].bytes;
+        const NSUInteger *newRows = newRowsBySection[section].bytes;
+        NSUInteger oldCount = oldRowsBySection[section].length / sizeof(NSUInteger);
+        NSUInteger newCount = newRowsBySection[section].length / sizeof(NSUInteger);
+
+        NSMutableArray *removed = [NSMutableArray array];
+        NSMutableArray *inserted = [NSMutableArray array];
+        NSUInteger oldIndex = 0;
+        NSUInteger newIndex = 0;
+
+        while (oldIndex < oldCount || newIndex < newCount) {
+            if (removed.count + inserted.count > maximumAnimatedChanges)
+                break;
+
+            if (newIndex == newCount || (oldIndex < oldCount && oldRows[oldIndex] < newRows[newIndex])) {
+                [removed addObject:[NSIndexPath indexPathForRow:oldIndex++ inSection:section]];
+            }
+            else if (oldIndex == oldCount || newRows[newIndex] < oldRows[oldIndex]) {
+                [inserted addObject:[NSIndexPath indexPathForRow:newIndex++ inSection:section]];
+            }
+            else {
+                ++oldIndex;
+                ++newIndex;
+            }
+        }
+
+        if (removed.count + inserted.count > maximumAnimatedChanges) {
+            [refreshedSections addIndex:section];
+            continue;
+        }
+
+        [removedIndexPaths addObjectsFromArray:removed];
+        [insertedIndexPaths addObjectsFromArray:inserted];
+    }
+}
+
+
+/// A single query being filtered in the background.
+@interface APPSFilteredDataSourceOperation : NSObject
+@property (nonatomic, copy) NSString *query;
+@property (nullable, nonatomic, copy) dispatch_block_t completion;
+@property (atomic, getter = isCancelled) BOOL cancelled;
+@end
+
+@implementation APPSFilteredDataSourceOperation
+@end
+
+
+@interface APPSFilteredDataSource () <APPSDataSourceDelegate>
+@property (nonatomic, strong, readwrite) APPSDataSource *dataSource;
+@property (nonatomic, copy) APPSFilteredDataSourceMatchingBlock matchingBlock;
+/// For each section of the wrapped data source, an NSData of ascending NSUInteger row indexes that match the applied query.
+@property (nonatomic, copy) NSArray<NSData *> *rowsBySection;
+/// The query rowsBySection was filtered with.
+@property (nullable, nonatomic, copy) NSString *appliedQuery;
+/// The items of the wrapped data source, by section, captured for background filtering. Discarded when the wrapped data source changes.
+@property (nullable, nonatomic, copy) NSArray<NSArray *> *itemsBySection;
+@property (nullable, nonatomic, strong) APPSFilteredDataSourceOperation *filterOperation;
+@property (nonatomic, strong) dispatch_queue_t filterQueue;
+@end
+
+@implementation APPSFilteredDataSource {
+    /// Sections the wrapped data source replaced wholesale while a query was applied. They show no rows until a background filter examines them.
+    NSMutableIndexSet *_unfilteredSections;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithDataSource:(APPSDataSource *)dataSource matchingBlock:(APPSFilteredDataSourceMatchingBlock)matchingBlock
+{
+    NSParameterAssert(dataSource != nil);
+    NSParameterAssert(matchingBlock != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _dataSource = dataSource;
+    _dataSource.delegate = self;
+    _matchingBlock = [matchingBlock copy];
+    _narrowsExtendedQueries = YES;
+    _maximumAnimatedChanges = 500;
+
+    dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+    _filterQueue = dispatch_queue_create("com.appstronomy.APPSUIKit.filter", attributes);
+
+    _unfilteredSections = [NSMutableIndexSet indexSet];
+
+    // There's no query yet, so every row shows and nothing needs matching.
+    NSMutableArray<NSData *> *rowsBySection = [NSMutableArray array];
+    for (NSInteger section = 0; section < _dataSource.numberOfSections; ++section)
+        [rowsBySection addObject:APPSFilteredAllRows([_dataSource numberOfRowsInSection:section])];
+    _rowsBySection = [rowsBySection copy];
+
+    return self;
+}
+
+
++ (instancetype)filteredDataSourceWithDataSource:(APPSDataSource *)dataSource keyPath:(NSString *)keyPath
+{
+    NSParameterAssert(keyPath != nil);
+
+    return [[self alloc] initWithDataSource:dataSource matchingBlock:^BOOL(id item, NSString *query) {
+        id value = [item valueForKeyPath:keyPath];
+        if (![value isKindOfClass:[NSString class]])
+            return NO;
+        return [(NSString *)value rangeOfString:query options:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch].location != NSNotFound;
+    }];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (void)setQuery:(NSString *)query
+{
+    [self setQuery:query completion:nil];
+}
+
+
+- (void)setQuery:(NSString *)query completion:(dispatch_block_t)completion
+{
+    NSAssert([NSThread isMainThread], @"This method must be called on the main thread");
+
+    _query = [query copy];
+
+    [self.filterOperation setCancelled:YES];
+
+    APPSFilteredDataSourceOperation *operation = [[APPSFilteredDataSourceOperation alloc] init];
+    operation.query = query.length ? query : @"";
+    operation.completion = completion;
+    self.filterOperation = operation;
+
+    [self beginFilterOperation:operation];
+}
+
+
+- (BOOL)isFiltering
+{
+    return self.filterOperation != nil;
+}
+
+
+
+#pragma mark - APPSDataSource
+
+- (NSInteger)numberOfSections
+{
+    return _dataSource.numberOfSections;
+}
+
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)sectionIndex
+{
+    if (sectionIndex < 0 || sectionIndex >= (NSInteger)_rowsBySection.count)
+        return 0;
+    return _rowsBySection[sectionIndex].length / sizeof(NSUInteger);
+}
+
+
+- (NSArray *)indexPathsForItem:(id)item
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSIndexPath *wrappedIndexPath in [_dataSource indexPathsForItem:item]) {
+        NSIndexPath *indexPath = [self indexPathForWrappedIndexPath:wrappedIndexPath];
+        if (indexPath)
+            [indexPaths addObject:indexPath];
+    }
+    return indexPaths;
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    return wrappedIndexPath ? [_dataSource itemAtIndexPath:wrappedIndexPath] : nil;
+}
+
+
+- (void)removeItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    // The wrapped data source reports the removal back to us, which is when the row disappears.
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    if (wrappedIndexPath)
+        [_dataSource removeItemAtIndexPath:wrappedIndexPath];
+}
+
+
+- (void)didBecomeActive
+{
+    [super didBecomeActive];
+    [_dataSource didBecomeActive];
+}
+
+
+- (void)willResignActive
+{
+    [super willResignActive];
+    [_dataSource willResignActive];
+}
+
+
+- (BOOL)allowsSelection
+{
+    return _dataSource.allowsSelection;
+}
+
+
+- (void)registerReusableViewsWithTableView:(UITableView *)tableView
+{
+    [super registerReusableViewsWithTableView:tableView];
+    [_dataSource registerReusableViewsWithTableView:tableView];
+}
+
+
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [_dataSource prefetchRowsAtIndexPaths:[self wrappedIndexPathsForIndexPaths:indexPaths]];
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [_dataSource cancelPrefetchingForRowsAtIndexPaths:[self wrappedIndexPathsForIndexPaths:indexPaths]];
+}
+
+
+- (NSString *)heightDeterminingTextForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    return wrappedIndexPath ? [_dataSource heightDeterminingTextForItemAtIndexPath:wrappedIndexPath] : nil;
+}
+
+
+- (APPSTextLayoutSpec *)textLayoutSpecForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    return wrappedIndexPath ? [_dataSource textLayoutSpecForItemAtIndexPath:wrappedIndexPath] : nil;
+}
+
+
+
+#pragma mark - Protocol: APPSContentLoading
+
+- (void)beginLoadingContentWithProgress:(APPSLoadingProgress *)progress
+{
+    [_dataSource loadContent];
+    [super beginLoadingContentWithProgress:progress];
+}
+
+
+- (void)resetContent
+{
+    [_dataSource resetContent];
+    [super resetContent];
+}
+
+
+
+#pragma mark - Placeholders
+
+- (void)updatePlaceholderView:(APPSTablePlaceholderView *)placeholderView forSectionAtIndex:(NSInteger)sectionIndex
+{
+    [_dataSource updatePlaceholderView:placeholderView forSectionAtIndex:sectionIndex];
+}
+
+
+
+#pragma mark - Protocol: UITableViewDataSource
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    return [_dataSource tableView:tableView cellForRowAtIndexPath:[self wrappedIndexPathForIndexPath:indexPath]];
+}
+
+
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    return wrappedIndexPath ? [_dataSource tableView:tableView reconfigureCell:cell forRowAtIndexPath:wrappedIndexPath] : NO;
+}
+
+
+- (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section
+{
+    if ([_dataSource respondsToSelector:@selector(tableView:titleForHeaderInSection:)]) {
+        return [_dataSource tableView:tableView titleForHeaderInSection:section];
+    } else {
+        return nil;
+    }
+}
+
+
+- (NSString *)tableView:(UITableView *)tableView titleForFooterInSection:(NSInteger)section
+{
+    if ([_dataSource respondsToSelector:@selector(tableView:titleForFooterInSection:)]) {
+        return [_dataSource tableView:tableView titleForFooterInSection:section];
+    } else {
+        return nil;
+    }
+}
+
+
+- (BOOL)tableView:(UITableView *)tableView canEditRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+    if (wrappedIndexPath && [_dataSource respondsToSelector:@selector(tableView:canEditRowAtIndexPath:)]) {
+        return [_dataSource tableView:tableView canEditRowAtIndexPath:wrappedIndexPath];
+    }
+    else {
+        return YES;
+    }
+}
+
+
+
+#pragma mark - Protocol: APPSDataSourceDelegate
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+
+    // Only the sections that were touched are rebuilt, each in a single pass.
+    [[self wrappedRowsBySectionForIndexPaths:indexPaths] enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber, NSIndexSet *insertedRows, BOOL *stop) {
+        NSUInteger section = sectionNumber.unsignedIntegerValue;
+        NSMutableIndexSet *matchingRows = [NSMutableIndexSet indexSet];
+        [insertedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stopRows) {
+            if ([self itemAtWrappedIndexPath:[NSIndexPath indexPathForRow:row inSection:section] matchesQuery:self.appliedQuery])
+                [matchingRows addIndex:row];
+        }];
+
+        NSMutableIndexSet *insertedPositions = [NSMutableIndexSet indexSet];
+        rowsBySection[section] = APPSFilteredRowsByInsertingRows(rowsBySection[section], insertedRows, matchingRows, insertedPositions);
+        [insertedIndexPaths addObjectsFromArray:[self indexPathsForIndexes:insertedPositions section:section]];
+    }];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+
+    if (insertedIndexPaths.count)
+        [self notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSMutableArray *removedIndexPaths = [NSMutableArray array];
+
+    [[self wrappedRowsBySectionForIndexPaths:indexPaths] enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber, NSIndexSet *removedRows, BOOL *stop) {
+        NSUInteger section = sectionNumber.unsignedIntegerValue;
+        NSMutableIndexSet *removedPositions = [NSMutableIndexSet indexSet];
+        rowsBySection[section] = APPSFilteredRowsByRemovingRows(rowsBySection[section], removedRows, removedPositions);
+        [removedIndexPaths addObjectsFromArray:[self indexPathsForIndexes:removedPositions section:section]];
+    }];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+
+    if (removedIndexPaths.count)
+        [self notifyItemsRemovedAtIndexPaths:removedIndexPaths];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSMutableArray *refreshedIndexPaths = [NSMutableArray array];
+    NSMutableArray *removedIndexPaths = [NSMutableArray array];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+
+    // A refreshed item may start or stop matching the query, which becomes an insertion or removal here.
+    [[self wrappedRowsBySectionForIndexPaths:indexPaths] enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionNumber, NSIndexSet *refreshedRows, BOOL *stop) {
+        NSUInteger section = sectionNumber.unsignedIntegerValue;
+        NSData *rows = rowsBySection[section];
+        NSUInteger count = rows.length / sizeof(NSUInteger);
+        NSMutableIndexSet *droppedRows = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *addedRows = [NSMutableIndexSet indexSet];
+
+        [refreshedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stopRows) {
+            NSUInteger position = APPSFilteredRowsLowerBound(rows.bytes, count, row);
+            BOOL present = position < count && ((const NSUInteger *)rows.bytes)[position] == row;
+            BOOL matches = [self itemAtWrappedIndexPath:[NSIndexPath indexPathForRow:row inSection:section] matchesQuery:self.appliedQuery];
+
+            if (present && matches)
+                [refreshedIndexPaths addObject:[NSIndexPath indexPathForRow:position inSection:section]];
+            else if (present)
+                [droppedRows addIndex:row];
+            else if (matches)
+                [addedRows addIndex:row];
+        }];
+
+        if (!droppedRows.count && !addedRows.count)
+            return;
+
+        NSMutableIndexSet *removedPositions = [NSMutableIndexSet indexSet];
+        NSMutableIndexSet *insertedPositions = [NSMutableIndexSet indexSet];
+        rowsBySection[section] = APPSFilteredRowsByReplacingRows(rows, droppedRows, addedRows, removedPositions, insertedPositions);
+        [removedIndexPaths addObjectsFromArray:[self indexPathsForIndexes:removedPositions section:section]];
+        [insertedIndexPaths addObjectsFromArray:[self indexPathsForIndexes:insertedPositions section:section]];
+    }];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+
+    if (removedIndexPaths.count)
+        [self notifyItemsRemovedAtIndexPaths:removedIndexPaths];
+    if (insertedIndexPaths.count)
+        [self notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
+    if (refreshedIndexPaths.count)
+        [self notifyItemsRefreshedAtIndexPaths:refreshedIndexPaths];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    // Reconfigured rows are reported after the change, so only the ones that pass the filter now have a row here.
+    NSMutableArray *reconfiguredIndexPaths = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    for (NSIndexPath *wrappedIndexPath in indexPaths) {
+        NSIndexPath *indexPath = [self indexPathForWrappedIndexPath:wrappedIndexPath];
+        if (indexPath)
+            [reconfiguredIndexPaths addObject:indexPath];
+    }
+
+    if (reconfiguredIndexPaths.count)
+        [self notifyItemsReconfiguredAtIndexPaths:reconfiguredIndexPaths];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath
+{
+    NSUInteger fromSection = fromIndexPath.section;
+    NSUInteger toSection = newIndexPath.section;
+    if (fromSection >= _rowsBySection.count || toSection >= _rowsBySection.count)
+        return;
+
+    // The item keeps whether it matches, so the move is its removal followed by its insertion, and every row in between shifts by one.
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSMutableIndexSet *removedPositions = [NSMutableIndexSet indexSet];
+    rowsBySection[fromSection] = APPSFilteredRowsByRemovingRows(rowsBySection[fromSection], [NSIndexSet indexSetWithIndex:fromIndexPath.row], removedPositions);
+
+    NSIndexSet *insertedRows = [NSIndexSet indexSetWithIndex:newIndexPath.row];
+    NSMutableIndexSet *insertedPositions = [NSMutableIndexSet indexSet];
+    rowsBySection[toSection] = APPSFilteredRowsByInsertingRows(rowsBySection[toSection], insertedRows, removedPositions.count ? insertedRows : [NSIndexSet indexSet], insertedPositions);
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+
+    if (removedPositions.count)
+        [self notifyItemMovedFromIndexPath:[NSIndexPath indexPathForRow:removedPositions.firstIndex inSection:fromSection] toIndexPaths:[NSIndexPath indexPathForRow:insertedPositions.firstIndex inSection:toSection]];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertSections:(NSIndexSet *)sections
+{
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSMutableArray *placeholderRows = [NSMutableArray arrayWithCapacity:sections.count];
+    for (NSUInteger index = 0; index < sections.count; ++index)
+        [placeholderRows addObject:[NSData data]];
+    [rowsBySection insertObjects:placeholderRows atIndexes:sections];
+
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        [_unfilteredSections shiftIndexesStartingAtIndex:section by:1];
+    }];
+
+    [self setNeedsFilterSections:sections inRowsBySection:rowsBySection];
+    [self notifySectionsInserted:sections];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveSections:(NSIndexSet *)sections
+{
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    [rowsBySection removeObjectsAtIndexes:[sections indexesPassingTest:^BOOL(NSUInteger section, BOOL *stop) {
+        return section < rowsBySection.count;
+    }]];
+
+    [sections enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger section, BOOL *stop) {
+        [_unfilteredSections shiftIndexesStartingAtIndex:section + 1 by:-1];
+    }];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+    [self notifySectionsRemoved:sections];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshSections:(NSIndexSet *)sections
+{
+    [self setNeedsFilterSections:sections inRowsBySection:[_rowsBySection mutableCopy]];
+    [self notifySectionsRefreshed:sections];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveSection:(NSInteger)section toSection:(NSInteger)newSection
+{
+    if (section >= (NSInteger)_rowsBySection.count || newSection >= (NSInteger)_rowsBySection.count)
+        return;
+
+    NSMutableArray<NSData *> *rowsBySection = [_rowsBySection mutableCopy];
+    NSData *rows = rowsBySection[section];
+    [rowsBySection removeObjectAtIndex:section];
+    [rowsBySection insertObject:rows atIndex:newSection];
+
+    BOOL unfiltered = [_unfilteredSections containsIndex:section];
+    [_unfilteredSections removeIndex:section];
+    [_unfilteredSections shiftIndexesStartingAtIndex:section + 1 by:-1];
+    [_unfilteredSections shiftIndexesStartingAtIndex:newSection by:1];
+    if (unfiltered)
+        [_unfilteredSections addIndex:newSection];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+    [self notifySectionMovedFrom:section to:newSection];
+}
+
+
+- (void)dataSourceDidReloadData:(APPSDataSource *)dataSource
+{
+    NSInteger numberOfSections = _dataSource.numberOfSections;
+    NSMutableArray<NSData *> *rowsBySection = [NSMutableArray arrayWithCapacity:numberOfSections];
+    for (NSInteger section = 0; section < numberOfSections; ++section)
+        [rowsBySection addObject:[NSData data]];
+
+    [_unfilteredSections removeAllIndexes];
+    [self setNeedsFilterSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfSections)] inRowsBySection:rowsBySection];
+    [self notifyDidReloadData];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource performBatchUpdate:(dispatch_block_t)update complete:(dispatch_block_t)complete
+{
+    [self performUpdate:update complete:complete];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didPresentActivityIndicatorForSections:(NSIndexSet *)sections
+{
+    [self presentActivityIndicatorForSections:sections];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didPresentPlaceholderForSections:(NSIndexSet *)sections
+{
+    [self presentPlaceholder:nil forSections:sections];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didDismissPlaceholderForSections:(NSIndexSet *)sections
+{
+    [self dismissPlaceholderForSections:sections];
+}
+
+
+
+#pragma mark - Filtering
+
+- (void)beginFilterOperation:(APPSFilteredDataSourceOperation *)operation
+{
+    NSString *query = operation.query;
+    NSString *appliedQuery = self.appliedQuery ?: @"";
+    NSArray<NSData *> *baseRowsBySection = self.rowsBySection;
+    NSArray<NSArray *> *itemsBySection = [self capturedItemsBySection];
+    NSUInteger maximumAnimatedChanges = self.maximumAnimatedChanges;
+    NSIndexSet *unfilteredSections = [_unfilteredSections copy];
+
+    // Refiltering with the applied query only needs the sections that haven't been filtered with it yet.
+    NSIndexSet *examinedSections = [query isEqualToString:appliedQuery] ? unfilteredSections : [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, baseRowsBySection.count)];
+
+    // Every row that matches an extension of the applied query already matches the applied query, so only those rows need examining.
+    NSMutableIndexSet *narrowedSections = [NSMutableIndexSet indexSet];
+    if (self.narrowsExtendedQueries && appliedQuery.length && query.length > appliedQuery.length && [query hasPrefix:appliedQuery]) {
+        [narrowedSections addIndexesInRange:NSMakeRange(0, baseRowsBySection.count)];
+        [narrowedSections removeIndexes:unfilteredSections];
+    }
+
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(self.filterQueue, ^{
+        if (operation.isCancelled)
+            return;
+
+        NSArray<NSData *> *rowsBySection = [weakSelf rowsMatchingQuery:query itemsBySection:itemsBySection baseRowsBySection:baseRowsBySection examinedSections:examinedSections narrowedSections:narrowedSections operation:operation];
+        if (!rowsBySection)
+            return;
+
+        NSMutableArray *removedIndexPaths = [NSMutableArray array];
+        NSMutableArray *insertedIndexPaths = [NSMutableArray array];
+        NSMutableIndexSet *refreshedSections = [NSMutableIndexSet indexSet];
+        APPSFilteredDataSourceComputeChanges(baseRowsBySection, rowsBySection, maximumAnimatedChanges, removedIndexPaths, insertedIndexPaths, refreshedSections);
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            APPSFilteredDataSource *me = weakSelf;
+            if (!me || operation.isCancelled)
+                return;
+
+            // The wrapped data source changed while we were filtering, so the result is stale. Filter again against its current contents.
+            if (me.rowsBySection != baseRowsBySection) {
+                [me beginFilterOperation:operation];
+                return;
+            }
+
+            [me performUpdate:^{
+                me.rowsBySection = rowsBySection;
+                me.appliedQuery = query;
+                [me->_unfilteredSections removeAllIndexes];
+
+                if (removedIndexPaths.count)
+                    [me notifyItemsRemovedAtIndexPaths:removedIndexPaths];
+                if (insertedIndexPaths.count)
+                    [me notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
+                if (refreshedSections.count)
+                    [me notifySectionsRefreshed:refreshedSections];
+            } complete:operation.completion];
+
+            if (me.filterOperation == operation)
+                me.filterOperation = nil;
+        });
+    });
+}
+
+
+/// Collect the rows of each examined section that match query; the other sections keep their base rows. In the narrowed sections only the base rows are examined. Returns nil if the operation is cancelled.
+- (NSArray<NSData *> *)rowsMatchingQuery:(NSString *)query itemsBySection:(NSArray<NSArray *> *)itemsBySection baseRowsBySection:(NSArray<NSData *> *)baseRowsBySection examinedSections:(NSIndexSet *)examinedSections narrowedSections:(NSIndexSet *)narrowedSections operation:(APPSFilteredDataSourceOperation *)operation
+{
+    APPSFilteredDataSourceMatchingBlock matchingBlock = self.matchingBlock;
+    NSMutableArray<NSData *> *rowsBySection = [NSMutableArray arrayWithCapacity:itemsBySection.count];
+    NSUInteger examined = 0;
+
+    for (NSUInteger section = 0; section < itemsBySection.count; ++section) {
+        NSData *baseRows = section < baseRowsBySection.count ? baseRowsBySection[section] : nil;
+        if (baseRows && ![examinedSections containsIndex:section]) {
+            [rowsBySection addObject:baseRows];
+            continue;
+        }
+
+        NSArray *items = itemsBySection[section];
+        NSData *candidateRows = [narrowedSections containsIndex:section] ? baseRows : nil;
+        NSUInteger candidateCount = candidateRows ? candidateRows.length / sizeof(NSUInteger) : items.count;
+        const NSUInteger *candidates = candidateRows.bytes;
+
+        NSMutableData *rows = [NSMutableData dataWithCapacity:candidateCount * sizeof(NSUInteger)];
+        for (NSUInteger index = 0; index < candidateCount; ++index) {
+            if (++examined % APPSFilteredDataSourceCancellationInterval == 0 && operation.isCancelled)
+                return nil;
+
+            NSUInteger row = candidates ? candidates[index] : index;
+            id item = items[row];
+            if (!query.length || (item != [NSNull null] && matchingBlock(item, query)))
+                [rows appendBytes:&row length:sizeof(NSUInteger)];
+        }
+        [rowsBySection addObject:rows];
+    }
+
+    return rowsBySection;
+}
+
+
+/// Replace the rows of sections, which the wrapped data source has replaced wholesale. Without a query they're simply every row. Otherwise they're left empty until a background filter has examined them with the applied query.
+- (void)setNeedsFilterSections:(NSIndexSet *)sections inRowsBySection:(NSMutableArray<NSData *> *)rowsBySection
+{
+    BOOL filters = self.appliedQuery.length > 0;
+
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        if (section >= rowsBySection.count)
+            return;
+
+        rowsBySection[section] = filters ? [NSData data] : APPSFilteredAllRows([_dataSource numberOfRowsInSection:section]);
+        if (filters)
+            [_unfilteredSections addIndex:section];
+    }];
+
+    [self wrappedDataSourceDidChangeWithRowsBySection:rowsBySection];
+
+    // A filter already under way notices the change and starts over, picking these sections up.
+    if (!_unfilteredSections.count || self.filterOperation)
+        return;
+
+    APPSFilteredDataSourceOperation *operation = [[APPSFilteredDataSourceOperation alloc] init];
+    operation.query = self.appliedQuery;
+    self.filterOperation = operation;
+    [self beginFilterOperation:operation];
+}
+
+
+#pragma mark - Helper
+
+- (NSIndexPath *)wrappedIndexPathForIndexPath:(NSIndexPath *)indexPath
+{
+    NSInteger section = indexPath.section;
+    NSInteger row = indexPath.row;
+    if (section < 0 || section >= (NSInteger)_rowsBySection.count || row < 0 || row >= [self numberOfRowsInSection:section])
+        return nil;
+
+    const NSUInteger *rows = _rowsBySection[section].bytes;
+    return [NSIndexPath indexPathForRow:rows[row] inSection:section];
+}
+
+
+- (NSIndexPath *)indexPathForWrappedIndexPath:(NSIndexPath *)wrappedIndexPath
+{
+    NSInteger section = wrappedIndexPath.section;
+    if (section < 0 || section >= (NSInteger)_rowsBySection.count)
+        return nil;
+
+    NSData *rows = _rowsBySection[section];
+    NSUInteger count = rows.length / sizeof(NSUInteger);
+    NSUInteger position = APPSFilteredRowsLowerBound(rows.bytes, count, wrappedIndexPath.row);
+    if (position == count || ((const NSUInteger *)rows.bytes)[position] != (NSUInteger)wrappedIndexPath.row)
+        return nil;
+
+    return [NSIndexPath indexPathForRow:position inSection:section];
+}
+
+
+- (NSArray<NSIndexPath *> *)wrappedIndexPathsForIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    NSMutableArray *wrappedIndexPaths = [NSMutableArray arrayWithCapacity:indexPaths.count];
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSIndexPath *wrappedIndexPath = [self wrappedIndexPathForIndexPath:indexPath];
+        if (wrappedIndexPath)
+            [wrappedIndexPaths addObject:wrappedIndexPath];
+    }
+    return wrappedIndexPaths;
+}
+
+
+- (BOOL)itemAtWrappedIndexPath:(NSIndexPath *)wrappedIndexPath matchesQuery:(NSString *)query
+{
+    if (!query.length)
+        return YES;
+
+    id item = [_dataSource itemAtIndexPath:wrappedIndexPath];
+    return item ? self.matchingBlock(item, query) : NO;
+}
+
+
+/// The items of the wrapped data source, by section. An APPSBasicDataSource hands over its array directly; other data sources are asked for each item.
+- (NSArray<NSArray *> *)capturedItemsBySection
+{
+    if (_itemsBySection)
+        return _itemsBySection;
+
+    NSMutableArray *itemsBySection = [NSMutableArray array];
+
+    if ([_dataSource isKindOfClass:[APPSBasicDataSource class]]) {
+        [itemsBySection addObject:((APPSBasicDataSource *)_dataSource).items ?: @[]];
+    }
+    else {
+        NSInteger numberOfSections = _dataSource.numberOfSections;
+        for (NSInteger sectionIndex = 0; sectionIndex < numberOfSections; ++sectionIndex) {
+            NSInteger numberOfItems = [_dataSource numberOfRowsInSection:sectionIndex];
+            NSMutableArray *items = [NSMutableArray arrayWithCapacity:numberOfItems];
+            for (NSInteger itemIndex = 0; itemIndex < numberOfItems; ++itemIndex)
+                [items addObject:[_dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:itemIndex inSection:sectionIndex]] ?: [NSNull null]];
+            [itemsBySection addObject:items];
+        }
+    }
+
+    _itemsBySection = [itemsBySection copy];
+    return _itemsBySection;
+}
+
+
+/// The rows of indexPaths grouped by section, leaving out sections we don't have.
+- (NSDictionary<NSNumber *, NSIndexSet *> *)wrappedRowsBySectionForIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    NSMutableDictionary<NSNumber *, NSMutableIndexSet *> *rowsBySection = [NSMutableDictionary dictionary];
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (indexPath.section >= (NSInteger)_rowsBySection.count)
+            continue;
+
+        NSMutableIndexSet *rows = rowsBySection[@(indexPath.section)];
+        if (!rows)
+            rowsBySection[@(indexPath.section)] = rows = [NSMutableIndexSet indexSet];
+        [rows addIndex:indexPath.row];
+    }
+    return rowsBySection;
+}
+
+
+- (NSArray<NSIndexPath *> *)indexPathsForIndexes:(NSIndexSet *)indexes section:(NSInteger)section
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:index inSection:section]];
+    }];
+    return indexPaths;
+}
+
+
+/// Record that the wrapped data source changed, installing its patched rows.
+- (void)wrappedDataSourceDidChangeWithRowsBySection:(NSArray<NSData *> *)rowsBySection
+{
+    _itemsBySection = nil;
+
+    // Always install a new array, even when nothing matched, so an in-flight filter notices its base has moved on.
+    self.rowsBySection = rowsBySection;
+}
+
+@end
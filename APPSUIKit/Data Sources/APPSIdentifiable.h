@@ -0,0 +1,27 @@
+//
+//  APPSIdentifiable.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Adopted by items that keep a stable identity while their content changes.
+
+ When every item handed to APPSDataSourceDiff adopts this protocol, items are matched by identifier rather than -isEqual:, and an item whose content hash changed is reported as a refresh instead of a removal and insertion. Items whose hash is unchanged are left alone, so their rows aren't reconfigured. APPSRowHeightCache also keys heights by identifier for these items.
+ */
+@protocol APPSIdentifiable <NSObject>
+
+/// An identifier that stays the same for the life of the item. It must implement -isEqual: and -hash.
+@property (nonatomic, readonly) id<NSObject, NSCopying> itemIdentifier;
+
+/// A cheap hash of everything the item's cell displays. It must change whenever that content changes.
+@property (nonatomic, readonly) NSUInteger contentHash;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,38 @@
+//
+//  APPSIdentityIndex.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The position of every identifier in an ordered list, kept current as identifiers are inserted and removed.
+
+ Identifiers sit in a position-ordered treap whose nodes point at their parents, and a map table leads from each identifier to its node. Finding an identifier's index climbs from its node to the root, summing the sizes of the subtrees to its left, so lookups, insertions and removals are all O(log n) without renumbering anything.
+ */
+@interface APPSIdentityIndex : NSObject
+
+/// Create an index over identifiers, in order. Returns nil when an identifier appears more than once.
+- (nullable instancetype)initWithIdentifiers:(NSArray<id<NSObject, NSCopying>> *)identifiers NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The number of identifiers.
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The index of identifier, or NSNotFound.
+- (NSUInteger)indexOfIdentifier:(id)identifier;
+
+/// Insert identifier at index. The identifier must not already be present.
+- (void)insertIdentifier:(id<NSObject, NSCopying>)identifier atIndex:(NSUInteger)index;
+
+/// Remove identifier, returning the index it had, or NSNotFound.
+- (NSUInteger)removeIdentifier:(id)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,192 @@
+//
+//  APPSIdentityIndex.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSIdentityIndex.h"
+
+typedef struct APPSIdentityNode APPSIdentityNode;
+struct APPSIdentityNode {
+    APPSIdentityNode *left;
+    APPSIdentityNode *right;
+    APPSIdentityNode *parent;
+    uint32_t priority;
+    NSUInteger size;
+};
+
+
+#pragma mark - Treap
+
+static inline NSUInteger APPSIdentityNodeSize(const APPSIdentityNode *node)
+{
+    return node ? node->size : 0;
+}
+
+
+static void APPSIdentityNodeUpdate(APPSIdentityNode *node)
+{
+    node->size = 1 + APPSIdentityNodeSize(node->left) + APPSIdentityNodeSize(node->right);
+    if (node->left)
+        node->left->parent = node;
+    if (node->right)
+        node->right->parent = node;
+}
+
+
+/// Split node into its first position nodes and the rest. The roots returned have no parent.
+static void APPSIdentityTreeSplit(APPSIdentityNode *node, NSUInteger position, APPSIdentityNode **left, APPSIdentityNode **right)
+{
+    if (!node) {
+        *left = *right = NULL;
+        return;
+    }
+
+    NSUInteger leftSize = APPSIdentityNodeSize(node->left);
+    if (position <= leftSize) {
+        APPSIdentityTreeSplit(node->left, position, left, &node->left);
+        *right = node;
+    }
+    else {
+        APPSIdentityTreeSplit(node->right, position - leftSize - 1, &node->right, right);
+        *left = node;
+    }
+    APPSIdentityNodeUpdate(node);
+    node->parent = NULL;
+    if (*left)
+        (*left)->parent = NULL;
+    if (*right)
+        (*right)->parent = NULL;
+}
+
+
+static APPSIdentityNode *APPSIdentityTreeJoin(APPSIdentityNode *left, APPSIdentityNode *right)
+{
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->right = APPSIdentityTreeJoin(left->right, right);
+        APPSIdentityNodeUpdate(left);
+        return left;
+    }
+
+    right->left = APPSIdentityTreeJoin(left, right->left);
+    APPSIdentityNodeUpdate(right);
+    return right;
+}
+
+
+static NSUInteger APPSIdentityNodePosition(const APPSIdentityNode *node)
+{
+    NSUInteger position = APPSIdentityNodeSize(node->left);
+    for (; node->parent; node = node->parent) {
+        if (node == node->parent->right)
+            position += APPSIdentityNodeSize(node->parent->left) + 1;
+    }
+    return position;
+}
+
+
+
+@implementation APPSIdentityIndex {
+    APPSIdentityNode *_root;
+    /// Identifier → NSValue wrapping its node. The map table owns the nodes' lifetimes.
+    NSMapTable *_nodesByIdentifier;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithIdentifiers:(NSArray<id<NSObject, NSCopying>> *)identifiers
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _nodesByIdentifier = [NSMapTable strongToStrongObjectsMapTable];
+    for (id<NSObject, NSCopying> identifier in identifiers) {
+        if ([_nodesByIdentifier objectForKey:identifier])
+            return nil;
+
+        _root = APPSIdentityTreeJoin(_root, [self createNodeForIdentifier:identifier]);
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    for (NSValue *value in _nodesByIdentifier.objectEnumerator)
+        free(value.pointerValue);
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSUInteger)count
+{
+    return APPSIdentityNodeSize(_root);
+}
+
+
+- (NSUInteger)indexOfIdentifier:(id)identifier
+{
+    NSValue *value = [_nodesByIdentifier objectForKey:identifier];
+    return value ? APPSIdentityNodePosition(value.pointerValue) : NSNotFound;
+}
+
+
+- (void)insertIdentifier:(id<NSObject, NSCopying>)identifier atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index <= self.count);
+    NSAssert([_nodesByIdentifier objectForKey:identifier] == nil, @"Identifier is already in the index: %@", identifier);
+
+    APPSIdentityNode *left, *right;
+    APPSIdentityTreeSplit(_root, index, &left, &right);
+    _root = APPSIdentityTreeJoin(APPSIdentityTreeJoin(left, [self createNodeForIdentifier:identifier]), right);
+    _root->parent = NULL;
+}
+
+
+- (NSUInteger)removeIdentifier:(id)identifier
+{
+    NSValue *value = [_nodesByIdentifier objectForKey:identifier];
+    if (!value)
+        return NSNotFound;
+
+    APPSIdentityNode *node = value.pointerValue;
+    NSUInteger index = APPSIdentityNodePosition(node);
+
+    APPSIdentityNode *left, *rest, *removed, *right;
+    APPSIdentityTreeSplit(_root, index, &left, &rest);
+    APPSIdentityTreeSplit(rest, 1, &removed, &right);
+    NSAssert(removed == node, @"The index's tree and map table disagree about %@", identifier);
+
+    _root = APPSIdentityTreeJoin(left, right);
+    if (_root)
+        _root->parent = NULL;
+
+    [_nodesByIdentifier removeObjectForKey:identifier];
+    free(node);
+    return index;
+}
+
+
+
+#pragma mark - Helper
+
+- (APPSIdentityNode *)createNodeForIdentifier:(id<NSObject, NSCopying>)identifier
+{
+    APPSIdentityNode *node = calloc(1, sizeof(APPSIdentityNode));
+    node->priority = arc4random();
+    node->size = 1;
+    [_nodesByIdentifier setObject:[NSValue valueWithPointer:node] forKey:identifier];
+    return node;
+}
+
+@end
@@ -0,0 +1,59 @@
+//
+//  APPSItemPatch.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import Foundation;
+
+#import "APPSIdentifiable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The error domain for patches that can't be applied.
+extern NSString * const APPSItemPatchErrorDomain;
+
+typedef NS_ENUM(NSInteger, APPSItemPatchError) {
+    /// The items changed after the generation the patch was made against.
+    APPSItemPatchErrorGenerationMismatch = 1,
+    /// An operation names an identifier that isn't present, inserts one that already is, or uses an index out of range.
+    APPSItemPatchErrorInvalidOperation,
+    /// The current items don't all adopt APPSIdentifiable, or they repeat an identifier.
+    APPSItemPatchErrorItemsNotIdentifiable,
+};
+
+
+/**
+ An ordered list of edits to a list of APPSIdentifiable items, such as a delta sent by a server.
+
+ Operations apply in order, each seeing the result of the ones before it. A patch is made against one generation of the items, and APPSBasicDataSource refuses it if the items have changed since. The caller then falls back to setting the items in full.
+ */
+@interface APPSItemPatch : NSObject
+
+/// Create an empty patch made against generation, the value of the data source's itemsGeneration the edits were computed from.
+- (instancetype)initWithBaseGeneration:(NSUInteger)generation NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The generation of items this patch applies to.
+@property (nonatomic, readonly) NSUInteger baseGeneration;
+
+/// The number of operations in the patch.
+@property (nonatomic, readonly) NSUInteger numberOfOperations;
+
+/// Insert item so it ends up at index.
+- (void)insertItem:(id<APPSIdentifiable>)item atIndex:(NSUInteger)index;
+
+/// Delete the item with identifier.
+- (void)deleteItemWithIdentifier:(id<NSObject, NSCopying>)identifier;
+
+/// Move the item with identifier so it ends up at index.
+- (void)moveItemWithIdentifier:(id<NSObject, NSCopying>)identifier toIndex:(NSUInteger)index;
+
+/// Replace the item with the same identifier as item.
+- (void)updateItem:(id<APPSIdentifiable>)item;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,102 @@
+//
+//  APPSItemPatch.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSItemPatch_Private.h"
+
+NSString * const APPSItemPatchErrorDomain = @"APPSItemPatchErrorDomain";
+
+
+@interface APPSItemPatchOperation ()
+@property (nonatomic, readwrite) APPSItemPatchOperationType type;
+@property (nonatomic, readwrite, nullable) id<APPSIdentifiable> item;
+@property (nonatomic, readwrite) id<NSObject, NSCopying> identifier;
+@property (nonatomic, readwrite) NSUInteger index;
+@end
+
+@implementation APPSItemPatchOperation
+@end
+
+
+
+@interface APPSItemPatch ()
+@property (nonatomic, strong) NSMutableArray<APPSItemPatchOperation *> *mutableOperations;
+@end
+
+@implementation APPSItemPatch
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithBaseGeneration:(NSUInteger)generation
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _baseGeneration = generation;
+    _mutableOperations = [NSMutableArray array];
+    return self;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSUInteger)numberOfOperations
+{
+    return _mutableOperations.count;
+}
+
+
+- (NSArray<APPSItemPatchOperation *> *)operations
+{
+    return _mutableOperations;
+}
+
+
+- (void)insertItem:(id<APPSIdentifiable>)item atIndex:(NSUInteger)index
+{
+    NSParameterAssert(item != nil);
+    [self addOperationOfType:APPSItemPatchOperationTypeInsert item:item identifier:item.itemIdentifier index:index];
+}
+
+
+- (void)deleteItemWithIdentifier:(id<NSObject, NSCopying>)identifier
+{
+    NSParameterAssert(identifier != nil);
+    [self addOperationOfType:APPSItemPatchOperationTypeDelete item:nil identifier:identifier index:NSNotFound];
+}
+
+
+- (void)moveItemWithIdentifier:(id<NSObject, NSCopying>)identifier toIndex:(NSUInteger)index
+{
+    NSParameterAssert(identifier != nil);
+    [self addOperationOfType:APPSItemPatchOperationTypeMove item:nil identifier:identifier index:index];
+}
+
+
+- (void)updateItem:(id<APPSIdentifiable>)item
+{
+    NSParameterAssert(item != nil);
+    [self addOperationOfType:APPSItemPatchOperationTypeUpdate item:item identifier:item.itemIdentifier index:NSNotFound];
+}
+
+
+
+#pragma mark - Helper
+
+- (void)addOperationOfType:(APPSItemPatchOperationType)type item:(id<APPSIdentifiable>)item identifier:(id<NSObject, NSCopying>)identifier index:(NSUInteger)index
+{
+    APPSItemPatchOperation *operation = [[APPSItemPatchOperation alloc] init];
+    operation.type = type;
+    operation.item = item;
+    operation.identifier = identifier;
+    operation.index = index;
+    [_mutableOperations addObject:operation];
+}
+
+@end
@@ -0,0 +1,34 @@
+//
+//  APPSItemPatch_Private.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSItemPatch.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, APPSItemPatchOperationType) {
+    APPSItemPatchOperationTypeInsert,
+    APPSItemPatchOperationTypeDelete,
+    APPSItemPatchOperationTypeMove,
+    APPSItemPatchOperationTypeUpdate,
+};
+
+
+/// One recorded edit. item is nil for deletions and moves; index is unused for deletions and updates.
+@interface APPSItemPatchOperation : NSObject
+@property (nonatomic, readonly) APPSItemPatchOperationType type;
+@property (nonatomic, readonly, nullable) id<APPSIdentifiable> item;
+@property (nonatomic, readonly) id<NSObject, NSCopying> identifier;
+@property (nonatomic, readonly) NSUInteger index;
+@end
+
+
+@interface APPSItemPatch ()
+/// The operations, in the order they apply.
+@property (nonatomic, readonly) NSArray<APPSItemPatchOperation *> *operations;
+@end
+
+NS_ASSUME_NONNULL_END
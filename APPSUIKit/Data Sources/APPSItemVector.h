@@ -0,0 +1,41 @@
+//
+//  APPSItemVector.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An immutable array whose edits return new arrays that share most of their storage with the original.
+
+ Items are held in small chunks at the leaves of a balanced tree. Inserting, removing, replacing or moving items copies only the path to the affected chunk, so each edit is O(log n) however large the array, and the original is left untouched. Copying is free, because the array is immutable. An item vector can be read from any thread, so a snapshot can be taken on the main thread, edited on a background queue, and handed back.
+
+ Being an NSArray, it can be used wherever the data sources expect their items. Indexed access is O(log n) rather than O(1); enumeration walks the chunks directly.
+ */
+@interface APPSItemVector<ObjectType> : NSArray<ObjectType>
+
+/// Returns array itself if it's already an item vector, otherwise a vector holding its items.
++ (APPSItemVector<ObjectType> *)vectorWithArray:(NSArray<ObjectType> *)array;
+
+/// A new vector with objects inserted, in order, starting at index.
+- (APPSItemVector<ObjectType> *)vectorByInsertingObjects:(NSArray<ObjectType> *)objects atIndex:(NSUInteger)index;
+
+/// A new vector with objects added at the end.
+- (APPSItemVector<ObjectType> *)vectorByAppendingObjects:(NSArray<ObjectType> *)objects;
+
+/// A new vector without the objects in range.
+- (APPSItemVector<ObjectType> *)vectorByRemovingObjectsInRange:(NSRange)range;
+
+/// A new vector with the object at index replaced by object.
+- (APPSItemVector<ObjectType> *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(ObjectType)object;
+
+/// A new vector with the object at fromIndex moved so it ends up at toIndex.
+- (APPSItemVector<ObjectType> *)vectorByMovingObjectAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,350 @@
+//
+//  APPSItemVector.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSItemVector.h"
+
+/// The most items held by one leaf. Small enough that copying a leaf on edit is cheap, large enough that the tree stays shallow.
+static const NSUInteger APPSItemVectorLeafCapacity = 32;
+
+
+/// An immutable node of the tree: either a leaf holding a chunk of items, or a branch joining two subtrees. Nodes are never modified once made, so any number of vectors may share them.
+@interface APPSItemVectorNode : NSObject
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSUInteger height;
+@property (nonatomic, readonly, nullable) APPSItemVectorNode *left;
+@property (nonatomic, readonly, nullable) APPSItemVectorNode *right;
+@property (nonatomic, readonly, nullable) NSArray *items;
+@end
+
+@implementation APPSItemVectorNode
+
++ (instancetype)leafWithItems:(NSArray *)items
+{
+    APPSItemVectorNode *node = [[self alloc] init];
+    node->_items = [items copy];
+    node->_count = items.count;
+    return node;
+}
+
+
++ (instancetype)branchWithLeft:(APPSItemVectorNode *)left right:(APPSItemVectorNode *)right
+{
+    APPSItemVectorNode *node = [[self alloc] init];
+    node->_left = left;
+    node->_right = right;
+    node->_count = left.count + right.count;
+    node->_height = MAX(left.height, right.height) + 1;
+    return node;
+}
+
+@end
+
+
+#pragma mark - Tree Operations
+
+// The tree is AVL balanced: the heights of a branch's subtrees differ by at most one. Every edit is expressed as splits and joins, which rebuild only the nodes along one path.
+
+/// A branch of left and right, whose heights may differ by up to two, rotated back into balance.
+static APPSItemVectorNode *APPSItemVectorBalance(APPSItemVectorNode *left, APPSItemVectorNode *right)
+{
+    if (left.height > right.height + 1) {
+        if (left.left.height >= left.right.height)
+            return [APPSItemVectorNode branchWithLeft:left.left right:[APPSItemVectorNode branchWithLeft:left.right right:right]];
+
+        APPSItemVectorNode *pivot = left.right;
+        return [APPSItemVectorNode branchWithLeft:[APPSItemVectorNode branchWithLeft:left.left right:pivot.left]
+                                            right:[APPSItemVectorNode branchWithLeft:pivot.right right:right]];
+    }
+
+    if (right.height > left.height + 1) {
+        if (right.right.height >= right.left.height)
+            return [APPSItemVectorNode branchWithLeft:[APPSItemVectorNode branchWithLeft:left right:right.left] right:right.right];
+
+        APPSItemVectorNode *pivot = right.left;
+        return [APPSItemVectorNode branchWithLeft:[APPSItemVectorNode branchWithLeft:left right:pivot.left]
+                                            right:[APPSItemVectorNode branchWithLeft:pivot.right right:right.right]];
+    }
+
+    return [APPSItemVectorNode branchWithLeft:left right:right];
+}
+
+
+/// Every item of left followed by every item of right. Descends the taller tree's spine to a subtree of matching height, so it costs O(difference in height).
+static APPSItemVectorNode *APPSItemVectorJoin(APPSItemVectorNode *left, APPSItemVectorNode *right)
+{
+    if (!left.count)
+        return right.count ? right : nil;
+    if (!right.count)
+        return left;
+
+    // Neighbouring chunks left small by earlier splits are merged again here.
+    if (left.items && right.items && left.count + right.count <= APPSItemVectorLeafCapacity)
+        return [APPSItemVectorNode leafWithItems:[left.items arrayByAddingObjectsFromArray:right.items]];
+
+    if (left.height > right.height + 1)
+        return APPSItemVectorBalance(left.left, APPSItemVectorJoin(left.right, right));
+    if (right.height > left.height + 1)
+        return APPSItemVectorBalance(APPSItemVectorJoin(left, right.left), right.right);
+
+    return [APPSItemVectorNode branchWithLeft:left right:right];
+}
+
+
+/// Split node into its first index items and the rest.
+static void APPSItemVectorSplit(APPSItemVectorNode *node, NSUInteger index, APPSItemVectorNode * __strong *left, APPSItemVectorNode * __strong *right)
+{
+    if (!node || index == 0) {
+        *left = nil;
+        *right = node;
+        return;
+    }
+    if (index >= node.count) {
+        *left = node;
+        *right = nil;
+        return;
+    }
+
+    if (node.items) {
+        *left = [APPSItemVectorNode leafWithItems:[node.items subarrayWithRange:NSMakeRange(0, index)]];
+        *right = [APPSItemVectorNode leafWithItems:[node.items subarrayWithRange:NSMakeRange(index, node.count - index)]];
+        return;
+    }
+
+    NSUInteger leftCount = node.left.count;
+    APPSItemVectorNode *first, *second;
+    if (index <= leftCount) {
+        APPSItemVectorSplit(node.left, index, &first, &second);
+        *left = first;
+        *right = APPSItemVectorJoin(second, node.right);
+    }
+    else {
+        APPSItemVectorSplit(node.right, index - leftCount, &first, &second);
+        *left = APPSItemVectorJoin(node.left, first);
+        *right = second;
+    }
+}
+
+
+/// A balanced tree over the leaves in range, built bottom up in linear time.
+static APPSItemVectorNode *APPSItemVectorBuild(NSArray<APPSItemVectorNode *> *leaves, NSRange range)
+{
+    if (!range.length)
+        return nil;
+    if (range.length == 1)
+        return leaves[range.location];
+
+    NSUInteger half = range.length / 2;
+    return [APPSItemVectorNode branchWithLeft:APPSItemVectorBuild(leaves, NSMakeRange(range.location, half))
+                                        right:APPSItemVectorBuild(leaves, NSMakeRange(range.location + half, range.length - half))];
+}
+
+
+static APPSItemVectorNode *APPSItemVectorNodeFromArray(NSArray *array)
+{
+    NSUInteger count = array.count;
+    NSMutableArray<APPSItemVectorNode *> *leaves = [NSMutableArray arrayWithCapacity:(count + APPSItemVectorLeafCapacity - 1) / APPSItemVectorLeafCapacity];
+    for (NSUInteger location = 0; location < count; location += APPSItemVectorLeafCapacity) {
+        NSRange range = NSMakeRange(location, MIN(APPSItemVectorLeafCapacity, count - location));
+        [leaves addObject:[APPSItemVectorNode leafWithItems:[array subarrayWithRange:range]]];
+    }
+    return APPSItemVectorBuild(leaves, NSMakeRange(0, leaves.count));
+}
+
+
+static APPSItemVectorNode *APPSItemVectorReplace(APPSItemVectorNode *node, NSUInteger index, id object)
+{
+    if (node.items) {
+        NSMutableArray *items = [node.items mutableCopy];
+        items[index] = object;
+        return [APPSItemVectorNode leafWithItems:items];
+    }
+
+    NSUInteger leftCount = node.left.count;
+    if (index < leftCount)
+        return [APPSItemVectorNode branchWithLeft:APPSItemVectorReplace(node.left, index, object) right:node.right];
+    return [APPSItemVectorNode branchWithLeft:node.left right:APPSItemVectorReplace(node.right, index - leftCount, object)];
+}
+
+
+static void APPSItemVectorGetObjects(APPSItemVectorNode *node, __unsafe_unretained id *buffer, NSRange range)
+{
+    if (node.items) {
+        [node.items getObjects:buffer range:range];
+        return;
+    }
+
+    NSUInteger leftCount = node.left.count;
+    if (range.location < leftCount) {
+        NSUInteger length = MIN(range.length, leftCount - range.location);
+        APPSItemVectorGetObjects(node.left, buffer, NSMakeRange(range.location, length));
+        buffer += length;
+        range.location += length;
+        range.length -= length;
+    }
+    if (range.length)
+        APPSItemVectorGetObjects(node.right, buffer, NSMakeRange(range.location - leftCount, range.length));
+}
+
+
+
+@implementation APPSItemVector {
+    APPSItemVectorNode *_root;
+}
+
+
+#pragma mark - Instantiation
+
++ (APPSItemVector *)vectorWithArray:(NSArray *)array
+{
+    if ([array isKindOfClass:[APPSItemVector class]])
+        return (APPSItemVector *)array;
+
+    return [[APPSItemVector alloc] initWithRoot:APPSItemVectorNodeFromArray(array)];
+}
+
+
+- (instancetype)initWithRoot:(APPSItemVectorNode *)root
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _root = root;
+    return self;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithRoot:nil];
+}
+
+
+- (instancetype)initWithObjects:(const id _Nonnull [])objects count:(NSUInteger)count
+{
+    return [self initWithRoot:APPSItemVectorNodeFromArray([NSArray arrayWithObjects:objects count:count])];
+}
+
+
+
+#pragma mark - NSArray
+
+- (NSUInteger)count
+{
+    return _root.count;
+}
+
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _root.count)
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)_root.count - 1];
+
+    APPSItemVectorNode *node = _root;
+    while (!node.items) {
+        NSUInteger leftCount = node.left.count;
+        if (index < leftCount) {
+            node = node.left;
+        }
+        else {
+            index -= leftCount;
+            node = node.right;
+        }
+    }
+    return node.items[index];
+}
+
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _root.count)
+        [NSException raise:NSRangeException format:@"range %@ beyond bounds [0 .. %ld]", NSStringFromRange(range), (long)_root.count - 1];
+
+    if (range.length)
+        APPSItemVectorGetObjects(_root, objects, range);
+}
+
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(__unsafe_unretained id [])buffer count:(NSUInteger)length
+{
+    // The vector is immutable, so the mutation pointer only has to point at something that never changes.
+    NSUInteger index = state->state;
+    NSUInteger count = _root.count;
+    if (index >= count || !length)
+        return 0;
+
+    NSUInteger numberOfObjects = MIN(length, count - index);
+    APPSItemVectorGetObjects(_root, buffer, NSMakeRange(index, numberOfObjects));
+
+    state->state = index + numberOfObjects;
+    state->itemsPtr = buffer;
+    state->mutationsPtr = &state->extra[0];
+    return numberOfObjects;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (APPSItemVector *)vectorByInsertingObjects:(NSArray *)objects atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index <= _root.count);
+    if (!objects.count)
+        return self;
+
+    APPSItemVectorNode *left, *right;
+    APPSItemVectorSplit(_root, index, &left, &right);
+    APPSItemVectorNode *middle = APPSItemVectorNodeFromArray(objects);
+    return [[APPSItemVector alloc] initWithRoot:APPSItemVectorJoin(APPSItemVectorJoin(left, middle), right)];
+}
+
+
+- (APPSItemVector *)vectorByAppendingObjects:(NSArray *)objects
+{
+    return [self vectorByInsertingObjects:objects atIndex:_root.count];
+}
+
+
+- (APPSItemVector *)vectorByRemovingObjectsInRange:(NSRange)range
+{
+    NSParameterAssert(NSMaxRange(range) <= _root.count);
+    if (!range.length)
+        return self;
+
+    APPSItemVectorNode *left, *rest, *removed, *right;
+    APPSItemVectorSplit(_root, range.location, &left, &rest);
+    APPSItemVectorSplit(rest, range.length, &removed, &right);
+    return [[APPSItemVector alloc] initWithRoot:APPSItemVectorJoin(left, right)];
+}
+
+
+- (APPSItemVector *)vectorByReplacingObjectAtIndex:(NSUInteger)index withObject:(id)object
+{
+    NSParameterAssert(index < _root.count);
+    NSParameterAssert(object != nil);
+
+    return [[APPSItemVector alloc] initWithRoot:APPSItemVectorReplace(_root, index, object)];
+}
+
+
+- (APPSItemVector *)vectorByMovingObjectAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex
+{
+    NSParameterAssert(fromIndex < _root.count && toIndex < _root.count);
+    if (fromIndex == toIndex)
+        return self;
+
+    id object = self[fromIndex];
+    return [[self vectorByRemovingObjectsInRange:NSMakeRange(fromIndex, 1)] vectorByInsertingObjects:@[object] atIndex:toIndex];
+}
+
+@end
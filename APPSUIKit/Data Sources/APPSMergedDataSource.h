@@ -0,0 +1,40 @@
+//
+//  APPSMergedDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A data source that interleaves the items of several sorted child data sources into one ordered section, such as feeds merged by timestamp.
+
+ Each child presents a single section already sorted by the same comparator; an APPSSortedDataSource is a natural fit. The children are merged once with a k-way merge. After that, the merged order is kept in a balanced tree that counts each child's rows in every subtree, so an item inserted into, removed from or moved within a child maps to a single row change here in O(log n), without merging again. Children continue to provide their own cells.
+
+ Load content messages are sent to every child. Placeholders shown by children are not surfaced; the merged section presents its own.
+ */
+@interface APPSMergedDataSource : APPSDataSource
+
+/// Create a merged data source ordering items with comparator.
+- (instancetype)initWithComparator:(NSComparator)comparator NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The comparator the children are sorted by.
+@property (nonatomic, copy, readonly) NSComparator comparator;
+
+/// The child data sources, in the order they were added.
+@property (nonatomic, copy, readonly) NSArray<APPSDataSource *> *dataSources;
+
+/// Add a sorted, single-section child data source.
+- (void)addDataSource:(APPSDataSource *)dataSource;
+
+/// Remove a child data source.
+- (void)removeDataSource:(APPSDataSource *)dataSource;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,943 @@
+//
+//  APPSMergedDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource_Private.h"
+#import "APPSMergedDataSource.h"
+
+/// A node in the merge tree: one merged row, owned by the child at index child. counts[c] is the number of rows from child c in this subtree.
+typedef struct APPSMergeNode APPSMergeNode;
+struct APPSMergeNode {
+    APPSMergeNode *left;
+    APPSMergeNode *right;
+    uint32_t priority;
+    NSUInteger size;
+    NSUInteger child;
+    NSUInteger counts[];
+};
+
+
+#pragma mark - Merge Tree
+
+// The merged rows are kept in a treap ordered by position rather than by key: a node's position is the size of everything to its left. Random priorities keep it balanced in expectation, and each node carries per-child row counts so a child's local row and the merged row convert into each other in one descent.
+
+static inline NSUInteger APPSMergeTreeSize(const APPSMergeNode *node)
+{
+    return node ? node->size : 0;
+}
+
+
+static inline NSUInteger APPSMergeTreeCount(const APPSMergeNode *node, NSUInteger child)
+{
+    return node ? node->counts[child] : 0;
+}
+
+
+static APPSMergeNode *APPSMergeNodeCreate(NSUInteger child, NSUInteger numberOfChildren)
+{
+    APPSMergeNode *node = calloc(1, sizeof(APPSMergeNode) + numberOfChildren * sizeof(NSUInteger));
+    node->priority = arc4random();
+    node->size = 1;
+    node->child = child;
+    node->counts[child] = 1;
+    return node;
+}
+
+
+static void APPSMergeNodeUpdate(APPSMergeNode *node, NSUInteger numberOfChildren)
+{
+    node->size = 1 + APPSMergeTreeSize(node->left) + APPSMergeTreeSize(node->right);
+    for (NSUInteger child = 0; child < numberOfChildren; ++child)
+        node->counts[child] = APPSMergeTreeCount(node->left, child) + APPSMergeTreeCount(node->right, child);
+    node->counts[node->child] += 1;
+}
+
+
+static void APPSMergeTreeFree(APPSMergeNode *node)
+{
+    if (!node)
+        return;
+
+    APPSMergeTreeFree(node->left);
+    APPSMergeTreeFree(node->right);
+    free(node);
+}
+
+
+/// Split node into the first position rows and the rest.
+static void APPSMergeTreeSplit(APPSMergeNode *node, NSUInteger position, NSUInteger numberOfChildren, APPSMergeNode **left, APPSMergeNode **right)
+{
+    if (!node) {
+        *left = *right = NULL;
+        return;
+    }
+
+    NSUInteger leftSize = APPSMergeTreeSize(node->left);
+    if (position <= leftSize) {
+        APPSMergeTreeSplit(node->left, position, numberOfChildren, left, &node->left);
+        *right = node;
+    }
+    else {
+        APPSMergeTreeSplit(node->right, position - leftSize - 1, numberOfChildren, &node->right, right);
+        *left = node;
+    }
+    APPSMergeNodeUpdate(node, numberOfChildren);
+}
+
+
+/// Join two trees, with every row of left before every row of right.
+static APPSMergeNode *APPSMergeTreeJoin(APPSMergeNode *left, APPSMergeNode *right, NSUInteger numberOfChildren)
+{
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->right = APPSMergeTreeJoin(left->right, right, numberOfChildren);
+        APPSMergeNodeUpdate(left, numberOfChildren);
+        return left;
+    }
+
+    right->left = APPSMergeTreeJoin(left, right->left, numberOfChildren);
+    APPSMergeNodeUpdate(right, numberOfChildren);
+    return right;
+}
+
+
+static APPSMergeNode *APPSMergeTreeNodeAtPosition(APPSMergeNode *node, NSUInteger position)
+{
+    while (node) {
+        NSUInteger leftSize = APPSMergeTreeSize(node->left);
+        if (position < leftSize) {
+            node = node->left;
+        }
+        else if (position == leftSize) {
+            return node;
+        }
+        else {
+            position -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+
+/// The number of rows from child among the first position rows.
+static NSUInteger APPSMergeTreeRank(const APPSMergeNode *node, NSUInteger position, NSUInteger child)
+{
+    NSUInteger rank = 0;
+    while (node) {
+        NSUInteger leftSize = APPSMergeTreeSize(node->left);
+        if (position <= leftSize) {
+            node = node->left;
+        }
+        else {
+            rank += APPSMergeTreeCount(node->left, child) + (node->child == child);
+            position -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    return rank;
+}
+
+
+/// The merged position of child's row at localRow, or NSNotFound.
+static NSUInteger APPSMergeTreePositionForLocalRow(const APPSMergeNode *node, NSUInteger child, NSUInteger localRow)
+{
+    NSUInteger position = 0;
+    while (node) {
+        NSUInteger leftCount = APPSMergeTreeCount(node->left, child);
+        if (localRow < leftCount) {
+            node = node->left;
+            continue;
+        }
+
+        localRow -= leftCount;
+        NSUInteger leftSize = APPSMergeTreeSize(node->left);
+        if (node->child == child) {
+            if (!localRow)
+                return position + leftSize;
+            localRow -= 1;
+        }
+        position += leftSize + 1;
+        node = node->right;
+    }
+    return NSNotFound;
+}
+
+
+
+/// The merged position of the index-th row that isn't from child.
+static NSUInteger APPSMergeTreePositionForOtherRow(const APPSMergeNode *node, NSUInteger child, NSUInteger index)
+{
+    NSUInteger position = 0;
+    while (node) {
+        NSUInteger leftSize = APPSMergeTreeSize(node->left);
+        NSUInteger leftOthers = leftSize - APPSMergeTreeCount(node->left, child);
+        if (index < leftOthers) {
+            node = node->left;
+            continue;
+        }
+
+        index -= leftOthers;
+        if (node->child != child) {
+            if (!index)
+                return position + leftSize;
+            index -= 1;
+        }
+        position += leftSize + 1;
+        node = node->right;
+    }
+    return NSNotFound;
+}
+
+
+/// Where a row that stays put within its data source ends up after a batch that removes leavingRows and inserts arrivingRows around it.
+static NSUInteger APPSRowAfterBatch(NSUInteger row, NSIndexSet *leavingRows, NSIndexSet *arrivingRows)
+{
+    NSUInteger newRow = row - [leavingRows countOfIndexesInRange:NSMakeRange(0, row)];
+    for (NSUInteger arrivingRow = arrivingRows.firstIndex; arrivingRow != NSNotFound && arrivingRow <= newRow; arrivingRow = [arrivingRows indexGreaterThanIndex:arrivingRow])
+        newRow++;
+    return newRow;
+}
+
+/// One child's item changes within a batch update, in the child's local rows: removals, move sources and refreshes in the coordinates from before the batch, insertions, move destinations and reconfigurations in those after it.
+@interface APPSMergedChildChanges : NSObject
+@property (nonatomic) NSUInteger child;
+@property (nonatomic, strong) NSMutableIndexSet *removedRows;
+@property (nonatomic, strong) NSMutableIndexSet *insertedRows;
+@property (nonatomic, strong) NSMutableIndexSet *refreshedRows;
+@property (nonatomic, strong) NSMutableIndexSet *reconfiguredRows;
+/// Pairs of @[fromRow, toRow].
+@property (nonatomic, strong) NSMutableArray<NSArray<NSNumber *> *> *moves;
+@end
+
+@implementation APPSMergedChildChanges
+
+- (instancetype)initWithChild:(NSUInteger)child
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _child = child;
+    _removedRows = [NSMutableIndexSet indexSet];
+    _insertedRows = [NSMutableIndexSet indexSet];
+    _refreshedRows = [NSMutableIndexSet indexSet];
+    _reconfiguredRows = [NSMutableIndexSet indexSet];
+    _moves = [NSMutableArray array];
+    return self;
+}
+
+@end
+
+
+
+@interface APPSMergedDataSource () <APPSDataSourceDelegate>
+@property (nonatomic, copy) NSComparator comparator;
+@property (nonatomic, strong) NSMutableArray<APPSDataSource *> *mutableDataSources;
+@end
+
+@implementation APPSMergedDataSource {
+    APPSMergeNode *_root;
+    /// How deeply nested we are in children's batch updates. Their item changes are staged until the outermost one finishes.
+    NSUInteger _batchUpdateDepth;
+    APPSMergedChildChanges *_stagedChanges;
+    /// Set when the staged changes can't be translated row by row, and the merged rows are rebuilt instead.
+    BOOL _mergedRowsNeedRebuild;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithComparator:(NSComparator)comparator
+{
+    NSParameterAssert(comparator != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _comparator = [comparator copy];
+    _mutableDataSources = [NSMutableArray array];
+    return self;
+}
+
+
+- (void)dealloc
+{
+    APPSMergeTreeFree(_root);
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSArray<APPSDataSource *> *)dataSources
+{
+    return [_mutableDataSources copy];
+}
+
+
+- (void)addDataSource:(APPSDataSource *)dataSource
+{
+    NSParameterAssert(dataSource != nil);
+    NSAssert(![_mutableDataSources containsObject:dataSource], @"tried to add data source more than once: %@", dataSource);
+    NSAssert(dataSource.numberOfSections == 1, @"A merged data source's children must have exactly one section: %@", dataSource);
+
+    dataSource.delegate = self;
+    [_mutableDataSources addObject:dataSource];
+
+    // Per-node counts are sized by the number of children, so the tree is rebuilt whenever that changes.
+    [self setNeedsRebuildMergedRows];
+}
+
+
+- (void)removeDataSource:(APPSDataSource *)dataSource
+{
+    NSAssert([_mutableDataSources containsObject:dataSource], @"Data source not found in merged data source");
+
+    [_mutableDataSources removeObjectIdenticalTo:dataSource];
+    dataSource.delegate = nil;
+
+    [self setNeedsRebuildMergedRows];
+}
+
+
+
+#pragma mark - APPSDataSource
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)sectionIndex
+{
+    return APPSMergeTreeSize(_root);
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    return localIndexPath ? [_mutableDataSources[child] itemAtIndexPath:localIndexPath] : nil;
+}
+
+
+- (NSArray *)indexPathsForItem:(id)item
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    [_mutableDataSources enumerateObjectsUsingBlock:^(APPSDataSource *dataSource, NSUInteger child, BOOL *stop) {
+        for (NSIndexPath *localIndexPath in [dataSource indexPathsForItem:item]) {
+            NSUInteger position = APPSMergeTreePositionForLocalRow(_root, child, localIndexPath.row);
+            if (position != NSNotFound)
+                [indexPaths addObject:[NSIndexPath indexPathForRow:position inSection:0]];
+        }
+    }];
+    return indexPaths;
+}
+
+
+- (void)removeItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    // The child reports the removal back to us, which is when the row disappears.
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    if (localIndexPath)
+        [_mutableDataSources[child] removeItemAtIndexPath:localIndexPath];
+}
+
+
+- (void)didBecomeActive
+{
+    [super didBecomeActive];
+    for (APPSDataSource *dataSource in _mutableDataSources)
+        [dataSource didBecomeActive];
+}
+
+
+- (void)willResignActive
+{
+    [super willResignActive];
+    for (APPSDataSource *dataSource in _mutableDataSources)
+        [dataSource willResignActive];
+}
+
+
+- (void)registerReusableViewsWithTableView:(UITableView *)tableView
+{
+    [super registerReusableViewsWithTableView:tableView];
+    for (APPSDataSource *dataSource in _mutableDataSources)
+        [dataSource registerReusableViewsWithTableView:tableView];
+}
+
+
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self enumerateLocalIndexPathsForIndexPaths:indexPaths withBlock:^(APPSDataSource *dataSource, NSArray *localIndexPaths) {
+        [dataSource prefetchRowsAtIndexPaths:localIndexPaths];
+    }];
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [self enumerateLocalIndexPathsForIndexPaths:indexPaths withBlock:^(APPSDataSource *dataSource, NSArray *localIndexPaths) {
+        [dataSource cancelPrefetchingForRowsAtIndexPaths:localIndexPaths];
+    }];
+}
+
+
+- (NSString *)heightDeterminingTextForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    return localIndexPath ? [_mutableDataSources[child] heightDeterminingTextForItemAtIndexPath:localIndexPath] : nil;
+}
+
+
+- (APPSTextLayoutSpec *)textLayoutSpecForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    return localIndexPath ? [_mutableDataSources[child] textLayoutSpecForItemAtIndexPath:localIndexPath] : nil;
+}
+
+
+
+#pragma mark - Protocol: APPSContentLoading
+
+- (void)endLoadingContentWithState:(NSString *)state error:(NSError *)error update:(dispatch_block_t)update
+{
+    if (![APPSLoadStateContentLoaded isEqualToString:state]) {
+        [super endLoadingContentWithState:state error:error update:update];
+        return;
+    }
+
+    // As with composed data sources, wait for the children that are still loading before settling on a final state.
+    dispatch_group_t loadingGroup = dispatch_group_create();
+    for (APPSDataSource *dataSource in _mutableDataSources) {
+        NSString *loadingState = dataSource.loadingState;
+        if (![APPSLoadStateLoadingContent isEqualToString:loadingState] && ![APPSLoadStateRefreshingContent isEqualToString:loadingState])
+            continue;
+
+        dispatch_group_enter(loadingGroup);
+        [dataSource whenLoaded:^{
+            dispatch_group_leave(loadingGroup);
+        }];
+    }
+
+    dispatch_group_notify(loadingGroup, dispatch_get_main_queue(), ^{
+        // The children share one section, so there's no content unless at least one of them has rows.
+        NSString *finalState = APPSMergeTreeSize(_root) ? state : APPSLoadStateNoContent;
+        [super endLoadingContentWithState:finalState error:error update:update];
+    });
+}
+
+
+- (void)beginLoadingContentWithProgress:(APPSLoadingProgress *)progress
+{
+    for (APPSDataSource *dataSource in _mutableDataSources)
+        [dataSource loadContent];
+
+    [self loadContentWithProgress:progress];
+}
+
+
+- (void)resetContent
+{
+    [super resetContent];
+    for (APPSDataSource *dataSource in _mutableDataSources)
+        [dataSource resetContent];
+}
+
+
+
+#pragma mark - Protocol: UITableViewDataSource
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    return [_mutableDataSources[child] tableView:tableView cellForRowAtIndexPath:localIndexPath];
+}
+
+
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    return localIndexPath ? [_mutableDataSources[child] tableView:tableView reconfigureCell:cell forRowAtIndexPath:localIndexPath] : NO;
+}
+
+
+- (BOOL)tableView:(UITableView *)tableView canEditRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger child;
+    NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+    APPSDataSource *dataSource = localIndexPath ? _mutableDataSources[child] : nil;
+    if (dataSource && [dataSource respondsToSelector:@selector(tableView:canEditRowAtIndexPath:)]) {
+        return [dataSource tableView:tableView canEditRowAtIndexPath:localIndexPath];
+    }
+    else {
+        return YES;
+    }
+}
+
+
+
+#pragma mark - Protocol: APPSDataSourceDelegate
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    APPSMergedChildChanges *changes = [self stagedChangesForDataSource:dataSource];
+    for (NSIndexPath *localIndexPath in indexPaths)
+        [changes.insertedRows addIndex:localIndexPath.row];
+
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    APPSMergedChildChanges *changes = [self stagedChangesForDataSource:dataSource];
+    for (NSIndexPath *localIndexPath in indexPaths)
+        [changes.removedRows addIndex:localIndexPath.row];
+
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    APPSMergedChildChanges *changes = [self stagedChangesForDataSource:dataSource];
+    for (NSIndexPath *localIndexPath in indexPaths)
+        [changes.refreshedRows addIndex:localIndexPath.row];
+
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    APPSMergedChildChanges *changes = [self stagedChangesForDataSource:dataSource];
+    for (NSIndexPath *localIndexPath in indexPaths)
+        [changes.reconfiguredRows addIndex:localIndexPath.row];
+
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath
+{
+    APPSMergedChildChanges *changes = [self stagedChangesForDataSource:dataSource];
+    [changes.moves addObject:@[@(fromIndexPath.row), @(newIndexPath.row)]];
+
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertSections:(NSIndexSet *)sections
+{
+    [self setNeedsRebuildMergedRows];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveSections:(NSIndexSet *)sections
+{
+    [self setNeedsRebuildMergedRows];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshSections:(NSIndexSet *)sections
+{
+    [self setNeedsRebuildMergedRows];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveSection:(NSInteger)section toSection:(NSInteger)newSection
+{
+    [self setNeedsRebuildMergedRows];
+}
+
+
+- (void)dataSourceDidReloadData:(APPSDataSource *)dataSource
+{
+    _stagedChanges = nil;
+    _mergedRowsNeedRebuild = NO;
+
+    [self rebuildMergedRowsWithoutNotifying];
+    [self notifyDidReloadData];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource performBatchUpdate:(dispatch_block_t)update complete:(dispatch_block_t)complete
+{
+    // A child's batch describes its changes against its rows before and after the whole batch, so they're translated together once it's done.
+    [self performUpdate:^{
+        _batchUpdateDepth++;
+        if (update)
+            update();
+        if (--_batchUpdateDepth == 0)
+            [self applyStagedChanges];
+    } complete:complete];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didPresentActivityIndicatorForSections:(NSIndexSet *)sections
+{
+    [self presentActivityIndicatorForSections:[NSIndexSet indexSetWithIndex:0]];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didPresentPlaceholderForSections:(NSIndexSet *)sections
+{
+    // The merged section's placeholder reflects all the children together.
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didDismissPlaceholderForSections:(NSIndexSet *)sections
+{
+}
+
+
+
+#pragma mark - Merging
+
+- (APPSMergedChildChanges *)stagedChangesForDataSource:(APPSDataSource *)dataSource
+{
+    NSUInteger child = [_mutableDataSources indexOfObjectIdenticalTo:dataSource];
+
+    if (!_stagedChanges)
+        _stagedChanges = [[APPSMergedChildChanges alloc] initWithChild:child];
+    // Two children changing in one batch would each need the tree as it was before the other's changes.
+    else if (_stagedChanges.child != child)
+        _mergedRowsNeedRebuild = YES;
+
+    return _stagedChanges;
+}
+
+
+- (void)setNeedsRebuildMergedRows
+{
+    _mergedRowsNeedRebuild = YES;
+    [self applyStagedChangesUnlessBatching];
+}
+
+
+- (void)applyStagedChangesUnlessBatching
+{
+    if (!_batchUpdateDepth)
+        [self applyStagedChanges];
+}
+
+
+/// Translate the staged changes of one child into merged rows, all at once: every old position is found before the tree changes, and every new one after.
+- (void)applyStagedChanges
+{
+    APPSMergedChildChanges *changes = _stagedChanges;
+    _stagedChanges = nil;
+
+    if (_mergedRowsNeedRebuild) {
+        _mergedRowsNeedRebuild = NO;
+        [self rebuildMergedRows];
+        return;
+    }
+
+    if (!changes)
+        return;
+
+    NSUInteger child = changes.child;
+    NSMutableIndexSet *takenOutPositions = [NSMutableIndexSet indexSet];
+    NSMutableArray *removedIndexPaths = [NSMutableArray array];
+    NSMutableArray *refreshedIndexPaths = [NSMutableArray array];
+    NSMutableArray *movedFromPositions = [NSMutableArray array];
+    NSMutableIndexSet *putBackRows = [changes.insertedRows mutableCopy];
+    NSMutableIndexSet *reinsertedRows = [NSMutableIndexSet indexSet];
+
+    NSMutableIndexSet *leavingRows = [changes.removedRows mutableCopy];
+    NSMutableIndexSet *arrivingRows = [changes.insertedRows mutableCopy];
+    for (NSArray<NSNumber *> *move in changes.moves) {
+        [leavingRows addIndex:move[0].unsignedIntegerValue];
+        [arrivingRows addIndex:move[1].unsignedIntegerValue];
+    }
+
+    // Old coordinates first, while the tree still matches the child's rows from before the batch.
+    [changes.removedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        NSUInteger position = APPSMergeTreePositionForLocalRow(_root, child, row);
+        if (position == NSNotFound)
+            return;
+
+        [takenOutPositions addIndex:position];
+        [removedIndexPaths addObject:[NSIndexPath indexPathForRow:position inSection:0]];
+    }];
+
+    // A refreshed row keeps its place in the child, but a new sort key can carry it past rows of the other children. Those are taken out and merged back in instead, since a row can't be refreshed and moved in one batch.
+    [changes.refreshedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        NSUInteger position = APPSMergeTreePositionForLocalRow(_root, child, row);
+        if (position == NSNotFound)
+            return;
+
+        NSUInteger newRow = APPSRowAfterBatch(row, leavingRows, arrivingRows);
+        if ([self localRow:newRow child:child fitsAtPosition:position]) {
+            [refreshedIndexPaths addObject:[NSIndexPath indexPathForRow:position inSection:0]];
+            return;
+        }
+
+        [takenOutPositions addIndex:position];
+        [removedIndexPaths addObject:[NSIndexPath indexPathForRow:position inSection:0]];
+        [putBackRows addIndex:newRow];
+        [reinsertedRows addIndex:newRow];
+    }];
+
+    for (NSArray<NSNumber *> *move in changes.moves) {
+        NSUInteger position = APPSMergeTreePositionForLocalRow(_root, child, move[0].unsignedIntegerValue);
+        [movedFromPositions addObject:@(position)];
+        if (position == NSNotFound)
+            continue;
+
+        [takenOutPositions addIndex:position];
+        [putBackRows addIndex:move[1].unsignedIntegerValue];
+    }
+
+    // Take out the removed, moved and re-sorted rows, last first so the earlier positions hold. What's left of the child is its unchanged rows, still in order.
+    [takenOutPositions enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger position, BOOL *stop) {
+        [self removeNodeAtPosition:position];
+    }];
+
+    // Merge the rest back in by their new local rows, in ascending order so each one's child neighbours are already in place. A later row never lands before an earlier one, so these positions are final.
+    NSMutableDictionary<NSNumber *, NSNumber *> *newPositionsByRow = [NSMutableDictionary dictionary];
+    [putBackRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        NSUInteger position = [self insertionPositionForLocalRow:row child:child];
+        [self insertNodeForChild:child atPosition:position];
+        newPositionsByRow[@(row)] = @(position);
+    }];
+
+    [reinsertedRows addIndexes:changes.insertedRows];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:reinsertedRows.count];
+    [reinsertedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:newPositionsByRow[@(row)].integerValue inSection:0]];
+    }];
+
+    if (removedIndexPaths.count)
+        [self notifyItemsRemovedAtIndexPaths:removedIndexPaths];
+    if (insertedIndexPaths.count)
+        [self notifyItemsInsertedAtIndexPaths:insertedIndexPaths];
+    if (refreshedIndexPaths.count)
+        [self notifyItemsRefreshedAtIndexPaths:refreshedIndexPaths];
+
+    [changes.moves enumerateObjectsUsingBlock:^(NSArray<NSNumber *> *move, NSUInteger index, BOOL *stop) {
+        NSUInteger fromPosition = movedFromPositions[index].unsignedIntegerValue;
+        if (fromPosition == NSNotFound)
+            return;
+
+        NSUInteger toPosition = newPositionsByRow[move[1]].unsignedIntegerValue;
+        [self notifyItemMovedFromIndexPath:[NSIndexPath indexPathForRow:fromPosition inSection:0] toIndexPaths:[NSIndexPath indexPathForRow:toPosition inSection:0]];
+    }];
+
+    // Reconfigured rows are already in the coordinates after the batch, which the tree now matches.
+    NSMutableArray *reconfiguredIndexPaths = [NSMutableArray arrayWithCapacity:changes.reconfiguredRows.count];
+    [changes.reconfiguredRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        NSUInteger position = APPSMergeTreePositionForLocalRow(_root, child, row);
+        if (position != NSNotFound)
+            [reconfiguredIndexPaths addObject:[NSIndexPath indexPathForRow:position inSection:0]];
+    }];
+    if (reconfiguredIndexPaths.count)
+        [self notifyItemsReconfiguredAtIndexPaths:reconfiguredIndexPaths];
+}
+
+
+- (void)rebuildMergedRows
+{
+    [self rebuildMergedRowsWithoutNotifying];
+    [self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
+}
+
+
+/// Merge every child from scratch with a k-way merge, ties going to the earlier child.
+- (void)rebuildMergedRowsWithoutNotifying
+{
+    APPSMergeTreeFree(_root);
+    _root = NULL;
+
+    NSUInteger numberOfChildren = _mutableDataSources.count;
+    if (!numberOfChildren)
+        return;
+
+    NSMutableArray<NSArray *> *itemsByChild = [NSMutableArray arrayWithCapacity:numberOfChildren];
+    for (APPSDataSource *dataSource in _mutableDataSources) {
+        NSInteger numberOfRows = [dataSource numberOfRowsInSection:0];
+        NSMutableArray *items = [NSMutableArray arrayWithCapacity:numberOfRows];
+        for (NSInteger row = 0; row < numberOfRows; ++row)
+            [items addObject:[dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]] ?: [NSNull null]];
+        [itemsByChild addObject:items];
+    }
+
+    // A binary heap of child indexes, ordered by each child's next unmerged item.
+    NSUInteger *nextRows = calloc(numberOfChildren, sizeof(NSUInteger));
+    NSUInteger *heap = malloc(numberOfChildren * sizeof(NSUInteger));
+    __block NSUInteger heapCount = 0;
+
+    NSComparator comparator = _comparator;
+    BOOL (^precedes)(NSUInteger, NSUInteger) = ^BOOL(NSUInteger a, NSUInteger b) {
+        NSComparisonResult result = comparator(itemsByChild[a][nextRows[a]], itemsByChild[b][nextRows[b]]);
+        return result == NSOrderedAscending || (result == NSOrderedSame && a < b);
+    };
+
+    void (^siftDown)(NSUInteger) = ^(NSUInteger index) {
+        for (;;) {
+            NSUInteger smallest = index;
+            NSUInteger left = 2 * index + 1;
+            NSUInteger right = left + 1;
+            if (left < heapCount && precedes(heap[left], heap[smallest]))
+                smallest = left;
+            if (right < heapCount && precedes(heap[right], heap[smallest]))
+                smallest = right;
+            if (smallest == index)
+                return;
+
+            NSUInteger swap = heap[index];
+            heap[index] = heap[smallest];
+            heap[smallest] = swap;
+            index = smallest;
+        }
+    };
+
+    for (NSUInteger child = 0; child < numberOfChildren; ++child) {
+        if (itemsByChild[child].count)
+            heap[heapCount++] = child;
+    }
+    for (NSUInteger index = heapCount / 2; index-- > 0; )
+        siftDown(index);
+
+    APPSMergeNode *root = NULL;
+    while (heapCount) {
+        NSUInteger child = heap[0];
+        root = APPSMergeTreeJoin(root, APPSMergeNodeCreate(child, numberOfChildren), numberOfChildren);
+
+        if (++nextRows[child] == itemsByChild[child].count)
+            heap[0] = heap[--heapCount];
+        siftDown(0);
+    }
+
+    free(heap);
+    free(nextRows);
+    _root = root;
+}
+
+
+/// Where child's new row at localRow belongs. The tree must not contain that row yet.
+- (NSUInteger)insertionPositionForLocalRow:(NSUInteger)localRow child:(NSUInteger)child
+{
+    NSUInteger lowerBound = 0;
+    if (localRow > 0)
+        lowerBound = APPSMergeTreePositionForLocalRow(_root, child, localRow - 1) + 1;
+
+    NSUInteger upperBound = APPSMergeTreeSize(_root);
+    if (localRow < APPSMergeTreeCount(_root, child))
+        upperBound = APPSMergeTreePositionForLocalRow(_root, child, localRow);
+
+    id item = [_mutableDataSources[child] itemAtIndexPath:[NSIndexPath indexPathForRow:localRow inSection:0]];
+
+    // Binary search the other children's rows in between for the first one that sorts after the new item.
+    while (lowerBound < upperBound) {
+        NSUInteger middle = lowerBound + (upperBound - lowerBound) / 2;
+        if (_comparator([self itemAtPosition:middle], item) == NSOrderedDescending)
+            upperBound = middle;
+        else
+            lowerBound = middle + 1;
+    }
+    return lowerBound;
+}
+
+
+/// Whether child's item at localRow still sorts between the other children's rows on either side of position.
+- (BOOL)localRow:(NSUInteger)localRow child:(NSUInteger)child fitsAtPosition:(NSUInteger)position
+{
+    id item = [_mutableDataSources[child] itemAtIndexPath:[NSIndexPath indexPathForRow:localRow inSection:0]];
+    NSUInteger otherRowsBefore = position - APPSMergeTreeRank(_root, position, child);
+    NSUInteger otherRows = APPSMergeTreeSize(_root) - APPSMergeTreeCount(_root, child);
+
+    if (otherRowsBefore > 0 && _comparator([self itemAtPosition:APPSMergeTreePositionForOtherRow(_root, child, otherRowsBefore - 1)], item) == NSOrderedDescending)
+        return NO;
+    if (otherRowsBefore < otherRows && _comparator(item, [self itemAtPosition:APPSMergeTreePositionForOtherRow(_root, child, otherRowsBefore)]) == NSOrderedDescending)
+        return NO;
+    return YES;
+}
+
+
+- (id)itemAtPosition:(NSUInteger)position
+{
+    APPSMergeNode *node = APPSMergeTreeNodeAtPosition(_root, position);
+    NSUInteger localRow = APPSMergeTreeRank(_root, position, node->child);
+    return [_mutableDataSources[node->child] itemAtIndexPath:[NSIndexPath indexPathForRow:localRow inSection:0]];
+}
+
+
+- (void)insertNodeForChild:(NSUInteger)child atPosition:(NSUInteger)position
+{
+    NSUInteger numberOfChildren = _mutableDataSources.count;
+    APPSMergeNode *left, *right;
+    APPSMergeTreeSplit(_root, position, numberOfChildren, &left, &right);
+    left = APPSMergeTreeJoin(left, APPSMergeNodeCreate(child, numberOfChildren), numberOfChildren);
+    _root = APPSMergeTreeJoin(left, right, numberOfChildren);
+}
+
+
+- (void)removeNodeAtPosition:(NSUInteger)position
+{
+    NSUInteger numberOfChildren = _mutableDataSources.count;
+    APPSMergeNode *left, *middle, *right;
+    APPSMergeTreeSplit(_root, position, numberOfChildren, &left, &right);
+    APPSMergeTreeSplit(right, 1, numberOfChildren, &middle, &right);
+    APPSMergeTreeFree(middle);
+    _root = APPSMergeTreeJoin(left, right, numberOfChildren);
+}
+
+
+
+#pragma mark - Helper
+
+- (NSIndexPath *)localIndexPathForIndexPath:(NSIndexPath *)indexPath child:(NSUInteger *)child
+{
+    APPSMergeNode *node = APPSMergeTreeNodeAtPosition(_root, indexPath.row);
+    if (!node)
+        return nil;
+
+    *child = node->child;
+    return [NSIndexPath indexPathForRow:APPSMergeTreeRank(_root, indexPath.row, node->child) inSection:0];
+}
+
+
+/// Partition index paths by child, calling the block once per child with its sorted local index paths.
+- (void)enumerateLocalIndexPathsForIndexPaths:(NSArray<NSIndexPath *> *)indexPaths withBlock:(void(^)(APPSDataSource *dataSource, NSArray *localIndexPaths))block
+{
+    NSMutableDictionary<NSNumber *, NSMutableArray *> *localIndexPathsByChild = [NSMutableDictionary dictionary];
+
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSUInteger child;
+        NSIndexPath *localIndexPath = [self localIndexPathForIndexPath:indexPath child:&child];
+        if (!localIndexPath)
+            continue;
+
+        NSMutableArray *localIndexPaths = localIndexPathsByChild[@(child)];
+        if (!localIndexPaths) {
+            localIndexPaths = [NSMutableArray array];
+            localIndexPathsByChild[@(child)] = localIndexPaths;
+        }
+        [localIndexPaths addObject:localIndexPath];
+    }
+
+    [_mutableDataSources enumerateObjectsUsingBlock:^(APPSDataSource *dataSource, NSUInteger child, BOOL *stop) {
+        NSMutableArray *localIndexPaths = localIndexPathsByChild[@(child)];
+        if (!localIndexPaths)
+            return;
+
+        [localIndexPaths sortUsingSelector:@selector(compare:)];
+        block(dataSource, localIndexPaths);
+    }];
+}
+
+@end
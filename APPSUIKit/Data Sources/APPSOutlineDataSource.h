@@ -0,0 +1,65 @@
+//
+//  APPSOutlineDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns the children of item, or nil for a leaf.
+typedef NSArray * __nullable (^APPSOutlineChildrenBlock)(id item);
+
+
+/**
+ A single-section data source presenting a tree of expandable items, such as folders or an org chart.
+
+ The tree is walked once when the root items are set. After that, each row's visibility is tracked in a Fenwick tree laid over the items in depth-first order, so finding the item for a row, or the row for an item, takes O(log n). Expanding or collapsing an item touches only the rows it reveals or hides, and notifies them as one contiguous range.
+
+ Subclasses provide cells by overriding -tableView:cellForRowAtIndexPath:, typically indenting by -depthOfItemAtIndexPath:. Items must be unique within the tree.
+ */
+@interface APPSOutlineDataSource : APPSDataSource
+
+/// Create an outline whose children are supplied by childrenBlock.
+- (instancetype)initWithChildrenBlock:(APPSOutlineChildrenBlock)childrenBlock NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The top-level items. Setting this walks the whole tree and refreshes the section; items that were expanded before stay expanded. Must be called within -performUpdate:.
+@property (nonatomic, copy) NSArray *rootItems;
+
+/// The number of items in the tree, visible or not.
+@property (nonatomic, readonly) NSUInteger numberOfItems;
+
+/// Is item expanded? Items start out collapsed.
+- (BOOL)isItemExpanded:(id)item;
+
+/// Does item have children?
+- (BOOL)isItemExpandable:(id)item;
+
+/// Expand item, inserting the rows it reveals. An item inside a collapsed ancestor is marked expanded without inserting rows.
+- (void)expandItem:(id)item;
+
+/// Collapse item, removing the rows it hides.
+- (void)collapseItem:(id)item;
+
+/// Expand a collapsed item or collapse an expanded one.
+- (void)toggleItem:(id)item;
+
+/// The parent of item, or nil for a root item.
+- (nullable id)parentOfItem:(id)item;
+
+/// The depth of item in the tree; root items have a depth of 0.
+- (NSUInteger)depthOfItem:(id)item;
+
+/// The depth of the item shown at indexPath.
+- (NSUInteger)depthOfItemAtIndexPath:(NSIndexPath *)indexPath;
+
+/// The index path item is shown at, or nil when it is hidden inside a collapsed ancestor.
+- (nullable NSIndexPath *)indexPathForItem:(id)item;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,400 @@
+//
+//  APPSOutlineDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSOutlineDataSource.h"
+
+/// Per-item bookkeeping, indexed by the item's position in depth-first order.
+typedef struct {
+    NSUInteger parent;
+    NSUInteger subtreeSize;
+    NSUInteger depth;
+    BOOL expanded;
+    BOOL visible;
+} APPSOutlineNode;
+
+
+#pragma mark - Fenwick Tree
+
+// The tree is 1-based: tree[i] holds the number of visible items among the positions (i - lowbit(i), i].
+
+static void APPSFenwickAdd(NSInteger *tree, NSUInteger count, NSUInteger position, NSInteger delta)
+{
+    for (NSUInteger index = position + 1; index <= count; index += index & (~index + 1))
+        tree[index] += delta;
+}
+
+
+/// The number of visible items at positions 0 through position, inclusive.
+static NSInteger APPSFenwickPrefixSum(const NSInteger *tree, NSUInteger position)
+{
+    NSInteger sum = 0;
+    for (NSUInteger index = position + 1; index > 0; index -= index & (~index + 1))
+        sum += tree[index];
+    return sum;
+}
+
+
+/// The position of the visible item at row, found by descending the tree one power of two at a time.
+static NSUInteger APPSFenwickPositionForRow(const NSInteger *tree, NSUInteger count, NSUInteger row)
+{
+    NSUInteger step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+
+    NSUInteger index = 0;
+    NSInteger remaining = (NSInteger)row + 1;
+    for (; step; step /= 2) {
+        if (index + step <= count && tree[index + step] < remaining) {
+            index += step;
+            remaining -= tree[index];
+        }
+    }
+    return index;
+}
+
+
+
+@interface APPSOutlineDataSource ()
+@property (nonatomic, copy) APPSOutlineChildrenBlock childrenBlock;
+/// Every item in depth-first order.
+@property (nonatomic, copy) NSArray *items;
+/// Item → its position in items.
+@property (nonatomic, strong) NSMapTable *positionsByItem;
+/// An APPSOutlineNode for each position.
+@property (nonatomic, strong) NSMutableData *nodes;
+/// The Fenwick tree of visible items, with count + 1 entries.
+@property (nonatomic, strong) NSMutableData *visibleTree;
+@property (nonatomic) NSUInteger numberOfVisibleItems;
+@end
+
+@implementation APPSOutlineDataSource
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithChildrenBlock:(APPSOutlineChildrenBlock)childrenBlock
+{
+    NSParameterAssert(childrenBlock != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _childrenBlock = [childrenBlock copy];
+    _rootItems = @[];
+    _items = @[];
+    _positionsByItem = [NSMapTable strongToStrongObjectsMapTable];
+    _nodes = [NSMutableData data];
+    _visibleTree = [NSMutableData dataWithLength:sizeof(NSInteger)];
+    return self;
+}
+
+
+
+#pragma mark - APPSDataSource
+
+- (void)resetContent
+{
+    [super resetContent];
+    [self performUpdate:^{
+        self.rootItems = @[];
+    }];
+}
+
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)sectionIndex
+{
+    return _numberOfVisibleItems;
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfVisibleItems)
+        return nil;
+
+    return _items[APPSFenwickPositionForRow(_visibleTree.bytes, _items.count, row)];
+}
+
+
+- (NSArray *)indexPathsForItem:(id)item
+{
+    NSIndexPath *indexPath = [self indexPathForItem:item];
+    return indexPath ? @[indexPath] : @[];
+}
+
+
+
+#pragma mark - Property Overrides
+
+- (void)setRootItems:(NSArray *)rootItems
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+
+    NSMutableSet *expandedItems = [NSMutableSet set];
+    [self enumerateNodesUsingBlock:^(id item, APPSOutlineNode *node) {
+        if (node->expanded)
+            [expandedItems addObject:item];
+    }];
+
+    _rootItems = [rootItems copy];
+    [self buildTreeWithExpandedItems:expandedItems];
+    [self updateLoadingState];
+    [self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
+}
+
+
+- (NSUInteger)numberOfItems
+{
+    return _items.count;
+}
+
+
+
+#pragma mark - Public Interface
+
+- (BOOL)isItemExpanded:(id)item
+{
+    APPSOutlineNode *node = [self nodeForItem:item];
+    return node ? node->expanded : NO;
+}
+
+
+- (BOOL)isItemExpandable:(id)item
+{
+    APPSOutlineNode *node = [self nodeForItem:item];
+    return node ? node->subtreeSize > 1 : NO;
+}
+
+
+- (void)expandItem:(id)item
+{
+    [self setItem:item expanded:YES];
+}
+
+
+- (void)collapseItem:(id)item
+{
+    [self setItem:item expanded:NO];
+}
+
+
+- (void)toggleItem:(id)item
+{
+    [self setItem:item expanded:![self isItemExpanded:item]];
+}
+
+
+- (id)parentOfItem:(id)item
+{
+    APPSOutlineNode *node = [self nodeForItem:item];
+    return (node && node->parent != NSNotFound) ? _items[node->parent] : nil;
+}
+
+
+- (NSUInteger)depthOfItem:(id)item
+{
+    APPSOutlineNode *node = [self nodeForItem:item];
+    return node ? node->depth : 0;
+}
+
+
+- (NSUInteger)depthOfItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfVisibleItems)
+        return 0;
+
+    const APPSOutlineNode *nodes = _nodes.bytes;
+    return nodes[APPSFenwickPositionForRow(_visibleTree.bytes, _items.count, row)].depth;
+}
+
+
+- (NSIndexPath *)indexPathForItem:(id)item
+{
+    NSNumber *position = [_positionsByItem objectForKey:item];
+    if (!position)
+        return nil;
+
+    const APPSOutlineNode *nodes = _nodes.bytes;
+    if (!nodes[position.unsignedIntegerValue].visible)
+        return nil;
+
+    NSInteger row = APPSFenwickPrefixSum(_visibleTree.bytes, position.unsignedIntegerValue) - 1;
+    return [NSIndexPath indexPathForRow:row inSection:0];
+}
+
+
+
+#pragma mark - Expanding and Collapsing
+
+- (void)setItem:(id)item expanded:(BOOL)expanded
+{
+    if (![_positionsByItem objectForKey:item] || [self isItemExpanded:item] == expanded)
+        return;
+
+    [self performUpdate:^{
+        // Look the item up again: the update may have waited for a load that rebuilt the tree.
+        NSNumber *positionNumber = [_positionsByItem objectForKey:item];
+        if (!positionNumber)
+            return;
+
+        NSUInteger position = positionNumber.unsignedIntegerValue;
+        APPSOutlineNode *nodes = _nodes.mutableBytes;
+        if (nodes[position].expanded == expanded)
+            return;
+
+        NSInteger *tree = _visibleTree.mutableBytes;
+        NSUInteger count = _items.count;
+
+        // Hidden inside a collapsed ancestor: remember the choice for when the ancestor opens.
+        if (!nodes[position].visible) {
+            nodes[position].expanded = expanded;
+            return;
+        }
+
+        // The affected rows are the visible descendants, which sit together right after the item. They are exactly the descendants reachable through expanded items, so collapsed subtrees are skipped whole.
+        if (expanded)
+            nodes[position].expanded = YES;
+
+        NSUInteger firstRow = APPSFenwickPrefixSum(tree, position);
+        NSUInteger end = position + nodes[position].subtreeSize;
+        NSUInteger numberOfChangedRows = 0;
+
+        for (NSUInteger descendant = position + 1; descendant < end; ) {
+            nodes[descendant].visible = expanded;
+            APPSFenwickAdd(tree, count, descendant, expanded ? 1 : -1);
+            ++numberOfChangedRows;
+            descendant += nodes[descendant].expanded ? 1 : nodes[descendant].subtreeSize;
+        }
+
+        if (!expanded)
+            nodes[position].expanded = NO;
+
+        if (!numberOfChangedRows)
+            return;
+
+        NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:numberOfChangedRows];
+        for (NSUInteger row = firstRow; row < firstRow + numberOfChangedRows; ++row)
+            [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+
+        if (expanded) {
+            _numberOfVisibleItems += numberOfChangedRows;
+            [self notifyItemsInsertedAtIndexPaths:indexPaths];
+        }
+        else {
+            _numberOfVisibleItems -= numberOfChangedRows;
+            [self notifyItemsRemovedAtIndexPaths:indexPaths];
+        }
+    }];
+}
+
+
+
+#pragma mark - Helper
+
+- (APPSOutlineNode *)nodeForItem:(id)item
+{
+    NSNumber *position = [_positionsByItem objectForKey:item];
+    if (!position)
+        return NULL;
+
+    APPSOutlineNode *nodes = _nodes.mutableBytes;
+    return &nodes[position.unsignedIntegerValue];
+}
+
+
+- (void)enumerateNodesUsingBlock:(void (^)(id item, APPSOutlineNode *node))block
+{
+    APPSOutlineNode *nodes = _nodes.mutableBytes;
+    [_items enumerateObjectsUsingBlock:^(id item, NSUInteger position, BOOL *stop) {
+        block(item, &nodes[position]);
+    }];
+}
+
+
+/// Walk the tree once, depth first, recording each item's parent, depth and subtree size, then build the visibility tree in linear time.
+- (void)buildTreeWithExpandedItems:(NSSet *)expandedItems
+{
+    NSMutableArray *items = [NSMutableArray array];
+    NSMutableData *nodeData = [NSMutableData data];
+    NSMapTable *positionsByItem = [NSMapTable strongToStrongObjectsMapTable];
+
+    // An explicit stack of (item, parent position, depth) avoids recursion on deep trees. Children are pushed in reverse so they pop in order.
+    NSMutableArray *stack = [NSMutableArray array];
+    for (id rootItem in _rootItems.reverseObjectEnumerator)
+        [stack addObject:@[rootItem, @(NSNotFound), @0]];
+
+    while (stack.count) {
+        NSArray *entry = stack.lastObject;
+        [stack removeLastObject];
+
+        id item = entry[0];
+        NSUInteger parent = [entry[1] unsignedIntegerValue];
+        NSUInteger depth = [entry[2] unsignedIntegerValue];
+        NSUInteger position = items.count;
+
+        NSAssert([positionsByItem objectForKey:item] == nil, @"Items in an outline must be unique: %@", item);
+
+        [items addObject:item];
+        [positionsByItem setObject:@(position) forKey:item];
+
+        APPSOutlineNode node = { parent, 1, depth, [expandedItems containsObject:item], NO };
+        [nodeData appendBytes:&node length:sizeof(node)];
+
+        NSArray *children = self.childrenBlock(item);
+        for (id child in children.reverseObjectEnumerator)
+            [stack addObject:@[child, @(position), @(depth + 1)]];
+    }
+
+    NSUInteger count = items.count;
+    APPSOutlineNode *nodes = nodeData.mutableBytes;
+
+    // Children follow their parents in depth-first order, so one backward pass accumulates subtree sizes and one forward pass settles visibility.
+    for (NSUInteger position = count; position-- > 0; ) {
+        if (nodes[position].parent != NSNotFound)
+            nodes[nodes[position].parent].subtreeSize += nodes[position].subtreeSize;
+    }
+
+    NSMutableData *treeData = [NSMutableData dataWithLength:(count + 1) * sizeof(NSInteger)];
+    NSInteger *tree = treeData.mutableBytes;
+    NSUInteger numberOfVisibleItems = 0;
+
+    for (NSUInteger position = 0; position < count; ++position) {
+        NSUInteger parent = nodes[position].parent;
+        nodes[position].visible = (parent == NSNotFound) || (nodes[parent].visible && nodes[parent].expanded);
+        if (nodes[position].visible) {
+            tree[position + 1] = 1;
+            ++numberOfVisibleItems;
+        }
+    }
+
+    for (NSUInteger index = 1; index <= count; ++index) {
+        NSUInteger next = index + (index & (~index + 1));
+        if (next <= count)
+            tree[next] += tree[index];
+    }
+
+    _items = [items copy];
+    _positionsByItem = positionsByItem;
+    _nodes = nodeData;
+    _visibleTree = treeData;
+    _numberOfVisibleItems = numberOfVisibleItems;
+}
+
+
+- (void)updateLoadingState
+{
+    NSString *loadingState = self.loadingState;
+    if (_items.count && [loadingState isEqualToString:APPSLoadStateNoContent])
+        self.loadingState = APPSLoadStateContentLoaded;
+    else if (!_items.count && [loadingState isEqualToString:APPSLoadStateContentLoaded])
+        self.loadingState = APPSLoadStateNoContent;
+}
+
+@end
@@ -0,0 +1,70 @@
+//
+//  APPSPagedDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A single-section data source for long remote lists that loads its items a page at a time, as rows come near the screen.
+
+ The data source knows how many rows it has, either up front or growing as pages arrive, but holds only some pages in memory. Rows in a page that isn't loaded show placeholderItem. Displaying one of those rows starts loading its page and the pages around it, and prefetching it starts loading its page. -itemAtIndexPath: only reads what is loaded, so walking every item, as containers and diffs do, fetches nothing. When a page arrives, its rows are refreshed. Once more than maximumNumberOfLoadedPages are held, the pages farthest from the most recently displayed row are dropped. They load again if their rows come back.
+
+ Each page is loaded with its own APPSLoadingProgress, so the usual cancellation check stops work that is no longer needed. A page fetch is cancelled when its rows stop being prefetched and it is far from the rows in use, and every fetch is cancelled when the content is reset.
+
+ Subclasses override -loadPageAtIndex:progress: and usually -loadContentWithProgress:, which sets numberOfItems and may supply the first page. Cells are provided by overriding -tableView:cellForItem:atIndexPath: and checking -isItemLoadedAtIndexPath:.
+ */
+@interface APPSPagedDataSource : APPSDataSource
+
+/// Create a paged data source loading pageSize items at a time.
+- (instancetype)initWithPageSize:(NSUInteger)pageSize NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The number of items in each page. Only the last page may be shorter.
+@property (nonatomic, readonly) NSUInteger pageSize;
+
+/// The number of rows, loaded or not. Setting this inserts or removes rows at the end. Must be set within -performUpdate:.
+@property (nonatomic) NSUInteger numberOfItems;
+
+/// Set this to YES when the total isn't known. Displaying a row on the last page then loads the page after it, and numberOfItems grows as it arrives. Defaults to NO.
+@property (nonatomic) BOOL hasMoreItems;
+
+/// The item returned for rows whose page isn't loaded. Defaults to NSNull.
+@property (nonatomic, strong) id placeholderItem;
+
+/// How many pages either side of the page in use are loaded ahead of time. Defaults to 1.
+@property (nonatomic) NSUInteger prefetchPageDistance;
+
+/// The most pages held in memory at once. Defaults to 8.
+@property (nonatomic) NSUInteger maximumNumberOfLoadedPages;
+
+/// Is the item at indexPath loaded, rather than a placeholder?
+- (BOOL)isItemLoadedAtIndexPath:(NSIndexPath *)indexPath;
+
+/// Start loading the page containing indexPath and its neighbours, if they aren't loaded or loading, and keep the pages near it when evicting. Called for each row as its cell is requested.
+- (void)loadItemsNearIndexPath:(NSIndexPath *)indexPath;
+
+/// Store the items of a page, refreshing its rows. Must be called within -performUpdate:, usually from a progress update block.
+- (void)setItems:(NSArray *)items forPageAtIndex:(NSUInteger)pageIndex;
+
+/// Drop every loaded page and cancel page fetches. Rows remain and show placeholders until their pages load again. Must be called within -performUpdate:.
+- (void)invalidateLoadedPages;
+
+
+
+#pragma mark - Subclass Hooks
+
+/// Load the page at pageIndex. Check progress.cancelled before finishing. Then call -updateWithContent: with a block that calls -setItems:forPageAtIndex:, or -doneWithError: so the page is tried again the next time its rows are needed. The default implementation calls -ignore.
+- (void)loadPageAtIndex:(NSUInteger)pageIndex progress:(APPSLoadingProgress *)progress;
+
+/// Return the cell for the row at indexPath, showing item, which is placeholderItem until its page loads. Called from -tableView:cellForRowAtIndexPath: once loading near the row has started. The default implementation asserts.
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForItem:(id)item atIndexPath:(NSIndexPath *)indexPath;
+
+@end
+
+NS_ASSUME_NONNULL_END
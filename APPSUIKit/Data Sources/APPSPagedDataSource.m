@@ -0,0 +1,355 @@
+//
+//  APPSPagedDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSPagedDataSource.h"
+
+
+@interface APPSLoadingProgress ()
+@property (nonatomic, readwrite, getter = isCancelled) BOOL cancelled;
+@end
+
+
+@interface APPSPagedDataSource ()
+/// Page index → the items of that page.
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSArray *> *loadedPages;
+/// Page index → the progress of its fetch, while one is in flight.
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, APPSLoadingProgress *> *pageLoads;
+/// The page of the most recently displayed row; eviction keeps the pages closest to it.
+@property (nonatomic) NSUInteger focusPageIndex;
+@end
+
+@implementation APPSPagedDataSource
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithPageSize:(NSUInteger)pageSize
+{
+    NSParameterAssert(pageSize > 0);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _pageSize = pageSize;
+    _placeholderItem = [NSNull null];
+    _prefetchPageDistance = 1;
+    _maximumNumberOfLoadedPages = 8;
+    _loadedPages = [NSMutableDictionary dictionary];
+    _pageLoads = [NSMutableDictionary dictionary];
+    return self;
+}
+
+
+
+#pragma mark - APPSDataSource
+
+- (void)resetContent
+{
+    [self cancelPageLoads];
+    [super resetContent];
+    [self performUpdate:^{
+        [self.loadedPages removeAllObjects];
+        self.hasMoreItems = NO;
+        self.numberOfItems = 0;
+    }];
+}
+
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)sectionIndex
+{
+    return _numberOfItems;
+}
+
+
+// No loading here: containers, diffs and height caches walk every item, and that mustn't fetch every page.
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfItems)
+        return nil;
+
+    NSArray *items = _loadedPages[@(row / _pageSize)];
+    NSUInteger offset = row % _pageSize;
+    return offset < items.count ? items[offset] : _placeholderItem;
+}
+
+
+- (NSArray *)indexPathsForItem:(id)item
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    [_loadedPages enumerateKeysAndObjectsUsingBlock:^(NSNumber *pageIndex, NSArray *items, BOOL *stop) {
+        NSUInteger offset = [items indexOfObject:item];
+        if (offset != NSNotFound)
+            [indexPaths addObject:[NSIndexPath indexPathForRow:pageIndex.unsignedIntegerValue * _pageSize + offset inSection:0]];
+    }];
+    return indexPaths;
+}
+
+
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (indexPath.row < _numberOfItems)
+            [self loadPageAtIndexIfNeeded:indexPath.row / _pageSize];
+    }
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    // Only give up on pages that have also drifted away from the rows in use; the user may just have paused.
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSUInteger pageIndex = indexPath.row / _pageSize;
+        if ([self distanceFromFocusToPageAtIndex:pageIndex] > _prefetchPageDistance)
+            [self cancelLoadForPageAtIndex:pageIndex];
+    }
+}
+
+
+
+#pragma mark - Protocol: UITableViewDataSource
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    [self loadItemsNearIndexPath:indexPath];
+    return [self tableView:tableView cellForItem:[self itemAtIndexPath:indexPath] atIndexPath:indexPath];
+}
+
+
+
+#pragma mark - Property Overrides
+
+- (void)setNumberOfItems:(NSUInteger)numberOfItems
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+
+    NSUInteger oldNumberOfItems = _numberOfItems;
+    if (numberOfItems == oldNumberOfItems)
+        return;
+
+    _numberOfItems = numberOfItems;
+
+    if (numberOfItems > oldNumberOfItems) {
+        [self notifyItemsInsertedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(oldNumberOfItems, numberOfItems - oldNumberOfItems)]];
+    }
+    else {
+        // Pages wholly past the new end go; a page straddling it is trimmed.
+        NSUInteger lastPageIndex = numberOfItems ? (numberOfItems - 1) / _pageSize : 0;
+        for (NSNumber *pageIndex in _loadedPages.allKeys) {
+            NSUInteger index = pageIndex.unsignedIntegerValue;
+            NSUInteger firstRow = index * _pageSize;
+            if (firstRow >= numberOfItems) {
+                [_loadedPages removeObjectForKey:pageIndex];
+                [self cancelLoadForPageAtIndex:index];
+            }
+            else if (index == lastPageIndex && firstRow + _loadedPages[pageIndex].count > numberOfItems) {
+                _loadedPages[pageIndex] = [_loadedPages[pageIndex] subarrayWithRange:NSMakeRange(0, numberOfItems - firstRow)];
+            }
+        }
+        [self notifyItemsRemovedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(numberOfItems, oldNumberOfItems - numberOfItems)]];
+    }
+
+    [self updateLoadingState];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (BOOL)isItemLoadedAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfItems)
+        return NO;
+
+    return _loadedPages[@(row / _pageSize)].count > row % _pageSize;
+}
+
+
+- (void)loadItemsNearIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger pageIndex = indexPath.row / _pageSize;
+    _focusPageIndex = pageIndex;
+
+    // The page after the last one only exists while more items are expected and the last page is full.
+    NSUInteger numberOfPages = (_numberOfItems + _pageSize - 1) / _pageSize;
+    if (_hasMoreItems && !(_numberOfItems % _pageSize))
+        ++numberOfPages;
+
+    // Work outwards from the page in use so it's requested first.
+    [self loadPageAtIndexIfNeeded:pageIndex];
+    for (NSUInteger distance = 1; distance <= _prefetchPageDistance; ++distance) {
+        if (pageIndex + distance < numberOfPages)
+            [self loadPageAtIndexIfNeeded:pageIndex + distance];
+        if (pageIndex >= distance)
+            [self loadPageAtIndexIfNeeded:pageIndex - distance];
+    }
+}
+
+
+- (void)setItems:(NSArray *)items forPageAtIndex:(NSUInteger)pageIndex
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+    NSAssert(items.count <= _pageSize, @"A page can hold at most %lu items", (unsigned long)_pageSize);
+
+    NSUInteger firstRow = pageIndex * _pageSize;
+    NSUInteger oldNumberOfItems = _numberOfItems;
+
+    _loadedPages[@(pageIndex)] = [items copy];
+    [self cancelLoadForPageAtIndex:pageIndex];
+
+    // A short page marks the end of a list whose length wasn't known.
+    if (_hasMoreItems && items.count < _pageSize)
+        _hasMoreItems = NO;
+
+    if (firstRow < oldNumberOfItems) {
+        NSUInteger numberOfRefreshedRows = MIN(items.count, oldNumberOfItems - firstRow);
+        if (numberOfRefreshedRows)
+            [self notifyItemsRefreshedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(firstRow, numberOfRefreshedRows)]];
+    }
+
+    if (firstRow + items.count > oldNumberOfItems)
+        self.numberOfItems = firstRow + items.count;
+
+    [self evictPagesIfNeeded];
+}
+
+
+- (void)invalidateLoadedPages
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+
+    [self cancelPageLoads];
+    [_loadedPages removeAllObjects];
+    [self notifySectionsRefreshed:[NSIndexSet indexSetWithIndex:0]];
+}
+
+
+
+#pragma mark - Subclass Hooks
+
+- (void)loadPageAtIndex:(NSUInteger)pageIndex progress:(APPSLoadingProgress *)progress
+{
+    [progress ignore];
+}
+
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForItem:(id)item atIndexPath:(NSIndexPath *)indexPath
+{
+    NSAssert(NO, @"Should be implemented by subclasses");
+    return nil;
+}
+
+
+
+#pragma mark - Page Loading
+
+- (void)loadPageAtIndexIfNeeded:(NSUInteger)pageIndex
+{
+    NSNumber *key = @(pageIndex);
+    if (_loadedPages[key] || _pageLoads[key])
+        return;
+
+    __weak typeof(self) weakSelf = self;
+    __block __weak APPSLoadingProgress *weakProgress = nil;
+
+    // The handler is always called on the main queue.
+    APPSLoadingProgress *progress = [APPSLoadingProgress loadingProgressWithCompletionHandler:^(NSString *newState, NSError *error, APPSLoadingUpdateBlock update) {
+        APPSPagedDataSource *me = weakSelf;
+        if (!me)
+            return;
+
+        // Only the current fetch for the page may finish it; a cancelled one has already been forgotten.
+        if (me.pageLoads[key] != weakProgress)
+            return;
+        [me.pageLoads removeObjectForKey:key];
+
+        // Errors leave the page unloaded, so it's requested again the next time its rows are needed.
+        if (!newState || error || !update)
+            return;
+
+        [me performUpdate:^{
+            update(me);
+        }];
+    }];
+
+    weakProgress = progress;
+    _pageLoads[key] = progress;
+    [self loadPageAtIndex:pageIndex progress:progress];
+}
+
+
+- (void)cancelLoadForPageAtIndex:(NSUInteger)pageIndex
+{
+    NSNumber *key = @(pageIndex);
+    APPSLoadingProgress *progress = _pageLoads[key];
+    if (!progress)
+        return;
+
+    [_pageLoads removeObjectForKey:key];
+    progress.cancelled = YES;
+}
+
+
+- (void)cancelPageLoads
+{
+    NSArray<APPSLoadingProgress *> *progresses = _pageLoads.allValues;
+    [_pageLoads removeAllObjects];
+    for (APPSLoadingProgress *progress in progresses)
+        progress.cancelled = YES;
+}
+
+
+/// Drop the pages farthest from the page in use until the budget is met. Pages within the prefetch distance are kept regardless. Dropped rows aren't refreshed: they're off screen, and reload when they come back.
+- (void)evictPagesIfNeeded
+{
+    if (_loadedPages.count <= _maximumNumberOfLoadedPages)
+        return;
+
+    NSArray<NSNumber *> *pageIndexes = [_loadedPages.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSNumber *pageIndex1, NSNumber *pageIndex2) {
+        NSUInteger distance1 = [self distanceFromFocusToPageAtIndex:pageIndex1.unsignedIntegerValue];
+        NSUInteger distance2 = [self distanceFromFocusToPageAtIndex:pageIndex2.unsignedIntegerValue];
+        return distance1 > distance2 ? NSOrderedAscending : (distance1 < distance2 ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    for (NSNumber *pageIndex in pageIndexes) {
+        if (_loadedPages.count <= _maximumNumberOfLoadedPages || [self distanceFromFocusToPageAtIndex:pageIndex.unsignedIntegerValue] <= _prefetchPageDistance)
+            break;
+        [_loadedPages removeObjectForKey:pageIndex];
+    }
+}
+
+
+
+#pragma mark - Helper
+
+- (NSUInteger)distanceFromFocusToPageAtIndex:(NSUInteger)pageIndex
+{
+    return pageIndex > _focusPageIndex ? pageIndex - _focusPageIndex : _focusPageIndex - pageIndex;
+}
+
+
+- (NSArray<NSIndexPath *> *)indexPathsForRowsInRange:(NSRange)range
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:range.length];
+    for (NSUInteger row = range.location; row < NSMaxRange(range); ++row)
+        [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+    return indexPaths;
+}
+
+
+- (void)updateLoadingState
+{
+    NSString *loadingState = self.loadingState;
+    if (_numberOfItems && [loadingState isEqualToString:APPSLoadStateNoContent])
+        self.loadingState = APPSLoadStateContentLoaded;
+    else if (!_numberOfItems && [loadingState isEqualToString:APPSLoadStateContentLoaded])
+        self.loadingState = APPSLoadStateNoContent;
+}
+
+@end
@@ -94,6 +94,16 @@
 @property (nonatomic, strong) NSArray *listOfModelItemsInPartitionedSections;
 
 
+#pragma mark scalar
+
+/**
+ Optional. When YES, the resolved section names are also offered to the table view as its section
+ index titles, giving an A–Z index down the side of the table. Pairs well with the sections built by
+ @c -[APPSCollationSorter collatedSectionsFromArray:]. Defaults to NO.
+ */
+@property (assign, nonatomic) BOOL showsSectionIndexTitles;
+
+
 #pragma mark copy
 
 /**
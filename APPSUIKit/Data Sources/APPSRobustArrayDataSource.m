@@ -390,6 +390,23 @@
 }
 
 
+- (NSArray<NSString *> *)sectionIndexTitlesForTableView:(UITableView *)tableView
+{
+    if (!self.showsSectionIndexTitles || self.usingSingleSection) {
+        return nil;
+    }
+    
+    return [self resolvedSectionNames];
+}
+
+
+- (NSInteger)tableView:(UITableView *)tableView sectionForSectionIndexTitle:(NSString *)title atIndex:(NSInteger)index
+{
+    // Section index titles are the section names themselves, so the positions line up.
+    return index;
+}
+
+
 #pragma mark * Rows
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section
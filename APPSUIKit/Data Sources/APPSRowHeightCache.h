@@ -0,0 +1,57 @@
+//
+//  APPSRowHeightCache.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import UIKit;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A block that returns the key the cache should use for an item. Return nil to skip caching the item.
+typedef id __nullable (^APPSRowHeightCacheKeyBlock)(id item);
+
+
+/**
+ Caches measured row heights keyed by item identity and table width.
+
+ Entries are normally recorded and invalidated by APPSBaseDataSourceDelegate in response to data source change notifications. The height of an APPSIdentifiable item is recorded along with its content hash and ignored once that hash changes, so heights survive a reload of unchanged items. The cache can optionally be persisted between launches; only entries whose key is an NSString or NSNumber are persisted, so supply a keyForItemBlock that returns a stable identifier when persistence is wanted.
+
+ All methods must be called on the main thread.
+ */
+@interface APPSRowHeightCache : NSObject
+
+/// Create an in-memory cache.
+- (instancetype)init;
+
+/// Create a cache that loads its entries from fileURL and saves them back when the application enters the background.
+- (instancetype)initWithPersistenceURL:(nullable NSURL *)fileURL NS_DESIGNATED_INITIALIZER;
+
+/// The location the cache is persisted to, if any.
+@property (nullable, nonatomic, readonly) NSURL *persistenceURL;
+
+/// Maps items to cache keys. By default an APPSIdentifiable item is keyed by its identifier, and any other item is its own key. Keys are held strongly, except a key that is the item itself, which is held weakly so the cache doesn't keep items alive.
+@property (nullable, nonatomic, copy) APPSRowHeightCacheKeyBlock keyForItemBlock;
+
+/// The number of cached heights across all widths.
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The cached height of item at the given table width, or a negative value when no height is cached for its current content.
+- (CGFloat)heightForItem:(id)item width:(CGFloat)width;
+
+/// Record the measured height of item at the given table width.
+- (void)setHeight:(CGFloat)height forItem:(id)item width:(CGFloat)width;
+
+/// Forget the heights of item at every width.
+- (void)invalidateHeightsForItem:(id)item;
+
+/// Forget every cached height.
+- (void)invalidateAllHeights;
+
+/// Write persistable entries to the persistence URL. Does nothing for in-memory caches.
+- (BOOL)saveWithError:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,222 @@
+//
+//  APPSRowHeightCache.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSRowHeightCache.h"
+#import "APPSIdentifiable.h"
+
+@interface APPSRowHeightCache ()
+@property (nullable, nonatomic, readwrite) NSURL *persistenceURL;
+/// Width (rounded to the nearest point) → map table of key → entry, for keys other than the items themselves.
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMapTable *> *heightsByWidth;
+/// Width → weak-keyed map table of item → entry, for items that are their own keys, so the cache doesn't keep them alive.
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMapTable *> *itemHeightsByWidth;
+@end
+
+@implementation APPSRowHeightCache
+
+
+#pragma mark - Instantiation
+
+- (instancetype)init
+{
+    return [self initWithPersistenceURL:nil];
+}
+
+
+- (instancetype)initWithPersistenceURL:(NSURL *)fileURL
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _persistenceURL = [fileURL copy];
+    _heightsByWidth = [NSMutableDictionary dictionary];
+    _itemHeightsByWidth = [NSMutableDictionary dictionary];
+
+    if (fileURL) {
+        [self loadPersistedHeights];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidEnterBackground:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+    }
+
+    // Row heights depend on the text size, so none of them survive a Dynamic Type change.
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(contentSizeCategoryDidChange:) name:UIContentSizeCategoryDidChangeNotification object:nil];
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSUInteger)count
+{
+    NSUInteger count = 0;
+    for (NSMapTable *heights in _heightsByWidth.objectEnumerator)
+        count += heights.count;
+    for (NSMapTable *heights in _itemHeightsByWidth.objectEnumerator)
+        count += heights.count;
+    return count;
+}
+
+
+- (CGFloat)heightForItem:(id)item width:(CGFloat)width
+{
+    id key = [self keyForItem:item];
+    if (!key)
+        return -1;
+
+    NSMutableDictionary *heightsByWidth = (key == item) ? _itemHeightsByWidth : _heightsByWidth;
+    NSArray<NSNumber *> *entry = [heightsByWidth[[self widthKeyForWidth:width]] objectForKey:key];
+
+    // A height measured before the item's content changed no longer applies.
+    if (!entry || entry[1].unsignedIntegerValue != [self contentHashForItem:item])
+        return -1;
+    return entry[0].doubleValue;
+}
+
+
+- (void)setHeight:(CGFloat)height forItem:(id)item width:(CGFloat)width
+{
+    id key = [self keyForItem:item];
+    if (!key || height < 0)
+        return;
+
+    BOOL keyIsItem = (key == item);
+    NSMutableDictionary *heightsByWidth = keyIsItem ? _itemHeightsByWidth : _heightsByWidth;
+    NSNumber *widthKey = [self widthKeyForWidth:width];
+    NSMapTable *heights = heightsByWidth[widthKey];
+    if (!heights) {
+        heights = keyIsItem ? [NSMapTable weakToStrongObjectsMapTable] : [NSMapTable strongToStrongObjectsMapTable];
+        heightsByWidth[widthKey] = heights;
+    }
+    [heights setObject:@[@(height), @([self contentHashForItem:item])] forKey:key];
+}
+
+
+- (void)invalidateHeightsForItem:(id)item
+{
+    id key = [self keyForItem:item];
+    if (!key)
+        return;
+
+    NSMutableDictionary *heightsByWidth = (key == item) ? _itemHeightsByWidth : _heightsByWidth;
+    for (NSMapTable *heights in heightsByWidth.objectEnumerator)
+        [heights removeObjectForKey:key];
+}
+
+
+- (void)invalidateAllHeights
+{
+    [_heightsByWidth removeAllObjects];
+    [_itemHeightsByWidth removeAllObjects];
+}
+
+
+- (BOOL)saveWithError:(NSError **)error
+{
+    NSURL *fileURL = self.persistenceURL;
+    if (!fileURL)
+        return YES;
+
+    NSMutableDictionary *archive = [NSMutableDictionary dictionaryWithCapacity:_heightsByWidth.count];
+    [_heightsByWidth enumerateKeysAndObjectsUsingBlock:^(NSNumber *widthKey, NSMapTable *heights, BOOL *stop) {
+        NSMutableDictionary *persistableHeights = [NSMutableDictionary dictionary];
+        for (id key in heights) {
+            if ([key isKindOfClass:[NSString class]] || [key isKindOfClass:[NSNumber class]])
+                persistableHeights[key] = [heights objectForKey:key];
+        }
+        if (persistableHeights.count)
+            archive[widthKey] = persistableHeights;
+    }];
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:archive];
+    return [data writeToURL:fileURL options:NSDataWritingAtomic error:error];
+}
+
+
+
+#pragma mark - Notifications
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    [self saveWithError:NULL];
+}
+
+
+- (void)contentSizeCategoryDidChange:(NSNotification *)notification
+{
+    [self invalidateAllHeights];
+}
+
+
+
+#pragma mark - Helper
+
+- (id)keyForItem:(id)item
+{
+    if (!item)
+        return nil;
+
+    APPSRowHeightCacheKeyBlock keyForItemBlock = self.keyForItemBlock;
+    if (keyForItemBlock)
+        return keyForItemBlock(item);
+
+    return [item conformsToProtocol:@protocol(APPSIdentifiable)] ? [(id<APPSIdentifiable>)item itemIdentifier] : item;
+}
+
+
+/// The content a height was measured for. Items that aren't APPSIdentifiable can't report content changes, so theirs is always 0.
+- (NSUInteger)contentHashForItem:(id)item
+{
+    return [item conformsToProtocol:@protocol(APPSIdentifiable)] ? [(id<APPSIdentifiable>)item contentHash] : 0;
+}
+
+
+- (NSNumber *)widthKeyForWidth:(CGFloat)width
+{
+    return @((NSInteger)round(width));
+}
+
+
+- (void)loadPersistedHeights
+{
+    NSData *data = [NSData dataWithContentsOfURL:self.persistenceURL];
+    if (!data)
+        return;
+
+    NSDictionary *archive = nil;
+    @try {
+        archive = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    }
+    @catch (NSException *exception) {
+        // A corrupt cache is simply discarded.
+        return;
+    }
+
+    if (![archive isKindOfClass:[NSDictionary class]])
+        return;
+
+    [archive enumerateKeysAndObjectsUsingBlock:^(NSNumber *widthKey, NSDictionary *persistedHeights, BOOL *stop) {
+        if (![widthKey isKindOfClass:[NSNumber class]] || ![persistedHeights isKindOfClass:[NSDictionary class]])
+            return;
+
+        NSMapTable *heights = [NSMapTable strongToStrongObjectsMapTable];
+        [persistedHeights enumerateKeysAndObjectsUsingBlock:^(id key, NSArray<NSNumber *> *entry, BOOL *innerStop) {
+            if ([entry isKindOfClass:[NSArray class]] && entry.count == 2)
+                [heights setObject:entry forKey:key];
+        }];
+        _heightsByWidth[widthKey] = heights;
+    }];
+}
+
+@end
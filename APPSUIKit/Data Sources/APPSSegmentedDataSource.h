@@ -51,7 +51,7 @@ NS_ASSUME_NONNULL_BEGIN
 /// The index of the selected data source in the collection.
 @property (nonatomic) NSInteger selectedDataSourceIndex;
 
-/// Set the selected data source with animation. By default, setting the selected data source is not animated.
+/// Set the selected data source with animation. By default, setting the selected data source is not animated. When animated and both data sources have loaded the same number of sections, the switch is applied as item removals and insertions, so items shared by both data sources keep their rows and cells rather than being faded out and back in. Only the shared items that change order are moved, and once the switch is done the visible shared cells are reconfigured in place through -tableView:reconfigureCell:forRowAtIndexPath:.
 - (void)setSelectedDataSource:(APPSDataSource *)selectedDataSource animated:(BOOL)animated;
 
 /// Set the index of the selected data source with optional animation. By default, setting the selected data source index is not animated.
@@ -15,6 +15,7 @@
 
 #import "APPSDataSource_Private.h"
 #import "APPSSegmentedDataSource.h"
+#import "APPSDataSourceDiff.h"
 
 NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHeaderKey";
 
@@ -69,6 +70,13 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 }
 
 
+- (void)appendSectionRoutesToArray:(NSMutableArray *)routes
+{
+    if (_selectedDataSource)
+        [self appendSectionRoutesOfDataSource:_selectedDataSource toArray:routes];
+}
+
+
 
 #pragma mark - Property Overrides
 
@@ -83,8 +91,10 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 
 - (void)addDataSource:(APPSDataSource *)dataSource
 {
-	if (![_dataSources count])
+	if (![_dataSources count]) {
 		_selectedDataSource = dataSource;
+		[self invalidateSectionRoutes];
+	}
 	[_dataSources addObject:dataSource];
 	dataSource.delegate = self;
 }
@@ -107,6 +117,7 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 	
 	_dataSources = [NSMutableArray array];
 	_selectedDataSource = nil;
+	[self invalidateSectionRoutes];
 }
 
 
@@ -161,8 +172,11 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 	NSInteger numberOfOldSections = oldDataSource.numberOfSections;
 	NSInteger numberOfNewSections = selectedDataSource.numberOfSections;
 	
-	NSIndexSet *removedSet = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfOldSections)];
-	NSIndexSet *insertedSet = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfNewSections)];
+	// When animating between segments that share items, only the real differences are animated and the visible cells are reused.
+	NSArray *sectionDiffs = animated ? [self itemDiffsFromDataSource:oldDataSource toDataSource:selectedDataSource] : nil;
+	
+	NSIndexSet *removedSet = sectionDiffs ? nil : [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfOldSections)];
+	NSIndexSet *insertedSet = sectionDiffs ? nil : [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfNewSections)];
 	
 	// Update the sections all at once.
     [self performUpdate:^{
@@ -175,6 +189,7 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
         [self willChangeValueForKey:@"selectedDataSourceIndex"];
         
         _selectedDataSource = selectedDataSource;
+        [self invalidateSectionRoutes];
         
         [self didChangeValueForKey:@"selectedDataSource"];
         [self didChangeValueForKey:@"selectedDataSourceIndex"];
@@ -182,12 +197,97 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 		if (insertedSet)
 			[self notifySectionsInserted:insertedSet];
         
+        [sectionDiffs enumerateObjectsUsingBlock:^(APPSDataSourceDiff *diff, NSUInteger sectionIndex, BOOL *stop) {
+            [self notifyItemChangesOfDiff:diff section:sectionIndex numberOfNewItems:[selectedDataSource numberOfRowsInSection:sectionIndex]];
+        }];
+        
         [selectedDataSource didBecomeActive];
 	} complete:handler];
 	
 }
 
 
+/// Returns one diff per section when the switch can be expressed as item changes, or nil when the sections must be replaced wholesale.
+- (NSArray *)itemDiffsFromDataSource:(APPSDataSource *)oldDataSource toDataSource:(APPSDataSource *)newDataSource
+{
+    if (!oldDataSource || !newDataSource || self.shouldShowPlaceholder)
+        return nil;
+    
+    // Placeholders and activity indicators hide the rows from the table view, so there's nothing visible to diff against.
+    if (![oldDataSource.loadingState isEqualToString:APPSLoadStateContentLoaded] || ![newDataSource.loadingState isEqualToString:APPSLoadStateContentLoaded])
+        return nil;
+    
+    NSInteger numberOfSections = oldDataSource.numberOfSections;
+    if (numberOfSections != newDataSource.numberOfSections)
+        return nil;
+    
+    NSMutableArray *sectionDiffs = [NSMutableArray arrayWithCapacity:numberOfSections];
+    for (NSInteger sectionIndex = 0; sectionIndex < numberOfSections; ++sectionIndex) {
+        NSArray *oldItems = [self itemsInSection:sectionIndex ofDataSource:oldDataSource];
+        NSArray *newItems = [self itemsInSection:sectionIndex ofDataSource:newDataSource];
+        if (!oldItems || !newItems)
+            return nil;
+        
+        APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:oldItems toItems:newItems];
+        if (!diff)
+            return nil;
+        [sectionDiffs addObject:diff];
+    }
+    
+    return sectionDiffs;
+}
+
+
+/// Send a segment switch's diff for a section. Only the shared rows that change order are moved; the table view shifts the rest around the insertions and removals, keeping their cells. The new segment configures its cells its own way, so every shared row is then reconfigured in place rather than left showing the old segment's configuration.
+- (void)notifyItemChangesOfDiff:(APPSDataSourceDiff *)diff section:(NSInteger)sectionIndex numberOfNewItems:(NSInteger)numberOfNewItems
+{
+    if (diff.removedIndexes.count)
+        [self notifyItemsRemovedAtIndexPaths:[self indexPathsForIndexes:diff.removedIndexes section:sectionIndex]];
+    
+    if (diff.insertedIndexes.count)
+        [self notifyItemsInsertedAtIndexPaths:[self indexPathsForIndexes:diff.insertedIndexes section:sectionIndex]];
+    
+    if (diff.refreshedIndexes.count)
+        [self notifyItemsRefreshedAtIndexPaths:[self indexPathsForIndexes:diff.refreshedIndexes section:sectionIndex]];
+    
+    [diff enumerateReorderingMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+        [self notifyItemMovedFromIndexPath:[NSIndexPath indexPathForItem:fromIndex inSection:sectionIndex] toIndexPaths:[NSIndexPath indexPathForItem:toIndex inSection:sectionIndex]];
+    }];
+    
+    NSMutableIndexSet *sharedIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfNewItems)];
+    [sharedIndexes removeIndexes:diff.insertedIndexes];
+    
+    if (sharedIndexes.count)
+        [self notifyItemsReconfiguredAtIndexPaths:[self indexPathsForIndexes:sharedIndexes section:sectionIndex]];
+}
+
+
+- (NSArray<NSIndexPath *> *)indexPathsForIndexes:(NSIndexSet *)indexes section:(NSInteger)sectionIndex
+{
+    NSMutableArray<NSIndexPath *> *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForItem:index inSection:sectionIndex]];
+    }];
+    return indexPaths;
+}
+
+
+- (NSArray *)itemsInSection:(NSInteger)sectionIndex ofDataSource:(APPSDataSource *)dataSource
+{
+    NSInteger numberOfItems = [dataSource numberOfRowsInSection:sectionIndex];
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:numberOfItems];
+    
+    for (NSInteger itemIndex = 0; itemIndex < numberOfItems; ++itemIndex) {
+        id item = [dataSource itemAtIndexPath:[NSIndexPath indexPathForItem:itemIndex inSection:sectionIndex]];
+        if (!item)
+            return nil;
+        [items addObject:item];
+    }
+    
+    return items;
+}
+
+
 - (NSArray *)indexPathsForItem:(id)object
 {
     return [_selectedDataSource indexPathsForItem:object];
@@ -196,6 +296,10 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 
 - (id)itemAtIndexPath:(NSIndexPath *)indexPath
 {
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:indexPath.section];
+    if (route)
+        return [route.dataSource itemAtIndexPath:[route localIndexPathForGlobalIndexPath:indexPath]];
+    
     return [_selectedDataSource itemAtIndexPath:indexPath];
 }
 
@@ -220,6 +324,18 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 }
 
 
+- (void)prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [_selectedDataSource prefetchRowsAtIndexPaths:indexPaths];
+}
+
+
+- (void)cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    [_selectedDataSource cancelPrefetchingForRowsAtIndexPaths:indexPaths];
+}
+
+
 - (BOOL)allowsSelection
 {
     return [_selectedDataSource allowsSelection];
@@ -312,14 +428,33 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
+    // Go straight to the leaf data source rather than walking every level of nesting for each cell.
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:indexPath.section];
+    if (route)
+        return [route.dataSource tableView:tableView cellForRowAtIndexPath:[route localIndexPathForGlobalIndexPath:indexPath]];
+    
 	return [_selectedDataSource tableView:tableView cellForRowAtIndexPath:indexPath];
 }
 
 
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:indexPath.section];
+    APPSDataSource *dataSource = route ? route.dataSource : _selectedDataSource;
+    NSIndexPath *localIndexPath = route ? [route localIndexPathForGlobalIndexPath:indexPath] : indexPath;
+    
+    return [dataSource tableView:tableView reconfigureCell:cell forRowAtIndexPath:localIndexPath];
+}
+
+
 - (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section
 {
-	if ([_selectedDataSource respondsToSelector:@selector(tableView:titleForHeaderInSection:)]) {
-		return [_selectedDataSource tableView:tableView titleForHeaderInSection:section];
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:section];
+    APPSDataSource *dataSource = route ? route.dataSource : _selectedDataSource;
+    NSInteger localSection = route ? route.localSection : section;
+    
+	if ([dataSource respondsToSelector:@selector(tableView:titleForHeaderInSection:)]) {
+		return [dataSource tableView:tableView titleForHeaderInSection:localSection];
 	} else {
 		return nil;
 	}
@@ -328,14 +463,33 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 
 - (NSString *)tableView:(UITableView *)tableView titleForFooterInSection:(NSInteger)section
 {
-	if ([_selectedDataSource respondsToSelector:@selector(tableView:titleForFooterInSection:)]) {
-		return [_selectedDataSource tableView:tableView titleForFooterInSection:section];
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:section];
+    APPSDataSource *dataSource = route ? route.dataSource : _selectedDataSource;
+    NSInteger localSection = route ? route.localSection : section;
+    
+	if ([dataSource respondsToSelector:@selector(tableView:titleForFooterInSection:)]) {
+		return [dataSource tableView:tableView titleForFooterInSection:localSection];
 	} else {
 		return nil;
 	}
 }
 
 
+- (BOOL)tableView:(UITableView *)tableView canEditRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    APPSDataSourceSectionRoute *route = [self sectionRouteForGlobalSection:indexPath.section];
+    APPSDataSource *dataSource = route ? route.dataSource : _selectedDataSource;
+    NSIndexPath *localIndexPath = route ? [route localIndexPathForGlobalIndexPath:indexPath] : indexPath;
+    
+    if ([dataSource respondsToSelector:@selector(tableView:canEditRowAtIndexPath:)]) {
+        return [dataSource tableView:tableView canEditRowAtIndexPath:localIndexPath];
+    }
+    else {
+        return YES;
+    }
+}
+
+
 
 #pragma mark - Protocol: APPSDataSourceDelegate
 
@@ -366,6 +520,15 @@ NSString * const APPSSegmentedDataSourceHeaderKey = @"APPSSegmentedDataSourceHea
 }
 
 
+- (void)dataSource:(APPSDataSource *)dataSource didReconfigureItemsAtIndexPaths:(NSArray *)indexPaths
+{
+	if (dataSource != _selectedDataSource)
+		return;
+	
+	[self notifyItemsReconfiguredAtIndexPaths:indexPaths];
+}
+
+
 - (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath
 {
 	if (dataSource != _selectedDataSource)
@@ -0,0 +1,49 @@
+//
+//  APPSSortedDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSBasicDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An APPSBasicDataSource that keeps its items in sorted order.
+
+ Single items are inserted, removed and repositioned by binary search, and each change sends exactly one notification. Batches of new items are sorted on their own and merged into the existing items in one pass, sending a single insertion. Items that compare equal keep the order in which they were added.
+
+ Setting items sorts them first. Avoid -mutableArrayValueForKey: on a sorted data source, since it can place items out of order. Like the other mutation methods of APPSBasicDataSource, every method here must be called within -performUpdate:.
+ */
+@interface APPSSortedDataSource : APPSBasicDataSource
+
+/// Create a data source ordered by comparator.
+- (instancetype)initWithComparator:(NSComparator)comparator NS_DESIGNATED_INITIALIZER;
+
+/// Create a data source ordered by sort descriptors.
+- (instancetype)initWithSortDescriptors:(NSArray<NSSortDescriptor *> *)sortDescriptors;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The comparator that orders the items.
+@property (nonatomic, copy, readonly) NSComparator comparator;
+
+/// Insert item at its sorted position and return that position.
+- (NSUInteger)addItem:(id)item;
+
+/// Merge a batch of items into the sorted items with a single insertion.
+- (void)addItems:(NSArray *)items;
+
+/// Remove item, located by binary search. Does nothing if item isn't present.
+- (void)removeItem:(id)item;
+
+/// Move the item at index to where it now belongs, after a change to a property it is sorted by. Sends a move, or a refresh when the item stays put.
+- (void)repositionItemAtIndex:(NSUInteger)index;
+
+/// Reposition item, which is found by identity because its sort key has changed. Does nothing if item isn't present.
+- (void)repositionItem:(id)item;
+
+@end
+
+NS_ASSUME_NONNULL_END
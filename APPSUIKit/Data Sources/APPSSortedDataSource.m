@@ -0,0 +1,189 @@
+//
+//  APPSSortedDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSSortedDataSource.h"
+
+/// The key-value coding mutators APPSBasicDataSource implements for its items. Each sends a single notification.
+@interface APPSBasicDataSource (APPSItemsKeyValueCoding)
+- (void)insertItems:(NSArray *)array atIndexes:(NSIndexSet *)indexes;
+- (void)removeItemsAtIndexes:(NSIndexSet *)indexes;
+- (void)replaceItemsAtIndexes:(NSIndexSet *)indexes withItems:(NSArray *)array;
+@end
+
+
+@interface APPSSortedDataSource ()
+@property (nonatomic, copy, readwrite) NSComparator comparator;
+@end
+
+@implementation APPSSortedDataSource
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithComparator:(NSComparator)comparator
+{
+    NSParameterAssert(comparator != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _comparator = [comparator copy];
+    return self;
+}
+
+
+- (instancetype)initWithSortDescriptors:(NSArray<NSSortDescriptor *> *)sortDescriptors
+{
+    NSParameterAssert(sortDescriptors.count > 0);
+
+    NSArray<NSSortDescriptor *> *descriptors = [sortDescriptors copy];
+    return [self initWithComparator:^NSComparisonResult(id item1, id item2) {
+        for (NSSortDescriptor *descriptor in descriptors) {
+            NSComparisonResult result = [descriptor compareObject:item1 toObject:item2];
+            if (result != NSOrderedSame)
+                return result;
+        }
+        return NSOrderedSame;
+    }];
+}
+
+
+
+#pragma mark - Property Overrides
+
+- (void)setItems:(NSArray *)items animated:(BOOL)animated
+{
+    [super setItems:[items sortedArrayWithOptions:NSSortStable usingComparator:self.comparator] animated:animated];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (NSUInteger)addItem:(id)item
+{
+    NSParameterAssert(item != nil);
+
+    NSUInteger index = [self insertionIndexForItem:item inItems:self.items];
+    [self insertItems:@[item] atIndexes:[NSIndexSet indexSetWithIndex:index]];
+    return index;
+}
+
+
+- (void)addItems:(NSArray *)items
+{
+    if (!items.count)
+        return;
+
+    if (items.count == 1) {
+        [self addItem:items.firstObject];
+        return;
+    }
+
+    NSComparator comparator = self.comparator;
+    NSArray *newItems = [items sortedArrayWithOptions:NSSortStable usingComparator:comparator];
+    NSArray *existingItems = self.items;
+    NSUInteger existingCount = existingItems.count;
+
+    // Merge the two sorted runs, recording where each new item lands in the combined array. Existing items win ties so earlier additions stay first.
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    NSUInteger existingIndex = 0;
+    NSUInteger mergedIndex = 0;
+
+    for (id newItem in newItems) {
+        while (existingIndex < existingCount && comparator(existingItems[existingIndex], newItem) != NSOrderedDescending) {
+            ++existingIndex;
+            ++mergedIndex;
+        }
+        [indexes addIndex:mergedIndex++];
+    }
+
+    [self insertItems:newItems atIndexes:indexes];
+}
+
+
+- (void)removeItem:(id)item
+{
+    NSUInteger index = [self indexOfItem:item];
+    if (index == NSNotFound)
+        return;
+
+    [self removeItemsAtIndexes:[NSIndexSet indexSetWithIndex:index]];
+}
+
+
+- (void)repositionItemAtIndex:(NSUInteger)index
+{
+    NSArray *items = self.items;
+    NSParameterAssert(index < items.count);
+
+    id item = items[index];
+    NSUInteger newIndex = [self insertionIndexForItem:item inItems:items skippingIndex:index];
+
+    if (newIndex == index)
+        [self replaceItemsAtIndexes:[NSIndexSet indexSetWithIndex:index] withItems:@[item]];
+    else
+        [self moveItemAtIndex:index toIndex:newIndex];
+}
+
+
+- (void)repositionItem:(id)item
+{
+    NSUInteger index = [self.items indexOfObjectIdenticalTo:item];
+    if (index == NSNotFound)
+        return;
+
+    [self repositionItemAtIndex:index];
+}
+
+
+
+#pragma mark - Helper
+
+/// The position after any items that compare equal to item, so equal items stay in the order they were added.
+- (NSUInteger)insertionIndexForItem:(id)item inItems:(NSArray *)items
+{
+    return [items indexOfObject:item inSortedRange:NSMakeRange(0, items.count) options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual usingComparator:self.comparator];
+}
+
+
+/// Where the item at index belongs among the other items, which are still in order around it. Only the side it moves to is searched, so the items aren't copied.
+- (NSUInteger)insertionIndexForItem:(id)item inItems:(NSArray *)items skippingIndex:(NSUInteger)index
+{
+    NSComparator comparator = self.comparator;
+    NSUInteger count = items.count;
+
+    if (index > 0 && comparator(item, items[index - 1]) == NSOrderedAscending)
+        return [items indexOfObject:item inSortedRange:NSMakeRange(0, index) options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual usingComparator:comparator];
+
+    if (index + 1 < count && comparator(items[index + 1], item) != NSOrderedDescending) {
+        // Found among the items after index, then shifted down for the item taken out ahead of them.
+        NSRange range = NSMakeRange(index + 1, count - index - 1);
+        return [items indexOfObject:item inSortedRange:range options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual usingComparator:comparator] - 1;
+    }
+
+    return index;
+}
+
+
+/// Binary search for the run of items comparing equal to item, then pick the one that is equal to it.
+- (NSUInteger)indexOfItem:(id)item
+{
+    NSArray *items = self.items;
+    NSComparator comparator = self.comparator;
+    NSUInteger index = [items indexOfObject:item inSortedRange:NSMakeRange(0, items.count) options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual usingComparator:comparator];
+
+    for (NSUInteger count = items.count; index < count && comparator(items[index], item) == NSOrderedSame; ++index) {
+        if ([items[index] isEqual:item])
+            return index;
+    }
+
+    return NSNotFound;
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  APPSStreamingDataSource.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSDataSource.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A single-section data source for live streams such as logs and chat, where items arrive at the end and the oldest fall off the front.
+
+ Items are kept in a fixed-capacity ring buffer, so appending an item or trimming the oldest one costs O(1) whatever the number of rows. Removing an item elsewhere, such as by swipe-to-delete, shifts whichever side of it is shorter. Appends may come from any thread. They're collected and applied on the main thread at most once per batchInterval, each batch notifying one contiguous removal at the front and one contiguous insertion at the end. Once capacity is reached, every append trims the oldest item.
+
+ Subclasses provide cells by overriding -tableView:cellForRowAtIndexPath:. To follow the stream as it grows, set keepsScrolledToBottom on the APPSBaseDataSourceDelegate.
+ */
+@interface APPSStreamingDataSource : APPSDataSource
+
+/// Create a streaming data source holding at most capacity items.
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The most items shown at once.
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/// The number of items currently shown. Appended items aren't counted until their batch is applied.
+@property (nonatomic, readonly) NSUInteger numberOfItems;
+
+/// How long appends are collected before they're applied. Defaults to 0, applying them on the next turn of the main run loop. Atomic, because appends read it on the producer's thread.
+@property (atomic) NSTimeInterval batchInterval;
+
+/// Queue an item to be appended. May be called from any thread.
+- (void)appendItem:(id)item;
+
+/// Queue items to be appended, in order. May be called from any thread.
+- (void)appendItems:(NSArray *)items;
+
+/// Apply queued appends now rather than waiting for the batch interval. Must be called on the main thread.
+- (void)flushPendingItems;
+
+/// Remove the oldest count items. Must be called within -performUpdate:.
+- (void)trimOldestItems:(NSUInteger)count;
+
+/// Remove every item, including queued appends. Must be called within -performUpdate:.
+- (void)removeAllItems;
+
+@end
+
+NS_ASSUME_NONNULL_END
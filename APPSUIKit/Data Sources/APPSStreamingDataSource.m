@@ -0,0 +1,257 @@
+//
+//  APPSStreamingDataSource.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSStreamingDataSource.h"
+
+@import Darwin.os.lock;
+
+
+@interface APPSStreamingDataSource ()
+/// The ring buffer: capacity slots, with the oldest item at head. Empty slots hold NSNull.
+@property (nonatomic, strong) NSMutableArray *buffer;
+@property (nonatomic) NSUInteger head;
+@property (nonatomic) NSUInteger numberOfItems;
+@end
+
+@implementation APPSStreamingDataSource {
+    /// Guards _pendingItems and _flushScheduled, which are touched from producer threads.
+    os_unfair_lock _pendingLock;
+    NSMutableArray *_pendingItems;
+    BOOL _flushScheduled;
+}
+
+
+#pragma mark - Instantiation
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    NSParameterAssert(capacity > 0);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _capacity = capacity;
+    _buffer = [NSMutableArray arrayWithCapacity:capacity];
+    for (NSUInteger slot = 0; slot < capacity; ++slot)
+        [_buffer addObject:[NSNull null]];
+
+    _pendingLock = OS_UNFAIR_LOCK_INIT;
+    _pendingItems = [NSMutableArray array];
+    return self;
+}
+
+
+
+#pragma mark - APPSDataSource
+
+- (void)resetContent
+{
+    [super resetContent];
+    [self performUpdate:^{
+        [self removeAllItems];
+    }];
+}
+
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)sectionIndex
+{
+    return _numberOfItems;
+}
+
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfItems)
+        return nil;
+
+    return _buffer[(_head + row) % _capacity];
+}
+
+
+- (NSArray *)indexPathsForItem:(id)item
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSUInteger row = 0; row < _numberOfItems; ++row) {
+        if ([_buffer[(_head + row) % _capacity] isEqual:item])
+            [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+    }
+    return indexPaths;
+}
+
+
+- (void)removeItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    NSUInteger row = indexPath.row;
+    if (row >= _numberOfItems)
+        return;
+
+    [self performUpdate:^{
+        [self notifyItemsRemovedAtIndexPaths:@[[NSIndexPath indexPathForRow:row inSection:0]]];
+        [self removeItemFromBufferAtRow:row];
+        [self updateLoadingState];
+    }];
+}
+
+
+
+#pragma mark - Public Interface
+
+- (void)appendItem:(id)item
+{
+    NSParameterAssert(item != nil);
+    [self appendItems:@[item]];
+}
+
+
+- (void)appendItems:(NSArray *)items
+{
+    if (!items.count)
+        return;
+
+    os_unfair_lock_lock(&_pendingLock);
+    [_pendingItems addObjectsFromArray:items];
+    BOOL needsFlush = !_flushScheduled;
+    _flushScheduled = YES;
+    os_unfair_lock_unlock(&_pendingLock);
+
+    // Only the first append of a batch schedules the flush; the rest ride along with it.
+    if (!needsFlush)
+        return;
+
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [weakSelf flushPendingItems];
+    });
+}
+
+
+- (void)flushPendingItems
+{
+    NSAssert([NSThread isMainThread], @"This method must be called on the main thread");
+
+    os_unfair_lock_lock(&_pendingLock);
+    NSArray *items = _pendingItems;
+    _pendingItems = [NSMutableArray array];
+    _flushScheduled = NO;
+    os_unfair_lock_unlock(&_pendingLock);
+
+    if (!items.count)
+        return;
+
+    [self performUpdate:^{
+        [self appendItemsToBuffer:items];
+    }];
+}
+
+
+- (void)trimOldestItems:(NSUInteger)count
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+
+    count = MIN(count, _numberOfItems);
+    if (!count)
+        return;
+
+    [self notifyItemsRemovedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(0, count)]];
+    [self dropOldestItems:count];
+    [self updateLoadingState];
+}
+
+
+- (void)removeAllItems
+{
+    APPS_ASSERT_IN_DATASOURCE_UPDATE();
+
+    os_unfair_lock_lock(&_pendingLock);
+    [_pendingItems removeAllObjects];
+    os_unfair_lock_unlock(&_pendingLock);
+
+    [self trimOldestItems:_numberOfItems];
+    _head = 0;
+}
+
+
+
+#pragma mark - Ring Buffer
+
+/// Append items to the ring, overwriting the oldest slots once it's full. Notifies one removal at the front and one insertion at the end.
+- (void)appendItemsToBuffer:(NSArray *)items
+{
+    NSUInteger numberOfItems = items.count;
+
+    // A batch larger than the ring only leaves its newest capacity items behind.
+    NSUInteger firstKeptItem = numberOfItems > _capacity ? numberOfItems - _capacity : 0;
+    NSUInteger numberOfKeptItems = numberOfItems - firstKeptItem;
+
+    NSUInteger overflow = _numberOfItems + numberOfKeptItems > _capacity ? _numberOfItems + numberOfKeptItems - _capacity : 0;
+    if (overflow)
+        [self notifyItemsRemovedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(0, overflow)]];
+
+    [self dropOldestItems:overflow];
+
+    for (NSUInteger index = firstKeptItem; index < numberOfItems; ++index)
+        _buffer[(_head + _numberOfItems++) % _capacity] = items[index];
+
+    // Removals are in the old coordinates and insertions in the new, so within one update they don't overlap.
+    [self notifyItemsInsertedAtIndexPaths:[self indexPathsForRowsInRange:NSMakeRange(_numberOfItems - numberOfKeptItems, numberOfKeptItems)]];
+    [self updateLoadingState];
+}
+
+
+/// Close the gap a removed row leaves by shifting whichever side of it is shorter, so removal costs at most half the items.
+- (void)removeItemFromBufferAtRow:(NSUInteger)row
+{
+    if (row < _numberOfItems / 2) {
+        // Shift the older items one slot towards the newer ones, then drop the vacated oldest slot.
+        for (NSUInteger index = row; index > 0; --index)
+            _buffer[(_head + index) % _capacity] = _buffer[(_head + index - 1) % _capacity];
+        [self dropOldestItems:1];
+    }
+    else {
+        // Shift the newer items one slot towards the older ones, then clear the vacated newest slot.
+        for (NSUInteger index = row; index + 1 < _numberOfItems; ++index)
+            _buffer[(_head + index) % _capacity] = _buffer[(_head + index + 1) % _capacity];
+        _buffer[(_head + _numberOfItems - 1) % _capacity] = [NSNull null];
+        _numberOfItems--;
+    }
+}
+
+
+- (void)dropOldestItems:(NSUInteger)count
+{
+    for (NSUInteger index = 0; index < count; ++index) {
+        _buffer[_head] = [NSNull null];
+        _head = (_head + 1) % _capacity;
+    }
+    _numberOfItems -= count;
+}
+
+
+
+#pragma mark - Helper
+
+- (NSArray<NSIndexPath *> *)indexPathsForRowsInRange:(NSRange)range
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:range.length];
+    for (NSUInteger row = range.location; row < NSMaxRange(range); ++row)
+        [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+    return indexPaths;
+}
+
+
+- (void)updateLoadingState
+{
+    NSString *loadingState = self.loadingState;
+    if (_numberOfItems && [loadingState isEqualToString:APPSLoadStateNoContent])
+        self.loadingState = APPSLoadStateContentLoaded;
+    else if (!_numberOfItems && [loadingState isEqualToString:APPSLoadStateContentLoaded])
+        self.loadingState = APPSLoadStateNoContent;
+}
+
+@end
@@ -5,6 +5,7 @@
 //
 
 #import "APPSTableViewHeaderFooterView.h"
+#import "APPSInstantiationPool.h"
 
 @implementation APPSTableViewHeaderFooterView
 
@@ -13,7 +14,7 @@
 + (UINib *)nib;
 {
     NSString *nibName = NSStringFromClass(self.class);
-    UINib *nib = [UINib nibWithNibName:nibName bundle:nil];
+    UINib *nib = [[APPSInstantiationPool sharedPool] nibWithNibName:nibName bundle:nil];
     
     return nib;
 }
@@ -21,7 +22,7 @@
 
 - (UINib *)nib;
 {
-    UINib *nib = [UINib nibWithNibName:self.nibName bundle:nil];
+    UINib *nib = [[APPSInstantiationPool sharedPool] nibWithNibName:self.nibName bundle:nil];
 
     return nib;
 }
@@ -0,0 +1,72 @@
+//
+//  APPSTextLayoutSpec.h
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import UIKit;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Describes how a cell lays out its height-determining text: the text attributes, the insets between the
+ text and the cell's content view, any line or height limits, and the accessory that narrows the content view.
+
+ Specs are immutable, so a spec can be used to measure text with TextKit on a background queue. Heights
+ computed this way can be stored in an APPSRowHeightCache, leaving only frame assignment to the main thread.
+ */
+@interface APPSTextLayoutSpec : NSObject <NSCopying>
+
+/// Create a spec from text attributes and the insets surrounding the text within the cell's content view.
++ (instancetype)specWithAttributes:(NSDictionary<NSString *, id> *)attributes insets:(UIEdgeInsets)insets;
+
+/// Create a spec with a single font.
++ (instancetype)specWithFont:(UIFont *)font insets:(UIEdgeInsets)insets;
+
+/// Create a spec that mirrors the font, alignment and line limit of a label. For an APPSDesignerLabel, its line height multiple and leading are captured too. Must be called on the main thread.
++ (instancetype)specWithLabel:(UILabel *)label insets:(UIEdgeInsets)insets;
+
+/// As +specWithLabel:insets:, for a cell that shows the given accessory.
++ (instancetype)specWithLabel:(UILabel *)label insets:(UIEdgeInsets)insets accessoryType:(UITableViewCellAccessoryType)accessoryType;
+
+/// Create a spec with no line or height limits, for a cell without an accessory.
+- (instancetype)initWithAttributes:(NSDictionary<NSString *, id> *)attributes insets:(UIEdgeInsets)insets;
+
+- (instancetype)initWithAttributes:(NSDictionary<NSString *, id> *)attributes
+                            insets:(UIEdgeInsets)insets
+              maximumNumberOfLines:(NSUInteger)maximumNumberOfLines
+                     minimumHeight:(CGFloat)minimumHeight
+                     accessoryType:(UITableViewCellAccessoryType)accessoryType NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The attributes applied to the measured text.
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, id> *attributes;
+
+/// The space between the text and the edges of the cell's content view.
+@property (nonatomic, readonly) UIEdgeInsets insets;
+
+/// The maximum number of lines, or 0 for no limit.
+@property (nonatomic, readonly) NSUInteger maximumNumberOfLines;
+
+/// The height is never reported smaller than this value.
+@property (nonatomic, readonly) CGFloat minimumHeight;
+
+/// The accessory the cell shows. It takes its width out of the content view, so the text is measured in what remains.
+@property (nonatomic, readonly) UITableViewCellAccessoryType accessoryType;
+
+/// Measure the content view height needed to display text at the given content view width. Safe to call from any thread.
+- (CGFloat)heightForText:(NSString *)text width:(CGFloat)width;
+
+@end
+
+
+/// Adopted by cell classes that can declare their text layout, so their heights can be precomputed.
+@protocol APPSTextLayoutSpecProviding <NSObject>
+
+/// The text layout spec describing instances of this cell class.
++ (APPSTextLayoutSpec *)textLayoutSpec;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,119 @@
+//
+//  APPSTextLayoutSpec.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+#import "APPSTextLayoutSpec.h"
+#import "APPSDesignerLabel.h"
+
+@implementation APPSTextLayoutSpec
+
+
+#pragma mark - Instantiation
+
++ (instancetype)specWithAttributes:(NSDictionary<NSString *, id> *)attributes insets:(UIEdgeInsets)insets
+{
+    return [[self alloc] initWithAttributes:attributes insets:insets];
+}
+
+
++ (instancetype)specWithFont:(UIFont *)font insets:(UIEdgeInsets)insets
+{
+    NSParameterAssert(font != nil);
+    return [self specWithAttributes:@{ NSFontAttributeName : font } insets:insets];
+}
+
+
++ (instancetype)specWithLabel:(UILabel *)label insets:(UIEdgeInsets)insets
+{
+    return [self specWithLabel:label insets:insets accessoryType:UITableViewCellAccessoryNone];
+}
+
+
++ (instancetype)specWithLabel:(UILabel *)label insets:(UIEdgeInsets)insets accessoryType:(UITableViewCellAccessoryType)accessoryType
+{
+    NSParameterAssert(label != nil);
+
+    NSMutableParagraphStyle *paragraphStyle = [[NSMutableParagraphStyle alloc] init];
+    paragraphStyle.alignment = label.textAlignment;
+    paragraphStyle.lineBreakMode = NSLineBreakByWordWrapping;
+
+    if ([label isKindOfClass:[APPSDesignerLabel class]]) {
+        APPSDesignerLabel *designerLabel = (APPSDesignerLabel *)label;
+        paragraphStyle.lineHeightMultiple = designerLabel.lineHeightMultiple;
+        paragraphStyle.lineSpacing = designerLabel.leading;
+    }
+
+    return [[self alloc] initWithAttributes:@{ NSFontAttributeName : label.font,
+                                               NSParagraphStyleAttributeName : [paragraphStyle copy] }
+                                     insets:insets
+                       maximumNumberOfLines:label.numberOfLines
+                              minimumHeight:0
+                              accessoryType:accessoryType];
+}
+
+
+- (instancetype)initWithAttributes:(NSDictionary<NSString *, id> *)attributes insets:(UIEdgeInsets)insets
+{
+    return [self initWithAttributes:attributes insets:insets maximumNumberOfLines:0 minimumHeight:0 accessoryType:UITableViewCellAccessoryNone];
+}
+
+
+- (instancetype)initWithAttributes:(NSDictionary<NSString *, id> *)attributes
+                            insets:(UIEdgeInsets)insets
+              maximumNumberOfLines:(NSUInteger)maximumNumberOfLines
+                     minimumHeight:(CGFloat)minimumHeight
+                     accessoryType:(UITableViewCellAccessoryType)accessoryType
+{
+    NSParameterAssert(attributes != nil);
+
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _attributes = [attributes copy];
+    _insets = insets;
+    _maximumNumberOfLines = maximumNumberOfLines;
+    _minimumHeight = minimumHeight;
+    _accessoryType = accessoryType;
+    return self;
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Specs are immutable.
+    return self;
+}
+
+
+
+#pragma mark - Measuring
+
+- (CGFloat)heightForText:(NSString *)text width:(CGFloat)width
+{
+    UIEdgeInsets insets = self.insets;
+    CGFloat textWidth = MAX(0, width - insets.left - insets.right);
+    CGFloat textHeight = 0;
+
+    if (text.length && textWidth > 0) {
+        // Each measurement gets its own TextKit stack, so measurements are safe to run concurrently off the main thread.
+        NSTextStorage *textStorage = [[NSTextStorage alloc] initWithString:text attributes:self.attributes];
+        NSLayoutManager *layoutManager = [[NSLayoutManager alloc] init];
+        NSTextContainer *textContainer = [[NSTextContainer alloc] initWithSize:CGSizeMake(textWidth, CGFLOAT_MAX)];
+        textContainer.lineFragmentPadding = 0;
+        textContainer.maximumNumberOfLines = self.maximumNumberOfLines;
+
+        [layoutManager addTextContainer:textContainer];
+        [textStorage addLayoutManager:layoutManager];
+        [layoutManager ensureLayoutForTextContainer:textContainer];
+
+        textHeight = ceil(CGRectGetHeight([layoutManager usedRectForTextContainer:textContainer]));
+    }
+
+    return MAX(self.minimumHeight, textHeight + insets.top + insets.bottom);
+}
+
+@end
@@ -51,6 +51,12 @@
 
 + (instancetype)activityController;
 
+/**
+ Keeps an instance ready ahead of time, in the shared APPSInstantiationPool, so that
+ @c +activityController returns quickly. Call it once, say at launch.
+ */
++ (void)prepareActivityControllers;
+
 
 
 #pragma mark - Configuration
@@ -5,6 +5,7 @@
 //
 
 #import "APPSActivityStatusViewController.h"
+#import "APPSInstantiationPool.h"
 #import "APPSSimplePresentationController.h"
 #import "UIView+Appstronomy.h"
 #import <APPSUIKit/APPSUIKit-Swift.h>
@@ -62,8 +63,23 @@
 
 + (instancetype)activityController;
 {
-    return [[[self class] alloc] initWithNibName:@"APPSActivityStatusViewController"
-                                          bundle:[APPSUIKit bundle]];
+    // Use the instance the pool made ahead of time, if there is one:
+    id controller = [[APPSInstantiationPool sharedPool] dequeueViewControllerOfClass:[self class]
+                                                                             nibName:@"APPSActivityStatusViewController"
+                                                                              bundle:[APPSUIKit bundle]];
+
+    return controller ?: [[[self class] alloc] initWithNibName:@"APPSActivityStatusViewController"
+                                                        bundle:[APPSUIKit bundle]];
+}
+
+
++ (void)prepareActivityControllers;
+{
+    // Load the view ahead of time too; -viewWillAppear: applies the model values the caller sets afterwards:
+    [[APPSInstantiationPool sharedPool] registerViewControllerClass:[self class]
+                                                            nibName:@"APPSActivityStatusViewController"
+                                                             bundle:[APPSUIKit bundle]
+                                                          loadsView:YES];
 }
 
 
@@ -100,6 +116,15 @@
 
 #pragma mark - Lifecycle
 
+- (void)loadView
+{
+    // Use the nib the pool has already read, rather than reading it again by name:
+    if (![[APPSInstantiationPool sharedPool] loadViewFromNibOfViewController:self]) {
+        [super loadView];
+    }
+}
+
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
@@ -113,6 +138,15 @@
 }
 
 
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+
+    // A pooled instance loaded its view before the caller configured it:
+    [self updateView];
+}
+
+
 - (void)viewDidLayoutSubviews;
 {
     [super viewDidLayoutSubviews];
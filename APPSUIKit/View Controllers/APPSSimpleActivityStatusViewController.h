@@ -174,6 +174,13 @@ static const CGFloat kAPPSSimpleActivityStatus_DefaultDialogVerticalCenteringOff
 + (instancetype)activityController;
 
 
+/**
+ Keeps an instance ready ahead of time, in the shared @c APPSInstantiationPool, so that
+ @c +activityController returns quickly. Call it once, say at launch.
+ */
++ (void)prepareActivityControllers;
+
+
 
 #pragma mark - Requests
 
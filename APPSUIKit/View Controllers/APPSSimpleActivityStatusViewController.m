@@ -7,6 +7,7 @@
 @import APPSFoundation;
 
 #import "APPSSimpleActivityStatusViewController.h"
+#import "APPSInstantiationPool.h"
 #import "APPSSimplePresentationController.h"
 #import "UIColor+Appstronomy.h"
 #import "UIView+Appstronomy.h"
@@ -59,8 +60,23 @@
 
 + (instancetype)activityController;
 {
-    return [[[self class] alloc] initWithNibName:@"APPSBlurBasedActivityStatusViewController"
-                                          bundle:[APPSUIKit bundle]];
+    // Use the instance the pool made ahead of time, if there is one:
+    id controller = [[APPSInstantiationPool sharedPool] dequeueViewControllerOfClass:[self class]
+                                                                             nibName:@"APPSBlurBasedActivityStatusViewController"
+                                                                              bundle:[APPSUIKit bundle]];
+
+    return controller ?: [[[self class] alloc] initWithNibName:@"APPSBlurBasedActivityStatusViewController"
+                                                        bundle:[APPSUIKit bundle]];
+}
+
+
++ (void)prepareActivityControllers;
+{
+    // Load the view ahead of time too; -viewWillAppear: applies the model values the caller sets afterwards:
+    [[APPSInstantiationPool sharedPool] registerViewControllerClass:[self class]
+                                                            nibName:@"APPSBlurBasedActivityStatusViewController"
+                                                             bundle:[APPSUIKit bundle]
+                                                          loadsView:YES];
 }
 
 
@@ -109,6 +125,15 @@
 
 #pragma mark - Lifecycle
 
+- (void)loadView
+{
+    // Use the nib the pool has already read, rather than reading it again by name:
+    if (![[APPSInstantiationPool sharedPool] loadViewFromNibOfViewController:self]) {
+        [super loadView];
+    }
+}
+
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
@@ -117,6 +142,15 @@
 }
 
 
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+
+    // A pooled instance loaded its view before the caller configured it:
+    [self configure];
+}
+
+
 - (void)viewDidLayoutSubviews
 {
     [super viewDidLayoutSubviews];
@@ -7,6 +7,7 @@
 //
 
 #import "APPSTaggedNaming.h"
+#import "APPSPrewarming.h"
 #import "APPSBaseViewController.h"
 
 #pragma mark - Container Controller
@@ -32,6 +33,7 @@ typedef NS_ENUM(NSUInteger, APPSContainerControllerTransitionDirection) {
 
 
 @class APPSContainerViewController;
+@protocol APPSTransitionMetricsSink;
 
 /**
  Provides the ability for any UIViewController to access its closest container controller, if one exists
@@ -75,6 +77,26 @@ typedef NS_ENUM(NSUInteger, APPSContainerControllerTransitionDirection) {
 @property(strong, nonatomic) UIView *containerView;
 @property(strong, nonatomic) NSString *taggedName;
 
+/**
+ The view controller we expect to transition to next, if known. Setting it has us prepare that view controller
+ (loading its content too, if it adopts APPSPrewarming) once the run loop is next idle, so that the transition to it
+ starts from a warm view. We let go of it once it becomes our child.
+ */
+@property(strong, nonatomic) UIViewController *predictedNextViewController;
+
+#pragma mark scalar
+/**
+ How many of the topmost child view controllers keep their views loaded when we receive a memory warning.
+ Defaults to 2: the visible view controller and the one below it, which a reveal or modal dismissal would expose.
+ */
+@property(assign, nonatomic) NSUInteger residentChildViewBudget;
+
+/// How many child views we've unloaded under memory pressure, over our lifetime.
+@property(readonly, nonatomic) NSUInteger evictedChildViewCount;
+
+/// How many of those unloaded child views we've since reloaded, because their controllers were shown again.
+@property(readonly, nonatomic) NSUInteger restoredChildViewCount;
+
 
 #pragma mark - Initialization
 
@@ -165,6 +187,16 @@ typedef NS_ENUM(NSUInteger, APPSContainerControllerTransitionDirection) {
 - (void)apps_removeChildViewController:(UIViewController *)markedForRemovalViewController;
 
 
+/**
+ Removes several child view controllers at once. The info stack is updated in a single pass, and
+ all of their views are torn down in a single layout transaction, so clearing out a deep stack of
+ children costs about what removing one does. Controllers that aren't our children are ignored.
+
+ @param markedForRemovalViewControllers The view controllers we will remove as children of ours.
+ */
+- (void)removeChildViewControllers:(NSArray *)markedForRemovalViewControllers;
+
+
 /**
  Removes all of our child view controllers except the one that is currently visible.
  Useful to trim down our resource footprint to just that which is immediately visible.
@@ -173,9 +205,8 @@ typedef NS_ENUM(NSUInteger, APPSContainerControllerTransitionDirection) {
 
 
 /**
- Removes all child view controllers with the specified taggedName. Uses recursion to eliminate multiple
- matches (although having more than one child view controller instance in the Container with the same
- taggedName is bad form).
+ Removes all child view controllers with the specified taggedName, in a single batch (although having
+ more than one child view controller instance in the Container with the same taggedName is bad form).
  
  @param taggedName The name to search for amongst our child view controllers.
  */
@@ -183,6 +214,91 @@ typedef NS_ENUM(NSUInteger, APPSContainerControllerTransitionDirection) {
 
 
 
+#pragma mark - Memory Management
+
+/**
+ Unloads the views of all child view controllers below our residentChildViewBudget, leaving each one's place in our
+ container view held by a snapshot of it. The children themselves, and their data, stay with us. A child's view is
+ reloaded on demand, the next time a transition or placement brings that child back.
+ 
+ We call this ourselves when we receive a memory warning.
+ 
+ @return The number of child views unloaded.
+ */
+- (NSUInteger)evictOffscreenChildViews;
+
+
+
+#pragma mark - Pre-warming
+
+/**
+ Does the work that would otherwise happen synchronously on the first frame of a transition to the view controller
+ specified: loading its view and laying it out at our container view's size. Any of our transitions to it then start
+ from a warm view. Calling this more than once is cheap; the view is only laid out again if our size has changed.
+ 
+ @param viewController A view controller we're likely to transition to, that isn't yet our child.
+ @param loadContent Whether to also ask the view controller to start loading its content, if it adopts APPSPrewarming.
+ */
+- (void)prepareViewControllerForTransition:(UIViewController *)viewController loadContent:(BOOL)loadContent;
+
+
+
+#pragma mark - Transitions: Interaction
+
+/**
+ Whether one of our push, cover or reveal transitions is in flight. Starting any transition or placement while one is,
+ brings the one in flight to its end immediately (completion blocks and all), rather than waiting for it.
+ */
+@property(readonly, nonatomic, getter=isTransitioning) BOOL transitioning;
+
+/**
+ How far along the transition in flight is, from 0.0 to 1.0. Setting it scrubs a paused transition.
+ */
+@property(assign, nonatomic) CGFloat transitionFractionComplete;
+
+/**
+ The time our last push, cover or reveal transition took, from its start to its completion, including any time spent
+ being driven interactively.
+ */
+@property(readonly, nonatomic) NSTimeInterval lastTransitionDuration;
+
+/**
+ Receives the phase-by-phase timing (view load, layout, animation start, first frame, completion) and dropped frame
+ count of every transition and placement we perform. An APPSTransitionMetrics aggregates them into per-route
+ percentiles. Nothing is measured while this is nil, which it is by default.
+ */
+@property(strong, nonatomic) id<APPSTransitionMetricsSink> transitionMetricsSink;
+
+/**
+ Brings the transition in flight, if any, to its end immediately.
+ */
+- (void)finishTransition;
+
+/**
+ Pauses the transition in flight, so that it can be scrubbed through transitionFractionComplete.
+ */
+- (void)pauseTransition;
+
+/**
+ Resumes a paused transition. When reversed, the transition animates back to where it started, and is undone:
+ the incoming view controller is put back as it was, and the transition's completion block is passed NO.
+ 
+ @param reversed Whether to head back to the start of the transition, rather than on to its end.
+ */
+- (void)continueTransitionReversed:(BOOL)reversed;
+
+/**
+ Drives the transition in flight from a pan gesture, along the transition's direction. Call this from the action of a
+ pan gesture recognizer of your own. For a fully interactive transition, start the transition when the gesture begins,
+ then call this. On the gesture's end, we finish or reverse the transition depending on how far, and how fast,
+ it was moved.
+ 
+ @param recognizer The pan gesture recognizer driving the transition.
+ */
+- (void)updateTransitionWithPanGestureRecognizer:(UIPanGestureRecognizer *)recognizer;
+
+
+
 #pragma mark - Transitions: Placements
 
 /**
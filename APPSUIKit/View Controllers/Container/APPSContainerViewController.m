@@ -11,8 +11,20 @@
 #import "APPSContainerViewController.h"
 #import "APPSViewControllerInfoStackEntry.h"
 #import "APPSViewControllerInfoStack.h"
+#import "APPSTransitionMetrics_Private.h"
 #import "UIView+Appstronomy.h"
 
+/// The UIViewAnimationOptions bits that select a UIKit transition style, such as a flip or cross dissolve.
+static const UIViewAnimationOptions APPSTransitionStyleOptionsMask = (7 << 20);
+
+/// The curve selected by the curve bits of UIViewAnimationOptions, whose values line up with UIViewAnimationCurve's.
+static UIViewAnimationCurve APPSAnimationCurveFromOptions(UIViewAnimationOptions options)
+{
+    return (UIViewAnimationCurve)((options >> 16) & 0x3);
+}
+
+
+
 @implementation UIViewController (APPSContainerViewController)
 
 /**
@@ -66,6 +78,24 @@
  Our record of active child controllers and their method of presentation:
  */
 @property (strong, nonatomic) APPSViewControllerInfoStack *infoStack;
+
+/**
+ View controllers we've prepared ahead of a transition to them, and not yet shown:
+ */
+@property (strong, nonatomic) NSHashTable *preparedViewControllers;
+
+/**
+ The animator running our push, cover or reveal transition, while one is in flight:
+ */
+@property (strong, nonatomic) UIViewPropertyAnimator *transitionAnimator;
+
+#pragma mark scalar
+@property (assign, nonatomic) NSUInteger evictedChildViewCount;
+@property (assign, nonatomic) NSUInteger restoredChildViewCount;
+@property (assign, nonatomic) APPSContainerControllerTransitionDirection transitionDirection;
+@property (assign, nonatomic) CFTimeInterval transitionStartTime;
+@property (assign, nonatomic) CGFloat transitionPanStartFraction;
+@property (assign, nonatomic) NSTimeInterval lastTransitionDuration;
 @end
 
 
@@ -84,6 +114,8 @@
         // Initialize the custom data structure that holds child view controllers with information about
         // the presentation transition type and direction:
         self.infoStack = [[APPSViewControllerInfoStack alloc] initWithContainmentController:self];
+        self.residentChildViewBudget = 2; // The visible view controller, and the one a reveal would expose.
+        self.preparedViewControllers = [NSHashTable weakObjectsHashTable];
         [self.infoStack addEntryForController:rootViewController
                                transitionType:APPSContainerControllerTransitionType_None
                           transitionDirection:APPSContainerControllerTransitionDirection_None];
@@ -178,7 +210,8 @@
 {
     [super didReceiveMemoryWarning];
     
-    // FUTURE: Consider jettisoning everything but the last two view controllers in order to free up memory.
+    // Hold on to our child view controllers, but let go of the views that nobody can see:
+    [self evictOffscreenChildViews];
 }
 
 
@@ -229,16 +262,12 @@
 
 - (UIViewController *)existingChildViewControllerWithTaggedName:(NSString *)taggedName;
 {
-    for (UIViewController *iteratedViewController in self.childViewControllers) {
-        if ([iteratedViewController conformsToProtocol:@protocol(APPSTaggedNaming)]) {
-            // Create local variable reference properly typed (for human readability!):
-            id <APPSTaggedNaming> nameTaggedViewController = (id <APPSTaggedNaming>)iteratedViewController;
-            
-            // Does this view controller have the tagged name we seek?
-            if ([nameTaggedViewController.taggedName isEqual:taggedName]) {
-                // YES: We found a match!
-                return iteratedViewController; 
-            }
+    // Our info stack indexes its entries by tagged name, so there's no need to walk our child view controllers:
+    for (APPSViewControllerInfoStackEntry *iteratedEntry in [self.infoStack entriesWithTaggedName:taggedName]) {
+        // Has this controller actually become our child yet? (Our root view controller isn't, until we first appear.)
+        if (iteratedEntry.controller.parentViewController == self) {
+            // YES: We found a match!
+            return iteratedEntry.controller;
         }
     }
 
@@ -318,7 +347,14 @@
 
 - (void)prepareIncomingChildViewController:(UIViewController *)incomingViewController
 {
-    // Adjust the incoming controller's view frame to fit in our container exactly:
+    // Is this the view controller we predicted would be next? It has arrived, so we needn't hold on to it any longer:
+    if (incomingViewController == self.predictedNextViewController) {
+        self.predictedNextViewController = nil;
+    }
+    [self.preparedViewControllers removeObject:incomingViewController];
+
+    // Adjust the incoming controller's view frame to fit in our container exactly. If we prepared the view ahead of
+    // time at this same size, this leaves its layout untouched:
     incomingViewController.view.frame = self.containerView.bounds;
     
     // Allow the incoming controller's view to fluidly expand/contract with that of our containerView:
@@ -375,8 +411,10 @@
  We are the workhorse of animating in a new child view controller, and optionally animating and removing the previously
  current child view controller.
  
- When removing a 'from' view controller, we use the iOS container view controller method for transitioning
- from one view controller to another.
+ The animation runs on a UIViewPropertyAnimator that we keep as our transitionAnimator while it's in flight. That lets
+ a new transition bring it to an early end instead of waiting for it, and lets it be driven interactively. Only when
+ a UIKit transition style (flip, curl, cross dissolve) is requested along with removing the 'from' view controller,
+ do we fall back to the iOS container view controller method for transitioning from one view controller to another.
  
  When simply adding in a new 'to' view controller, we just animate the 'to' view controller in without disrupting
  the current child view controller's status with us, its parent.
@@ -384,24 +422,28 @@
  @param fromViewController The view controller we are transitioning from (typically, the currently visible one).
  @param toViewController The new, incoming view controller to be added as a child controller.
  @param duration The duration of the transition animation.
- @param options Bitwise OR of UIViewAnimationOptions.
+ @param direction The direction of the transition, which is the direction an interactive pan drives it in.
+ @param options Bitwise OR of UIViewAnimationOptions. The curve and user interaction options carry over to the animator.
  @param removeFromAsChild Whether to remove the 'from' view controller as a child of ours, once the transition completes.
  @param incomingAlreadyAChild Whether or not the incoming view controller is already a child of ours.
+ @param timing The timing our caller started for this transition, if anyone is listening, which we finish once the transition ends.
  @param animations A block of code representing properties to be animated.
  @param completion A block of code to run after the transition completes.
  */
 - (void)processTransitionFromViewController:(UIViewController *)fromViewController
                            toViewController:(UIViewController *)toViewController
                                    duration:(NSTimeInterval)duration
+                                  direction:(APPSContainerControllerTransitionDirection)direction
                                     options:(UIViewAnimationOptions)options
                           removeFromAsChild:(BOOL)removeFromAsChild
                       incomingAlreadyAChild:(BOOL)incomingAlreadyAChild
+                                     timing:(APPSTransitionTiming *)timing
                                  animations:(void (^)())animations
                                  completion:(void (^)(BOOL finished))completion;
 {
-    // Were we asked to remove the previously visible view controller after the transition?
-    if (removeFromAsChild) {
-        // YES: So we're going to transition from the currently visible controller to the new:
+    // Were we asked for a transition style (such as a flip or cross dissolve) that only UIKit can perform?
+    if (removeFromAsChild && (options & APPSTransitionStyleOptionsMask)) {
+        // YES: So we're going to transition from the currently visible controller to the new, the way UIKit does it:
         [self transitionFromViewController:fromViewController
                           toViewController:toViewController
                                   duration:duration
@@ -415,37 +457,162 @@
                                     // Remove the 'from' view controller:
                                     [fromViewController removeFromParentViewController];
                                     [self.infoStack removeEntryForController:fromViewController];
+                                    [timing finishReversed:NO recordingToSink:self.transitionMetricsSink];
                                     
                                     // Process completion block, if we were given one:
                                     if (completion) { completion(YES); }
                                 }];
+
+        [timing markPhase:APPSTransitionPhaseAnimationStart];
+        [timing beginTrackingFrames];
+        return;
     }
-    else {
-        // NO: We're just going to animate in the new 'to' view controller without removing the 'from'.
-        // Add the child view controller's view to our containerView, if it isn't already present. If
-        // it was already present, we'd want it to stay however it already was (origin, layer, etc.).
+
+    // Is the 'from' view controller on its way out? Let it know it's disappearing:
+    if (removeFromAsChild) {
+        [fromViewController beginAppearanceTransition:NO animated:(duration > 0)];
+    }
+
+    // Add the child view controller's view to our containerView, if it isn't already present, or if it needs to come
+    // to the top to replace the 'from' view controller. Otherwise, we'd want it to stay however it already was.
+    if (!incomingAlreadyAChild || removeFromAsChild) {
+        [self.containerView addSubview:toViewController.view];
+    }
+
+    // Build the animation on an animator, so that it can be paused, scrubbed, reversed, or brought to an early end:
+    UIViewPropertyAnimator *animator = [[UIViewPropertyAnimator alloc] initWithDuration:duration
+                                                                                  curve:APPSAnimationCurveFromOptions(options)
+                                                                             animations:animations];
+    animator.userInteractionEnabled = ((options & UIViewAnimationOptionAllowUserInteraction) != 0);
+
+    __weak UIViewPropertyAnimator *weakAnimator = animator;
+    [animator addCompletion:^(UIViewAnimatingPosition finalPosition) {
+        // Is this still the transition we consider in flight? (It won't be, if it was ended early for a newer one.)
+        if (self.transitionAnimator == weakAnimator) {
+            self.transitionAnimator = nil;
+        }
+
+        self.lastTransitionDuration = CACurrentMediaTime() - self.transitionStartTime;
+
+        // Was the transition reversed back to where it started?
+        if (finalPosition == UIViewAnimatingPositionStart) {
+            // YES: Undo the bookkeeping we did up front, as if the transition never happened:
+            [self unwindTransitionFromViewController:fromViewController
+                                    toViewController:toViewController
+                                   removeFromAsChild:removeFromAsChild
+                               incomingAlreadyAChild:incomingAlreadyAChild];
+            [timing finishReversed:YES recordingToSink:self.transitionMetricsSink];
+
+            if (completion) { completion(NO); }
+            return;
+        }
+
+        // Remove the 'from' view controller's view, now that the 'to' view controller has taken its place:
+        if (removeFromAsChild) {
+            [fromViewController.view removeFromSuperview];
+            [fromViewController endAppearanceTransition];
+        }
+
         if (!incomingAlreadyAChild) {
-            [self.containerView addSubview:toViewController.view];
+            [toViewController didMoveToParentViewController:self];
         }
 
-        // Do the the actual animation now:
-        [UIView animateWithDuration:duration
-                              delay:0.0
-                            options:options
-                         animations:animations
-                         completion:^(BOOL finished) {
-                             if (!incomingAlreadyAChild) {
-                                [toViewController didMoveToParentViewController:self];
-                             }
+        // Remove the 'from' view controller:
+        if (removeFromAsChild) {
+            [fromViewController removeFromParentViewController];
+            [self.infoStack removeEntryForController:fromViewController];
+        }
+
+        [timing finishReversed:NO recordingToSink:self.transitionMetricsSink];
+
+        // Process completion block, if we were given one:
+        if (completion) { completion(YES); }
+    }];
+
+    self.transitionAnimator = animator;
+    self.transitionDirection = direction;
+    self.transitionStartTime = CACurrentMediaTime();
+
+    // Do the the actual animation now:
+    [animator startAnimation];
+
+    [timing markPhase:APPSTransitionPhaseAnimationStart];
+    [timing beginTrackingFrames];
+}
+
+
+/**
+ Reverses the bookkeeping a transition does up front (child, info stack, view and appearance changes), for when an
+ interactive transition is cancelled and animates back to where it started.
+ */
+- (void)unwindTransitionFromViewController:(UIViewController *)fromViewController
+                          toViewController:(UIViewController *)toViewController
+                         removeFromAsChild:(BOOL)removeFromAsChild
+                     incomingAlreadyAChild:(BOOL)incomingAlreadyAChild
+{
+    // Was the 'from' view controller on its way out? It's staying after all:
+    if (removeFromAsChild) {
+        [fromViewController beginAppearanceTransition:YES animated:YES];
+        [fromViewController endAppearanceTransition];
+        [fromViewController didMoveToParentViewController:self];
+    }
 
-                             // Process completion block, if we were given one:
-                             if (completion) { completion(YES); }
-                         }];
+    // Was the 'to' view controller already our child?
+    if (incomingAlreadyAChild) {
+        // YES: Put it back below the view controller we were transitioning from:
+        [self.infoStack reorderEntryForController:toViewController belowEntryForController:fromViewController];
+        [self.containerView insertSubview:toViewController.view belowSubview:fromViewController.view];
+    }
+    else {
+        // NO: Then it shouldn't be one now:
+        [toViewController willMoveToParentViewController:nil];
+        [self.infoStack removeEntryForController:toViewController];
+        [toViewController.view removeFromSuperview];
+        [toViewController removeFromParentViewController];
     }
 }
 
 
 
+#pragma mark Utilities: Timing
+
+/**
+ Starts timing a transition or placement, when we have a sink to report it to.
+ 
+ @return The timing to mark the phases of the transition on, or nil when nobody is listening.
+ */
+- (APPSTransitionTiming *)timingForTransitionFromViewController:(UIViewController *)fromViewController
+                                               toViewController:(UIViewController *)toViewController
+                                                 transitionType:(APPSContainerControllerTransitionType)transitionType
+                                                 transitionName:(NSString *)transitionName
+{
+    if (!self.transitionMetricsSink) {
+        return nil;
+    }
+
+    return [[APPSTransitionTiming alloc] initWithFromViewController:fromViewController
+                                                   toViewController:toViewController
+                                                     transitionType:transitionType
+                                                     transitionName:transitionName];
+}
+
+
+/**
+ When timing a transition, we lay out the incoming view once it's sized and positioned, rather than leave that to the
+ first frame, so that the two phases can be told apart.
+ */
+- (void)layOutIncomingViewController:(UIViewController *)toViewController timing:(APPSTransitionTiming *)timing
+{
+    if (!timing) {
+        return;
+    }
+
+    [toViewController.view layoutIfNeeded];
+    [timing markPhase:APPSTransitionPhaseLayout];
+}
+
+
+
 #pragma mark Utilities: Slide Transition
 
 /**
@@ -600,47 +767,345 @@
     @"The provided view controller '%@' is not already a child of this Container Controller, "
             "and it must be in order to use this method.", markedForRemovalViewController);
 
-    // Prepare the existing view controller for removal:
-    [markedForRemovalViewController willMoveToParentViewController:nil];
+    [self removeChildViewControllers:@[markedForRemovalViewController]];
+}
+
+
+- (void)removeChildViewControllers:(NSArray *)markedForRemovalViewControllers
+{
+    // Settle the whole set up front: just our own children, each once.
+    NSMutableOrderedSet *removals = [NSMutableOrderedSet orderedSetWithCapacity:markedForRemovalViewControllers.count];
+    for (UIViewController *candidate in markedForRemovalViewControllers) {
+        if (candidate.parentViewController == self) {
+            [removals addObject:candidate];
+        }
+    }
+
+    if (removals.count == 0) {
+        return;
+    }
 
-    // Update the info stack of our child view controllers:
-    [self.infoStack removeEntryForController:markedForRemovalViewController];
+    // Prepare the existing view controllers for removal, and note the snapshots standing in for any views we unloaded:
+    NSMutableArray *evictedViewSnapshots = [NSMutableArray array];
+    for (UIViewController *markedForRemovalViewController in removals) {
+        [markedForRemovalViewController willMoveToParentViewController:nil];
 
-    // Remove the view from our containerView:
-    [markedForRemovalViewController.view removeFromSuperview];
+        UIView *snapshot = [self.infoStack entryForController:markedForRemovalViewController].evictedViewSnapshot;
+        if (snapshot) {
+            [evictedViewSnapshots addObject:snapshot];
+        }
+    }
 
-    // Formally remove the existing controller from being our child:
-    [markedForRemovalViewController removeFromParentViewController];
+    // Update the info stack of our child view controllers, in one pass:
+    [self.infoStack removeEntriesForControllers:removals.array];
+
+    // Tear down all of the views in one transaction, so the container lays out and commits once rather than per child.
+    // (We remove views without reloading them, just to remove them, if we had unloaded them.)
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [UIView performWithoutAnimation:^{
+        [evictedViewSnapshots makeObjectsPerformSelector:@selector(removeFromSuperview)];
+
+        for (UIViewController *markedForRemovalViewController in removals) {
+            [markedForRemovalViewController.viewIfLoaded removeFromSuperview];
+        }
+    }];
+    [CATransaction commit];
+
+    // Formally remove the existing controllers from being our children:
+    for (UIViewController *markedForRemovalViewController in removals) {
+        [markedForRemovalViewController removeFromParentViewController];
+    }
 }
 
 
 - (void)removeAllChildrenExceptVisibleViewController
 {
-    // Iterate through all of our child view controllers:
-   for (UIViewController *iteratedChildViewController in self.childViewControllers) {
-       // Is this iterated controller something other than the visible child controller?
-       if (![iteratedChildViewController isEqual:self.visibleViewController]) {
-           // YES: This is not the visible child controller, so get rid of it:
-           [self apps_removeChildViewController:iteratedChildViewController];
-       }
-   }
-
-   [self logContentsWithNote:@"Removed all child view controllers except the visible"];
+    // Take a copy of our child view controllers, since removing them changes the original as we'd walk it:
+    NSMutableArray *removals = [self.childViewControllers mutableCopy];
+
+    // Keep the visible child controller, and get rid of the rest:
+    UIViewController *visibleViewController = self.visibleViewController;
+    if (visibleViewController) {
+        [removals removeObjectIdenticalTo:visibleViewController];
+    }
+
+    [self removeChildViewControllers:removals];
+
+    [self logContentsWithNote:@"Removed all child view controllers except the visible"];
 }
 
 
 - (void)removeAllChildViewControllersWithTaggedName:(NSString *)taggedName
 {
-    // Look for a matching child view controller (we'll get the first match back, even if there are multiple):
-    UIViewController *matchingChildController = [self existingChildViewControllerWithTaggedName:taggedName];
-    
-    // Did we find one?
-    if (matchingChildController) {
-        // YES: Remove that view controller:
-        [self apps_removeChildViewController:matchingChildController];
-        
-        // Recursively call ourselves in case there is another match we can remove:
-        [self removeAllChildViewControllersWithTaggedName:taggedName];
+    // Gather every matching child view controller at once, from the info stack's tagged name index:
+    NSMutableArray *matchingChildControllers = [NSMutableArray array];
+    for (APPSViewControllerInfoStackEntry *matchingEntry in [self.infoStack entriesWithTaggedName:taggedName]) {
+        if (matchingEntry.controller) {
+            [matchingChildControllers addObject:matchingEntry.controller];
+        }
+    }
+
+    [self removeChildViewControllers:matchingChildControllers];
+}
+
+
+
+#pragma mark - Memory Management
+
+- (NSUInteger)evictOffscreenChildViews
+{
+    NSArray *entries = [self.infoStack allEntries];
+    NSUInteger residentCount = MAX(self.residentChildViewBudget, (NSUInteger)1); // We never unload the visible view.
+
+    // Do we have any child view controllers beyond our budget?
+    if (entries.count <= residentCount) {
+        // NO: Nothing to do.
+        return 0;
+    }
+
+    NSUInteger evictedCount = 0;
+
+    // Iterate through the entries below those we keep resident, which are at the end of the info stack:
+    for (APPSViewControllerInfoStackEntry *iteratedEntry in [entries subarrayWithRange:NSMakeRange(0, entries.count - residentCount)]) {
+        UIViewController *controller = iteratedEntry.controller;
+
+        // Is this a view we've already unloaded, or one that isn't sitting in our container view?
+        if (iteratedEntry.evictedViewSnapshot || controller.parentViewController != self ||
+            controller.viewIfLoaded.superview != self.containerView) {
+            // YES: Leave it be; we can only stand in for views that we placed ourselves.
+            continue;
+        }
+
+        // Snapshots can only be taken while we're in a window. Otherwise, an empty view at least keeps the layering:
+        UIView *view = controller.view;
+        UIView *snapshot = (view.window ? [view snapshotViewAfterScreenUpdates:NO] : nil) ?: [[UIView alloc] init];
+        snapshot.frame = view.frame;
+        snapshot.autoresizingMask = view.autoresizingMask;
+        snapshot.userInteractionEnabled = NO;
+
+        // Swap in the snapshot where the view was, then unload the view. UIKit reloads it the next time it's asked for.
+        [self.containerView insertSubview:snapshot aboveSubview:view];
+        [view removeFromSuperview];
+        controller.view = nil;
+
+        iteratedEntry.evictedViewSnapshot = snapshot;
+        evictedCount++;
+    }
+
+    self.evictedChildViewCount += evictedCount;
+    logInfo(@"Unloaded %lu child views in response to memory pressure.", (unsigned long)evictedCount);
+
+    return evictedCount;
+}
+
+
+/**
+ Reloads the view of a child view controller whose view we unloaded, putting it back exactly where its snapshot
+ stood in for it. We do nothing for children whose views were never unloaded, so every transition and placement
+ calls this for the controllers it's about to show or layer against.
+ 
+ @param controller A child view controller of ours.
+ */
+- (void)restoreEvictedViewOfChildViewController:(UIViewController *)controller
+{
+    APPSViewControllerInfoStackEntry *entry = [self.infoStack entryForController:controller];
+    UIView *snapshot = entry.evictedViewSnapshot;
+
+    // Did we unload this controller's view?
+    if (!snapshot) {
+        // NO: Its view is where it always was.
+        return;
+    }
+
+    entry.evictedViewSnapshot = nil;
+
+    // Reload the view, and put it in the snapshot's place, including any partial cover/reveal offset it had:
+    [self prepareIncomingChildViewController:controller];
+    controller.view.frame = snapshot.frame;
+    [self.containerView insertSubview:controller.view aboveSubview:snapshot];
+    [snapshot removeFromSuperview];
+
+    self.restoredChildViewCount++;
+}
+
+
+
+#pragma mark - Pre-warming
+
+- (void)prepareViewControllerForTransition:(UIViewController *)viewController loadContent:(BOOL)loadContent
+{
+    // Is this view controller already our child?
+    if (viewController.parentViewController == self) {
+        // YES: Then it's as warm as it's going to get.
+        return;
+    }
+
+    // Loading the view is the expensive part: nib decoding, viewDidLoad and the like.
+    UIView *view = viewController.view;
+
+    // We can only lay the view out at our size once we know that size:
+    if (self.isViewLoaded) {
+        // Does the view need laying out at our container view's current size?
+        if (!CGSizeEqualToSize(view.bounds.size, self.containerView.bounds.size) || ![self.preparedViewControllers containsObject:viewController]) {
+            // YES: Size it just as the transition would, and lay it out now:
+            view.frame = self.containerView.bounds;
+            view.autoresizingMask = UIViewAutoresizingFlexibleHeight | UIViewAutoresizingFlexibleWidth;
+            [view setNeedsLayout];
+            [view layoutIfNeeded];
+        }
+
+        [self.preparedViewControllers addObject:viewController];
+    }
+
+    // Were we asked to get the content loading too, and can the view controller do that?
+    if (loadContent && [viewController conformsToProtocol:@protocol(APPSPrewarming)]) {
+        [(id <APPSPrewarming>)viewController prewarmContent];
+    }
+}
+
+
+- (void)setPredictedNextViewController:(UIViewController *)predictedNextViewController
+{
+    _predictedNextViewController = predictedNextViewController;
+
+    // Prepare it when the run loop is next idle. Default mode only, so that we stay out of the way of scrolling:
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(preparePredictedNextViewController) object:nil];
+    if (predictedNextViewController) {
+        [self performSelector:@selector(preparePredictedNextViewController) withObject:nil afterDelay:0 inModes:@[NSDefaultRunLoopMode]];
+    }
+}
+
+
+- (void)preparePredictedNextViewController
+{
+    if (self.predictedNextViewController) {
+        [self prepareViewControllerForTransition:self.predictedNextViewController loadContent:YES];
+    }
+}
+
+
+
+#pragma mark - Transitions: Interaction
+
+- (BOOL)isTransitioning
+{
+    return (self.transitionAnimator != nil);
+}
+
+
+- (void)finishTransition
+{
+    UIViewPropertyAnimator *animator = self.transitionAnimator;
+
+    // Do we have a transition in flight?
+    if (!animator) {
+        // NO: Nothing to do.
+        return;
+    }
+
+    // Jump it to wherever it was headed; its completion handler runs right away, so its bookkeeping is settled
+    // before whoever called us starts on theirs:
+    [animator stopAnimation:NO];
+    [animator finishAnimationAtPosition:(animator.reversed ? UIViewAnimatingPositionStart : UIViewAnimatingPositionEnd)];
+}
+
+
+- (void)pauseTransition
+{
+    [self.transitionAnimator pauseAnimation];
+}
+
+
+- (CGFloat)transitionFractionComplete
+{
+    return self.transitionAnimator.fractionComplete;
+}
+
+
+- (void)setTransitionFractionComplete:(CGFloat)transitionFractionComplete
+{
+    self.transitionAnimator.fractionComplete = MIN(MAX(transitionFractionComplete, 0.0), 1.0);
+}
+
+
+- (void)continueTransitionReversed:(BOOL)reversed
+{
+    UIViewPropertyAnimator *animator = self.transitionAnimator;
+
+    if (!animator) {
+        return;
+    }
+
+    // Take only as long as the remaining distance calls for:
+    CGFloat remainingFraction = (reversed ? animator.fractionComplete : 1.0 - animator.fractionComplete);
+
+    animator.reversed = reversed;
+    [animator continueAnimationWithTimingParameters:nil durationFactor:remainingFraction];
+}
+
+
+- (void)updateTransitionWithPanGestureRecognizer:(UIPanGestureRecognizer *)recognizer
+{
+    // Do we have a transition in flight to drive?
+    if (!self.transitionAnimator) {
+        // NO: Nothing to do.
+        return;
+    }
+
+    // Work out how far along the transition's direction the pan has moved, as a fraction of our container's size:
+    CGPoint translation = [recognizer translationInView:self.containerView];
+    CGPoint velocity = [recognizer velocityInView:self.containerView];
+    CGFloat distance = 0.0;
+    CGFloat speed = 0.0;
+    CGFloat extent = 1.0;
+
+    switch (self.transitionDirection) {
+        case APPSContainerControllerTransitionDirection_Left:
+            distance = -translation.x; speed = -velocity.x; extent = self.containerView.bounds.size.width;
+            break;
+        case APPSContainerControllerTransitionDirection_Right:
+            distance = translation.x; speed = velocity.x; extent = self.containerView.bounds.size.width;
+            break;
+        case APPSContainerControllerTransitionDirection_Up:
+            distance = -translation.y; speed = -velocity.y; extent = self.containerView.bounds.size.height;
+            break;
+        case APPSContainerControllerTransitionDirection_Down:
+            distance = translation.y; speed = velocity.y; extent = self.containerView.bounds.size.height;
+            break;
+
+        default:
+            break;
+    }
+
+    extent = MAX(extent, 1.0);
+
+    switch (recognizer.state) {
+        case UIGestureRecognizerStateBegan:
+            // Catch the transition wherever it is, and scrub from there:
+            [self pauseTransition];
+            self.transitionAnimator.reversed = NO;
+            self.transitionPanStartFraction = self.transitionFractionComplete;
+            break;
+
+        case UIGestureRecognizerStateChanged:
+            self.transitionFractionComplete = self.transitionPanStartFraction + (distance / extent);
+            break;
+
+        case UIGestureRecognizerStateEnded: {
+            // Finish if the transition is past half way once we project a little way along the flick, otherwise reverse:
+            CGFloat projectedFraction = self.transitionFractionComplete + (speed * 0.15 / extent);
+            [self continueTransitionReversed:(projectedFraction < 0.5)];
+            break;
+        }
+
+        case UIGestureRecognizerStateCancelled:
+        case UIGestureRecognizerStateFailed:
+            [self continueTransitionReversed:YES];
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -655,6 +1120,22 @@
     // Are we being asked to re-order view placement to and from the same thing?
     if (incomingViewController == existingViewController) { return; } // Nothing to do.
 
+    // Is a transition still in flight? Bring it to its end right away, so that we layer against settled views:
+    [self finishTransition];
+
+    // Start timing the placement, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:existingViewController
+                                                              toViewController:incomingViewController
+                                                                transitionType:APPSContainerControllerTransitionType_None
+                                                                transitionName:@"PlaceBelow"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:existingViewController];
+    [self restoreEvictedViewOfChildViewController:incomingViewController];
+
+    [incomingViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     APPSAssert([self.childViewControllers containsObject:existingViewController],
     @"The existing view controller '%@' is not already a child of this Container Controller, "
             "and it must be in order to use this method.", existingViewController);
@@ -693,6 +1174,10 @@
         [incomingViewController didMoveToParentViewController:self];
     }
 
+    // Without an animation, the placement work all counts as layout; it's complete once its frame is on screen:
+    [timing markPhase:APPSTransitionPhaseLayout];
+    [timing finishAfterFirstFrameRecordingToSink:self.transitionMetricsSink];
+
     if (completion) { completion(YES); }
 }
 
@@ -704,6 +1189,22 @@
     // Are we being asked to re-order view placement to and from the same thing?
     if (incomingViewController == existingViewController) { return; } // Nothing to do.
 
+    // Is a transition still in flight? Bring it to its end right away, so that we layer against settled views:
+    [self finishTransition];
+
+    // Start timing the placement, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:existingViewController
+                                                              toViewController:incomingViewController
+                                                                transitionType:APPSContainerControllerTransitionType_None
+                                                                transitionName:@"PlaceAbove"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:existingViewController];
+    [self restoreEvictedViewOfChildViewController:incomingViewController];
+
+    [incomingViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     [self logContentsWithNote:@"Prior to placement above"];
 
     APPSAssert([self.childViewControllers containsObject:existingViewController],
@@ -750,6 +1251,10 @@
 
     [self logContentsWithNote:@"After placement above"];
 
+    // Without an animation, the placement work all counts as layout; it's complete once its frame is on screen:
+    [timing markPhase:APPSTransitionPhaseLayout];
+    [timing finishAfterFirstFrameRecordingToSink:self.transitionMetricsSink];
+
     if (completion) { completion(YES); }
 }
 
@@ -761,6 +1266,22 @@
     // Are we being asked to re-order view placement to and from the same thing?
     if (incomingViewController == existingViewController) { return; } // Nothing to do.
 
+    // Is a transition still in flight? Bring it to its end right away, so that we layer against settled views:
+    [self finishTransition];
+
+    // Start timing the placement, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:existingViewController
+                                                              toViewController:incomingViewController
+                                                                transitionType:APPSContainerControllerTransitionType_None
+                                                                transitionName:@"Swap"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:existingViewController];
+    [self restoreEvictedViewOfChildViewController:incomingViewController];
+
+    [incomingViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     APPSAssert([self.childViewControllers containsObject:existingViewController],
     @"The existing view controller '%@' is not already a child of this Container Controller, "
             "and it must be in order to use this method.", existingViewController);
@@ -802,6 +1323,10 @@
     // Formally remove the existing controller from being our child:
     [existingViewController removeFromParentViewController];
 
+    // Without an animation, the placement work all counts as layout; it's complete once its frame is on screen:
+    [timing markPhase:APPSTransitionPhaseLayout];
+    [timing finishAfterFirstFrameRecordingToSink:self.transitionMetricsSink];
+
     if (completion) { completion(YES); }
 }
 
@@ -818,12 +1343,28 @@
                                        start:(void (^)(void))start
                                   completion:(void (^)(BOOL))completion;
 {
+    // Is a transition still in flight? Bring it to its end right away, rather than queue up behind it:
+    [self finishTransition];
+
     // Was a fromViewController not specified? It isn't mandatory; we'll just assume the currently visible controller.
     if (!fromViewController) { fromViewController = self.visibleViewController; }
 
     // Are we being asked to transition to and from the same thing?
     if (fromViewController == toViewController) { return; } // Nothing to do.
 
+    // Start timing the transition, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:fromViewController
+                                                              toViewController:toViewController
+                                                                transitionType:APPSContainerControllerTransitionType_Push
+                                                                transitionName:@"Push"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:fromViewController];
+    [self restoreEvictedViewOfChildViewController:toViewController];
+
+    [toViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     // Notify:
     // Were we asked to remove the previously visible view controller after the transition?
     if (removeFromAsChild) { [fromViewController willMoveToParentViewController:nil]; }
@@ -857,6 +1398,9 @@
                            transitionType:APPSContainerControllerTransitionType_Push
                       transitionDirection:direction];
 
+    // Lay out, if we're timing the transition:
+    [self layOutIncomingViewController:toViewController timing:timing];
+
     // Process pre-transition block, if we were given one:
     if (start) {start();}
 
@@ -864,9 +1408,11 @@
     [self processTransitionFromViewController:fromViewController
                              toViewController:toViewController
                                      duration:duration
+                                    direction:direction
                                       options:options
                             removeFromAsChild:removeFromAsChild
                         incomingAlreadyAChild:incomingViewControllerAlreadyOurChild
+                                       timing:timing
                                    animations:^{
                                        [self applyDestinationPositionsForSlideTransitionFromViewController:fromViewController
                                                                                           toViewController:toViewController
@@ -889,12 +1435,28 @@
                                     start:(void (^)(void))start
                                completion:(void (^)(BOOL))completion;
 {
+    // Is a transition still in flight? Bring it to its end right away, rather than queue up behind it:
+    [self finishTransition];
+
     // Was a fromViewController not specified? It isn't mandatory; we'll just assume the currently visible controller.
     if (!fromViewController) { fromViewController = self.visibleViewController; }
 
     // Are we being asked to transition to and from the same thing?
     if (fromViewController == toViewController) { return; } // Nothing to do.
 
+    // Start timing the transition, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:fromViewController
+                                                              toViewController:toViewController
+                                                                transitionType:APPSContainerControllerTransitionType_Cover
+                                                                transitionName:@"Cover"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:fromViewController];
+    [self restoreEvictedViewOfChildViewController:toViewController];
+
+    [toViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     // Notify:
     // Were we asked to remove the previously visible view controller after the transition?
     if (removeFromAsChild) { [fromViewController willMoveToParentViewController:nil]; }
@@ -925,6 +1487,9 @@
                            transitionType:APPSContainerControllerTransitionType_Cover
                       transitionDirection:direction];
 
+    // Lay out, if we're timing the transition:
+    [self layOutIncomingViewController:toViewController timing:timing];
+
     // Process pre-transition block, if we were given one:
     if (start) { start(); }
 
@@ -932,9 +1497,11 @@
     [self processTransitionFromViewController:fromViewController
                              toViewController:toViewController
                                      duration:duration
+                                    direction:direction
                                       options:options
                             removeFromAsChild:removeFromAsChild
                         incomingAlreadyAChild:incomingViewControllerAlreadyOurChild
+                                       timing:timing
                                    animations:^{
         [self applyDestinationPositionForCoverTransitionWithToViewController:toViewController
                                                                    direction:direction
@@ -956,12 +1523,28 @@
                                      start:(void (^)(void))start
                                 completion:(void (^)(BOOL))completion;
 {
+    // Is a transition still in flight? Bring it to its end right away, rather than queue up behind it:
+    [self finishTransition];
+
     // Was a fromViewController not specified? It isn't mandatory; we'll just assume the currently visible controller.
     if (!fromViewController) { fromViewController = self.visibleViewController; }
 
     // Are we being asked to transition to and from the same thing?
     if (fromViewController == toViewController) { return; } // Nothing to do.
 
+    // Start timing the transition, if anyone is listening:
+    APPSTransitionTiming *timing = [self timingForTransitionFromViewController:fromViewController
+                                                              toViewController:toViewController
+                                                                transitionType:APPSContainerControllerTransitionType_Reveal
+                                                                transitionName:@"Reveal"];
+
+    // Reload either view if we unloaded it under memory pressure:
+    [self restoreEvictedViewOfChildViewController:fromViewController];
+    [self restoreEvictedViewOfChildViewController:toViewController];
+
+    [toViewController loadViewIfNeeded];
+    [timing markPhase:APPSTransitionPhaseViewLoad];
+
     // Determine if the incoming view controller is already our child:
     BOOL incomingViewControllerAlreadyOurChild = ([self.childViewControllers containsObject:toViewController]);
 
@@ -1001,6 +1584,9 @@
                            transitionType:APPSContainerControllerTransitionType_Reveal
                       transitionDirection:direction];
 
+    // Lay out, if we're timing the transition:
+    [self layOutIncomingViewController:toViewController timing:timing];
+
     // Process pre-transition block, if we were given one:
     if (start) { start(); }
 
@@ -1008,9 +1594,11 @@
     [self processTransitionFromViewController:fromViewController
                              toViewController:toViewController
                                      duration:duration
+                                    direction:direction
                                       options:options
                             removeFromAsChild:removeFromAsChild
                         incomingAlreadyAChild:incomingViewControllerAlreadyOurChild
+                                       timing:timing
             animations:^{
                 // Add the child view controller's view to our containerView, below the
                 // currently visible view.
@@ -1108,6 +1696,7 @@
     
     // Ensure the controller we will return to, is positioned at origin {0,0}, since these seem to have moved on us!
     UIViewController *controllerReturnedTo = [self childViewControllerToReturnToForModalDismissal];
+    [self restoreEvictedViewOfChildViewController:controllerReturnedTo];
     if (controllerReturnedTo) {
         [controllerReturnedTo.view apps_setFrameOrigin:CGPointZero];
     }
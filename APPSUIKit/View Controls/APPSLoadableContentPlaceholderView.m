@@ -18,7 +18,15 @@
 @property (nonatomic, strong) UILabel *titleLabel;
 @property (nonatomic, strong) UILabel *messageLabel;
 @property (nonatomic, strong) UIButton *actionButton;
-@property (nonatomic, strong) NSArray *constraints;
+/// The image view, title, message and button, in the order they stack from the top of the container.
+@property (nonatomic, strong) NSArray *stackedViews;
+/// The constraints placing a stacked view, or the container's bottom, below a predecessor: the container's top or one of the
+/// stacked views above it. Made the first time that pairing shows, then kept and switched on and off as views show and hide.
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSLayoutConstraint *> *stackingConstraints;
+/// For each stacked view, the constraints it only needs while it's showing.
+@property (nonatomic, strong) NSArray *visibleOnlyConstraints;
+/// The stacking and visible-only constraints currently active.
+@property (nonatomic, strong) NSArray *activeStackConstraints;
 @end
 
 @implementation APPSLoadableContentPlaceholderView
@@ -82,6 +90,7 @@
     
     [self addSubview:_containerView];
     
+    [self _createStackConstraints];
     [self _updateViewHierarchy];
     
     // Constrain the container to the host view. The height of the container will be determined by the contents.
@@ -146,45 +155,26 @@
 
 - (void)_updateViewHierarchy
 {
-	if (_image) {
-		[_containerView addSubview:_imageView];
-		_imageView.image = _image;
-	}
-	else
-		[_imageView removeFromSuperview];
+	// The subviews stay in the container; missing content just hides them, so their constraints survive for reuse.
+	_imageView.image = _image;
+	_imageView.hidden = (_image == nil);
 	
-	if (_title) {
-		[_containerView addSubview:_titleLabel];
-		_titleLabel.text = _title;
-	}
-	else
-		[_titleLabel removeFromSuperview];
+	_titleLabel.text = _title;
+	_titleLabel.hidden = (_title == nil);
 	
-	if (_message) {
-		[_containerView addSubview:_messageLabel];
-		_messageLabel.text = _message;
-	}
-	else
-		[_messageLabel removeFromSuperview];
+	_messageLabel.text = _message;
+	_messageLabel.hidden = (_message == nil);
 	
-	if (_buttonTitle) {
-		[_containerView addSubview:_actionButton];
-		[_actionButton setTitle:_buttonTitle forState:UIControlStateNormal];
-	}
-	else {
-		[_actionButton removeFromSuperview];
-	}
+	[_actionButton setTitle:_buttonTitle forState:UIControlStateNormal];
+	_actionButton.hidden = (_buttonTitle == nil);
 	
-	if (_constraints)
-		[_containerView removeConstraints:_constraints];
-	_constraints = nil;
 	[self setNeedsUpdateConstraints];
 }
 
 
 - (void)setImage:(UIImage *)image
 {
-	if ([image isEqual:_image])
+	if (image == _image || [image isEqual:_image])
 		return;
 	
 	_image = image;
@@ -194,9 +184,7 @@
 
 - (void)setTitle:(NSString *)title
 {
-	NSAssert(title && [title length], @"Title cannot be nil or empty");
-	
-	if ([title isEqualToString:_title])
+	if (title == _title || [title isEqualToString:_title])
 		return;
 	
 	_title = [title copy];
@@ -207,7 +195,7 @@
 
 - (void)setMessage:(NSString *)message
 {
-	if ([message isEqualToString:_message])
+	if (message == _message || [message isEqualToString:_message])
 		return;
 	
 	_message = [message copy];
@@ -218,7 +206,7 @@
 
 - (void)setButtonTitle:(NSString *)buttonTitle
 {
-	if ([buttonTitle isEqualToString:_buttonTitle])
+	if (buttonTitle == _buttonTitle || [buttonTitle isEqualToString:_buttonTitle])
 		return;
 	
 	_buttonTitle = [buttonTitle copy];
@@ -234,74 +222,197 @@
 }
 
 
+- (void)_createStackConstraints
+{
+	NSDictionary *views = NSDictionaryOfVariableBindings(_imageView, _titleLabel, _messageLabel, _actionButton);
+	_stackedViews = @[_imageView, _titleLabel, _messageLabel, _actionButton];
+	
+	// Always in force, whether or not the view is showing: an empty label or a hidden button takes up no room here.
+	NSMutableArray *constraints = [NSMutableArray array];
+	// horizontally center the image
+	[constraints addObject:[NSLayoutConstraint constraintWithItem:_imageView attribute:NSLayoutAttributeCenterX relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeCenterX multiplier:1.0 constant:0]];
+	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_titleLabel]|" options:0 metrics:nil views:views]];
+	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_messageLabel]|" options:0 metrics:nil views:views]];
+	[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeCenterX relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeCenterX multiplier:1.0 constant:0]];
+	[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:BUTTON_HEIGHT]];
+	[NSLayoutConstraint activateConstraints:constraints];
+	
+	// Only in force while the view is showing, because they would size the container around nothing:
+	_visibleOnlyConstraints = @[
+		// Force the container to be at least as wide as the image
+		[NSLayoutConstraint constraintsWithVisualFormat:@"H:|-(>=0)-[_imageView]-(>=0)-|" options:0 metrics:nil views:views],
+		@[],
+		@[],
+		@[[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeWidth relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:BUTTON_WIDTH]],
+	];
+	
+	_stackingConstraints = [NSMutableDictionary dictionary];
+	_activeStackConstraints = @[];
+}
+
+
+/// The constraint placing the stacked view at index, or the container's bottom when index is past the last one, below position: 0 for the container's top, n for the nth stacked view.
+- (NSLayoutConstraint *)_stackingConstraintAtIndex:(NSUInteger)index belowPosition:(NSUInteger)position
+{
+	NSNumber *key = @(index * (_stackedViews.count + 1) + position);
+	NSLayoutConstraint *constraint = _stackingConstraints[key];
+	if (constraint)
+		return constraint;
+	
+	// What each stacked view offers the one below it, and how far below it that one sits:
+	NSLayoutAttribute predecessorAttributes[] = { NSLayoutAttributeBottom, NSLayoutAttributeBaseline, NSLayoutAttributeBaseline, NSLayoutAttributeBottom };
+	// spec calls for 20pt space below the image and the title, but when set to 20pt, there's 25pts of space.
+	CGFloat spacingsBelow[] = { 15, 15, 20, 0 };
+	
+	// The container's bottom links with the bottom of the last view showing to provide the size of the container:
+	BOOL isContainerBottom = (index == _stackedViews.count);
+	id item = (isContainerBottom ? _containerView : _stackedViews[index]);
+	NSLayoutAttribute attribute = (isContainerBottom ? NSLayoutAttributeBottom : NSLayoutAttributeTop);
+	
+	if (position == 0)
+		constraint = [NSLayoutConstraint constraintWithItem:item attribute:attribute relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeTop multiplier:1.0 constant:0];
+	else {
+		NSUInteger predecessor = position - 1;
+		NSLayoutAttribute predecessorAttribute = (isContainerBottom ? NSLayoutAttributeBottom : predecessorAttributes[predecessor]);
+		CGFloat constant = (isContainerBottom ? 0 : spacingsBelow[predecessor]);
+		constraint = [NSLayoutConstraint constraintWithItem:item attribute:attribute relatedBy:NSLayoutRelationEqual toItem:_stackedViews[predecessor] attribute:predecessorAttribute multiplier:1.0 constant:constant];
+	}
+	
+	_stackingConstraints[key] = constraint;
+	return constraint;
+}
+
+
 - (void)updateConstraints
 {
-	if (_constraints) {
+	if (!_stackedViews) {
 		[super updateConstraints];
 		return;
 	}
 	
 	NSMutableArray *constraints = [NSMutableArray array];
 	
-	NSDictionary *views = NSDictionaryOfVariableBindings(_imageView, _titleLabel, _messageLabel, _actionButton);
-	UIView *last = _containerView;
-	NSLayoutAttribute lastAttr = NSLayoutAttributeTop;
-	CGFloat constant = 0;
+	// Position 0 is the container's top; position n is the nth stacked view.
+	NSUInteger lastPosition = 0;
 	
-	if (_imageView.superview) {
-		// Force the container to be at least as wide as the image
-		[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|-(>=0)-[_imageView]-(>=0)-|" options:0 metrics:nil views:views]];
-		// horizontally center the image
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_imageView attribute:NSLayoutAttributeCenterX relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeCenterX multiplier:1.0 constant:0]];
-		// aligned with the top of the container
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_imageView attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeTop multiplier:1.0 constant:0]];
+	for (NSUInteger index = 0; index < _stackedViews.count; index++) {
+		UIView *view = _stackedViews[index];
 		
-		last = _imageView;
-		lastAttr = NSLayoutAttributeBottom;
-		constant = 15; // spec calls for 20pt space, but when set to 20pt, there's 25pts of space between the bottom of the image and the top of the text.
-	}
-	
-	if (_titleLabel.superview) {
-		[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_titleLabel]|" options:0 metrics:nil views:views]];
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_titleLabel attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:last attribute:lastAttr multiplier:1.0 constant:constant]];
+		// Park hidden views at the top of the container, out of the way of those showing
+		if (view.hidden) {
+			[constraints addObject:[self _stackingConstraintAtIndex:index belowPosition:0]];
+			continue;
+		}
 		
-		last = _titleLabel;
-		lastAttr = NSLayoutAttributeBaseline;
-		constant = 15; // spec calls for 20pt space, but when set to 20pt, there's 25pts of space between the baseline of the title and the message.
+		[constraints addObject:[self _stackingConstraintAtIndex:index belowPosition:lastPosition]];
+		[constraints addObjectsFromArray:_visibleOnlyConstraints[index]];
+		lastPosition = index + 1;
 	}
 	
-	if (_messageLabel.superview) {
-		[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_messageLabel]|" options:0 metrics:nil views:views]];
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_messageLabel attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:last attribute:lastAttr multiplier:1.0 constant:constant]];
-		
-		last = _messageLabel;
-		lastAttr = NSLayoutAttributeBaseline;
-		constant = 20;
-	}
+	[constraints addObject:[self _stackingConstraintAtIndex:_stackedViews.count belowPosition:lastPosition]];
 	
-	if (_actionButton.superview) {
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:last attribute:lastAttr multiplier:1.0 constant:constant]];
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeCenterX relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeCenterX multiplier:1.0 constant:0]];
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeWidth relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:BUTTON_WIDTH]];
-		[constraints addObject:[NSLayoutConstraint constraintWithItem:_actionButton attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:BUTTON_HEIGHT]];
+	// Switch over only the constraints that differ; a change of text alone changes none.
+	if (![constraints isEqualToArray:_activeStackConstraints]) {
+		NSMutableArray *deactivating = [_activeStackConstraints mutableCopy];
+		[deactivating removeObjectsInArray:constraints];
+		NSMutableArray *activating = [constraints mutableCopy];
+		[activating removeObjectsInArray:_activeStackConstraints];
 		
-		last = _actionButton;
+		[NSLayoutConstraint deactivateConstraints:deactivating];
+		[NSLayoutConstraint activateConstraints:activating];
+		_activeStackConstraints = constraints;
 	}
 	
-	// link the bottom of the last view with the bottom of the container to provide the size of the container
-	[constraints addObject:[NSLayoutConstraint constraintWithItem:last attribute:NSLayoutAttributeBottom relatedBy:NSLayoutRelationEqual toItem:_containerView attribute:NSLayoutAttributeBottom multiplier:1.0 constant:0]];
-	
-	[_containerView addConstraints:constraints];
-	_constraints = constraints;
-	
 	[super updateConstraints];
 }
 
 @end
 
+static BOOL APPSPlaceholderContentIsEqual(APPSLoadableContentPlaceholderView *placeholderView, NSString *title, NSString *message, UIImage *image)
+{
+	return ((placeholderView.title == title || [placeholderView.title isEqualToString:title]) &&
+			(placeholderView.message == message || [placeholderView.message isEqualToString:message]) &&
+			placeholderView.image == image);
+}
+
+
+/// Add a hidden placeholder view filling hostView. Its edge constraints are made here, once; after that it's only updated.
+static APPSLoadableContentPlaceholderView *APPSInstallPlaceholderView(UIView *hostView)
+{
+	APPSLoadableContentPlaceholderView *placeholderView = [[APPSLoadableContentPlaceholderView alloc] initWithFrame:CGRectZero title:nil message:nil image:nil buttonTitle:nil buttonAction:nil];
+	placeholderView.alpha = 0.0;
+	placeholderView.hidden = YES;
+	placeholderView.translatesAutoresizingMaskIntoConstraints = NO;
+	[hostView addSubview:placeholderView];
+	
+	NSMutableArray *constraints = [NSMutableArray array];
+	NSDictionary *views = NSDictionaryOfVariableBindings(placeholderView);
+	
+	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[placeholderView]|" options:0 metrics:nil views:views]];
+	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[placeholderView]|" options:0 metrics:nil views:views]];
+	
+	[hostView addConstraints:constraints];
+	[hostView sendSubviewToBack:placeholderView];
+	return placeholderView;
+}
+
+
+/// Put the content into the placeholder view and fade it in. When it's already showing, the new content cross-dissolves over the old in the same view.
+static void APPSShowPlaceholderView(APPSLoadableContentPlaceholderView *placeholderView, NSString *title, NSString *message, UIImage *image, BOOL alreadyShowing, BOOL animated)
+{
+	dispatch_block_t updateContent = ^{
+		placeholderView.title = title;
+		placeholderView.message = message;
+		placeholderView.image = image;
+		[placeholderView layoutIfNeeded];
+	};
+	
+	if (alreadyShowing && animated) {
+		[UIView transitionWithView:placeholderView duration:0.25 options:UIViewAnimationOptionTransitionCrossDissolve animations:updateContent completion:nil];
+		return;
+	}
+	
+	[UIView performWithoutAnimation:updateContent];
+	placeholderView.hidden = NO;
+	
+	if (animated) {
+		[UIView animateWithDuration:0.25 animations:^{
+			placeholderView.alpha = 1.0;
+		}];
+	}
+	else {
+		[UIView performWithoutAnimation:^{
+			placeholderView.alpha = 1.0;
+		}];
+	}
+}
+
+
+/// Fade the placeholder view out, then hide it, unless stillHidden says it was shown again in the meantime.
+static void APPSHidePlaceholderView(APPSLoadableContentPlaceholderView *placeholderView, BOOL animated, BOOL (^stillHidden)(void))
+{
+	if (animated) {
+		[UIView animateWithDuration:0.25 animations:^{
+			placeholderView.alpha = 0.0;
+		} completion:^(BOOL finished) {
+			if (stillHidden())
+				placeholderView.hidden = YES;
+		}];
+	}
+	else {
+		[UIView performWithoutAnimation:^{
+			placeholderView.alpha = 0.0;
+			placeholderView.hidden = YES;
+		}];
+	}
+}
+
+
 @interface APPSTablePlaceholderView ()
 @property (nonatomic, strong) UIActivityIndicatorView *activityIndicatorView;
+/// Made the first time a placeholder shows, then kept and updated in place. Hidden while no placeholder is showing.
 @property (nonatomic, strong) APPSLoadableContentPlaceholderView *placeholderView;
+@property (nonatomic, getter = isShowingPlaceholder) BOOL showingPlaceholder;
 @end
 
 @implementation APPSTablePlaceholderView
@@ -320,6 +431,10 @@
 		[self addConstraints:constraints];
 	}
 	
+	// Already in the state asked for?
+	if (_activityIndicatorView.hidden == !show && _activityIndicatorView.isAnimating == show)
+		return;
+	
 	_activityIndicatorView.hidden = !show;
 	
 	if (show)
@@ -333,76 +448,41 @@
 {
 	APPSLoadableContentPlaceholderView *placeholderView = _placeholderView;
 	
-	if (!placeholderView)
+	// Already hidden or fading out, so hiding again doesn't start another fade
+	if (!placeholderView || !_showingPlaceholder)
 		return;
 	
-	if (animated) {
-		
-		[UIView animateWithDuration:0.25 animations:^{
-			placeholderView.alpha = 0.0;
-		} completion:^(BOOL finished) {
-			[placeholderView removeFromSuperview];
-			// If it's still the current placeholder, get rid of it
-			if (placeholderView == _placeholderView)
-				self.placeholderView = nil;
-		}];
-	}
-	else {
-		[UIView performWithoutAnimation:^{
-			[placeholderView removeFromSuperview];
-			if (_placeholderView == placeholderView)
-				self.placeholderView = nil;
-		}];
-	}
+	self.showingPlaceholder = NO;
+	APPSHidePlaceholderView(placeholderView, animated, ^BOOL{
+		return !self.showingPlaceholder;
+	});
 }
 
 
 - (void)showPlaceholderWithTitle:(NSString *)title message:(NSString *)message image:(UIImage *)image animated:(BOOL)animated
 {
-	APPSLoadableContentPlaceholderView *oldPlaceHolder = self.placeholderView;
-	
-	if (oldPlaceHolder && [oldPlaceHolder.title isEqualToString:title] && [oldPlaceHolder.message isEqualToString:message])
+	// Showing the same placeholder again shouldn't fade it out and back in
+	if (_showingPlaceholder && APPSPlaceholderContentIsEqual(_placeholderView, title, message, image))
 		return;
 	
 	[self showActivityIndicator:NO];
 	
-	self.placeholderView = [[APPSLoadableContentPlaceholderView alloc] initWithFrame:CGRectZero title:title message:message image:image buttonTitle:nil buttonAction:nil];
-	_placeholderView.alpha = 0.0;
-	_placeholderView.translatesAutoresizingMaskIntoConstraints = NO;
-	[self addSubview:_placeholderView];
-	
-	NSMutableArray *constraints = [NSMutableArray array];
-	NSDictionary *views = NSDictionaryOfVariableBindings(_placeholderView);
-	
-	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_placeholderView]|" options:0 metrics:nil views:views]];
-	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_placeholderView]|" options:0 metrics:nil views:views]];
-	
-	[self addConstraints:constraints];
-	[self sendSubviewToBack:_placeholderView];
-    [self layoutIfNeeded];
-	
-	if (animated) {
-		[UIView animateWithDuration:0.25 animations:^{
-			_placeholderView.alpha = 1.0;
-			oldPlaceHolder.alpha = 0.0;
-		} completion:^(BOOL finished) {
-			[oldPlaceHolder removeFromSuperview];
-		}];
-	}
-	else {
-		[UIView performWithoutAnimation:^{
-			_placeholderView.alpha = 1.0;
-			oldPlaceHolder.alpha = 0.0;
-			[oldPlaceHolder removeFromSuperview];
-		}];
+	if (!_placeholderView) {
+		self.placeholderView = APPSInstallPlaceholderView(self);
+		[self layoutIfNeeded];
 	}
+	
+	APPSShowPlaceholderView(_placeholderView, title, message, image, _showingPlaceholder, animated);
+	self.showingPlaceholder = YES;
 }
 
 @end
 
 
 @interface APPSPlaceholderCell ()
+/// Made the first time a placeholder shows, then kept and updated in place. Hidden while no placeholder is showing.
 @property (nonatomic, strong) APPSLoadableContentPlaceholderView *placeholderView;
+@property (nonatomic, getter = isShowingPlaceholder) BOOL showingPlaceholder;
 @end
 
 @implementation APPSPlaceholderCell
@@ -412,67 +492,26 @@
 {
 	APPSLoadableContentPlaceholderView *placeholderView = _placeholderView;
 	
-	if (!placeholderView)
+	if (!placeholderView || !_showingPlaceholder)
 		return;
 	
-	if (animated) {
-		[UIView animateWithDuration:0.25 animations:^{
-			placeholderView.alpha = 0.0;
-		} completion:^(BOOL finished) {
-			[placeholderView removeFromSuperview];
-			// If it's still the current placeholder, get rid of it
-			if (placeholderView == _placeholderView)
-				self.placeholderView = nil;
-		}];
-	}
-	else {
-		[UIView performWithoutAnimation:^{
-			[placeholderView removeFromSuperview];
-			if (_placeholderView == placeholderView)
-				self.placeholderView = nil;
-		}];
-	}
+	self.showingPlaceholder = NO;
+	APPSHidePlaceholderView(placeholderView, animated, ^BOOL{
+		return !self.showingPlaceholder;
+	});
 }
 
 
 - (void)showPlaceholderWithTitle:(NSString *)title message:(NSString *)message image:(UIImage *)image animated:(BOOL)animated
 {
-	UIView *contentView = self.contentView;
-	
-	APPSLoadableContentPlaceholderView *oldPlaceHolder = self.placeholderView;
-	
-	if (oldPlaceHolder && [oldPlaceHolder.title isEqualToString:title] && [oldPlaceHolder.message isEqualToString:message])
+	if (_showingPlaceholder && APPSPlaceholderContentIsEqual(_placeholderView, title, message, image))
 		return;
 	
-	self.placeholderView = [[APPSLoadableContentPlaceholderView alloc] initWithFrame:CGRectZero title:title message:message image:image buttonTitle:nil buttonAction:nil];
-	_placeholderView.alpha = 0.0;
-	_placeholderView.translatesAutoresizingMaskIntoConstraints = NO;
-	[contentView addSubview:_placeholderView];
-	
-	NSMutableArray *constraints = [NSMutableArray array];
-	NSDictionary *views = NSDictionaryOfVariableBindings(_placeholderView);
-	
-	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_placeholderView]|" options:0 metrics:nil views:views]];
-	[constraints addObjectsFromArray:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_placeholderView]|" options:0 metrics:nil views:views]];
+	if (!_placeholderView)
+		self.placeholderView = APPSInstallPlaceholderView(self.contentView);
 	
-	[contentView addConstraints:constraints];
-	[contentView sendSubviewToBack:_placeholderView];
-	
-	if (animated) {
-		[UIView animateWithDuration:0.25 animations:^{
-			_placeholderView.alpha = 1.0;
-			oldPlaceHolder.alpha = 0.0;
-		} completion:^(BOOL finished) {
-			[oldPlaceHolder removeFromSuperview];
-		}];
-	}
-	else {
-		[UIView performWithoutAnimation:^{
-			_placeholderView.alpha = 1.0;
-			oldPlaceHolder.alpha = 0.0;
-			[oldPlaceHolder removeFromSuperview];
-		}];
-	}
+	APPSShowPlaceholderView(_placeholderView, title, message, image, _showingPlaceholder, animated);
+	self.showingPlaceholder = YES;
 }
 
 @end
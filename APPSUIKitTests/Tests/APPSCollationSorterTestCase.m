@@ -0,0 +1,118 @@
+//
+//  APPSCollationSorterTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+
+/// An item sorted by name. Equality is identity, so items with equal names stay distinguishable and can be held weakly by the sorter's cache.
+@interface APPSCollationTestItem : NSObject
+@property (nonatomic, copy) NSString *name;
+@end
+
+@implementation APPSCollationTestItem
+
++ (instancetype)itemWithName:(NSString *)name;
+{
+    APPSCollationTestItem *item = [[self alloc] init];
+    item.name = name;
+    return item;
+}
+
+
+- (NSString *)description;
+{
+    return [NSString stringWithFormat:@"<%p %@>", self, self.name];
+}
+
+@end
+
+
+
+@interface APPSCollationSorterTestCase : XCTestCase
+@end
+
+
+@implementation APPSCollationSorterTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: -sortedArrayFromArray:
+
+- (void)test_sortedArrayFromArray__parallelMergeMatchesComparatorSort;
+{
+    APPSCollationSorter *sorter = [[APPSCollationSorter alloc] initWithKeyPath:@"name" locale:[NSLocale localeWithLocaleIdentifier:@"en_US"]];
+
+    // Enough items for several runs on any multi-core device, from few distinct names so many keys tie and stability shows.
+    NSArray<NSString *> *syllables = @[@"a", @"É", @"ch", @"O", @"ö", @"z", @"B", @"ll", @"1", @" "];
+    NSMutableArray *items = [NSMutableArray array];
+    srand48(33);
+    for (NSUInteger index = 0; index < 40000; ++index) {
+        NSMutableString *name = [NSMutableString string];
+        for (NSUInteger length = 1 + lrand48() % 3; length > 0; --length)
+            [name appendString:syllables[lrand48() % syllables.count]];
+        [items addObject:[APPSCollationTestItem itemWithName:name]];
+    }
+
+    NSArray *sortedItems = [sorter sortedArrayFromArray:items];
+    NSArray *expectedItems = [items sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(id item1, id item2) {
+        NSData *key1 = [sorter collationKeyForItem:item1];
+        NSData *key2 = [sorter collationKeyForItem:item2];
+        int result = memcmp(key1.bytes, key2.bytes, MIN(key1.length, key2.length));
+        if (!result && key1.length != key2.length)
+            result = key1.length < key2.length ? -1 : 1;
+        return result < 0 ? NSOrderedAscending : (result > 0 ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    XCTAssertEqualObjects(sortedItems, expectedItems);
+
+    // A second sort reads every key from the cache and gives the same order.
+    XCTAssertEqualObjects([sorter sortedArrayFromArray:items], expectedItems);
+}
+
+
+- (void)test_sortedArrayFromArray__ignoresCaseDiacriticsAndWidth;
+{
+    APPSCollationSorter *sorter = [[APPSCollationSorter alloc] initWithKeyPath:@"name" locale:[NSLocale localeWithLocaleIdentifier:@"en_US"]];
+    APPSCollationTestItem *emile = [APPSCollationTestItem itemWithName:@"Émile"];
+    APPSCollationTestItem *lowercaseEmile = [APPSCollationTestItem itemWithName:@"emile"];
+    APPSCollationTestItem *wideEmile = [APPSCollationTestItem itemWithName:@"ｅｍｉｌｅ"];
+    APPSCollationTestItem *david = [APPSCollationTestItem itemWithName:@"david"];
+    APPSCollationTestItem *zoe = [APPSCollationTestItem itemWithName:@"Zoë"];
+
+    XCTAssertEqualObjects([sorter collationKeyForItem:emile], [sorter collationKeyForItem:lowercaseEmile]);
+    XCTAssertEqualObjects([sorter collationKeyForItem:emile], [sorter collationKeyForItem:wideEmile]);
+    XCTAssertEqualObjects([sorter sortedArrayFromArray:@[zoe, emile, david, lowercaseEmile]], (@[david, emile, lowercaseEmile, zoe]));
+}
+
+
+
+#pragma mark * Method: -collatedSectionsFromArray:
+
+- (void)test_collatedSectionsFromArray__sectionsFromIndexedCollation;
+{
+    APPSCollationSorter *sorter = [[APPSCollationSorter alloc] initWithKeyPath:@"name" locale:nil];
+    NSArray *items = @[[APPSCollationTestItem itemWithName:@"Émile"], [APPSCollationTestItem itemWithName:@"david"], [APPSCollationTestItem itemWithName:@"eve"], [APPSCollationTestItem itemWithName:@"42"]];
+    UILocalizedIndexedCollation *collation = [UILocalizedIndexedCollation currentCollation];
+
+    APPSCollatedSections *sections = [sorter collatedSectionsFromArray:items];
+
+    XCTAssertEqual(sections.sectionTitles.count, sections.partitionedItems.count);
+    NSUInteger lastSection = 0;
+    for (NSUInteger index = 0; index < sections.sectionTitles.count; ++index) {
+        NSUInteger section = [collation.sectionTitles indexOfObject:sections.sectionTitles[index]];
+        XCTAssertNotEqual(section, (NSUInteger)NSNotFound);
+        XCTAssertTrue(index == 0 || section > lastSection, @"Sections are out of the collation's order.");
+        lastSection = section;
+
+        for (APPSCollationTestItem *item in sections.partitionedItems[index])
+            XCTAssertEqual([collation sectionForObject:item collationStringSelector:@selector(name)], (NSInteger)section);
+        XCTAssertEqualObjects(sections.partitionedItems[index], [sorter sortedArrayFromArray:sections.partitionedItems[index]]);
+    }
+}
+
+@end
@@ -0,0 +1,225 @@
+//
+//  APPSDataSourceDiffTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+#import "APPSDataSourceDiff.h"
+#import "APPSIdentifiable.h"
+
+
+@interface APPSDataSourceDiffTestItem : NSObject <APPSIdentifiable>
+@property (nonatomic, copy) NSString *itemIdentifier;
+@property (nonatomic, copy) NSString *title;
+@end
+
+@implementation APPSDataSourceDiffTestItem
+
++ (instancetype)itemWithIdentifier:(NSString *)identifier title:(NSString *)title;
+{
+    APPSDataSourceDiffTestItem *item = [[self alloc] init];
+    item.itemIdentifier = identifier;
+    item.title = title;
+    return item;
+}
+
+- (NSUInteger)contentHash;
+{
+    return self.title.hash;
+}
+
+@end
+
+
+@interface APPSDataSourceDiffTestCase : XCTestCase
+@end
+
+
+@implementation APPSDataSourceDiffTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: +diffFromItems:toItems:
+
+- (void)test_diffFromItems__identicalItems;
+{
+    NSArray *items = @[@"a", @"b", @"c"];
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:items toItems:[items copy]];
+
+    XCTAssertNotNil(diff);
+    XCTAssertFalse(diff.hasChanges, @"Identical arrays should produce an empty diff.");
+}
+
+
+- (void)test_diffFromItems__removalsAndInsertions;
+{
+    // "All" vs "Unread": the shared items must not be reported as removed or inserted.
+    NSArray *allItems = @[@"a", @"b", @"c", @"d", @"e"];
+    NSArray *unreadItems = @[@"b", @"d", @"f"];
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:allItems toItems:unreadItems];
+
+    NSMutableIndexSet *expectedRemovals = [NSMutableIndexSet indexSetWithIndex:0];
+    [expectedRemovals addIndex:2];
+    [expectedRemovals addIndex:4];
+
+    XCTAssertEqualObjects(diff.removedIndexes, expectedRemovals);
+    XCTAssertEqualObjects(diff.insertedIndexes, [NSIndexSet indexSetWithIndex:2]);
+
+    NSMutableArray *moves = [NSMutableArray array];
+    [diff enumerateMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+        [moves addObject:@[@(fromIndex), @(toIndex)]];
+    }];
+
+    NSArray *expectedMoves = @[@[@1, @0], @[@3, @1]];
+    XCTAssertEqualObjects(moves, expectedMoves);
+    XCTAssertEqual(diff.numberOfMoves, (NSUInteger)2);
+}
+
+
+- (void)test_diffFromItems__duplicateItems;
+{
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:@[@"a", @"a"] toItems:@[@"a"]];
+
+    XCTAssertNil(diff, @"Arrays containing duplicates can't be diffed by identity.");
+}
+
+
+- (void)test_diffFromItems__identifiableItemsWithChangedContent;
+{
+    NSArray *oldItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"One"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Two"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"3" title:@"Three"]];
+    NSArray *newItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"One"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Deux"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"3" title:@"Three"]];
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:oldItems toItems:newItems];
+
+    XCTAssertEqualObjects(diff.refreshedIndexes, [NSIndexSet indexSetWithIndex:1], @"Only the item whose content changed should be refreshed.");
+    XCTAssertEqual(diff.removedIndexes.count, (NSUInteger)0);
+    XCTAssertEqual(diff.insertedIndexes.count, (NSUInteger)0);
+    XCTAssertEqual(diff.numberOfMoves, (NSUInteger)0);
+}
+
+
+- (void)test_diffFromItems__changedItemShiftedByInsertion;
+{
+    NSArray *oldItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"One"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Two"]];
+    NSArray *newItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"0" title:@"Zero"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"One"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Deux"]];
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:oldItems toItems:newItems];
+
+    XCTAssertEqualObjects(diff.refreshedIndexes, [NSIndexSet indexSetWithIndex:1], @"A changed item pushed down by an insertion keeps its place, so it's refreshed at its old index.");
+    XCTAssertEqualObjects(diff.insertedIndexes, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual(diff.removedIndexes.count, (NSUInteger)0);
+}
+
+
+- (void)test_diffFromItems__changedItemMovedPastNeighbours;
+{
+    NSArray *oldItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"One"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Two"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"3" title:@"Three"]];
+    NSArray *newItems = @[[APPSDataSourceDiffTestItem itemWithIdentifier:@"2" title:@"Two"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"3" title:@"Three"],
+                          [APPSDataSourceDiffTestItem itemWithIdentifier:@"1" title:@"Uno"]];
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:oldItems toItems:newItems];
+
+    XCTAssertEqual(diff.refreshedIndexes.count, (NSUInteger)0, @"A table view can't reload and move the same row.");
+    XCTAssertEqualObjects(diff.removedIndexes, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqualObjects(diff.insertedIndexes, [NSIndexSet indexSetWithIndex:2]);
+}
+
+
+#pragma mark * Method: -enumerateReorderingMovesUsingBlock:
+
+- (void)test_enumerateReorderingMoves__sharedItemsShiftedInOrder;
+{
+    // "All" vs "Unread": b and d only shift up, so nothing has to move.
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:@[@"a", @"b", @"c", @"d", @"e"] toItems:@[@"b", @"d", @"f"]];
+
+    XCTAssertEqualObjects([self reorderingMovesOfDiff:diff], @[]);
+}
+
+
+- (void)test_enumerateReorderingMoves__onlyItemsOutOfOrderMove;
+{
+    APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:@[@"a", @"b", @"c", @"d"] toItems:@[@"b", @"c", @"d", @"a"]];
+
+    XCTAssertEqual(diff.numberOfMoves, (NSUInteger)4);
+    XCTAssertEqualObjects([self reorderingMovesOfDiff:diff], (@[@[@0, @3]]));
+}
+
+
+- (void)test_enumerateReorderingMoves__randomDiffsReplayOntoNewItems;
+{
+    srand48(26);
+    for (NSUInteger step = 0; step < 300; ++step) {
+        NSMutableArray *oldItems = [NSMutableArray array];
+        NSMutableArray *newItems = [NSMutableArray array];
+        for (NSUInteger value = 0; value < 20; ++value) {
+            if (lrand48() % 3)
+                [oldItems addObject:@(value)];
+            if (lrand48() % 3)
+                [newItems addObject:@(value)];
+        }
+        for (NSUInteger index = newItems.count; index > 1; --index)
+            [newItems exchangeObjectAtIndex:index - 1 withObjectAtIndex:lrand48() % index];
+
+        APPSDataSourceDiff *diff = [APPSDataSourceDiff diffFromItems:oldItems toItems:newItems];
+        XCTAssertEqualObjects([self replayReorderingDiff:diff onItems:oldItems newItems:newItems], newItems, @"Step %lu's moves don't turn the old items into the new ones.", (unsigned long)step);
+    }
+}
+
+
+
+#pragma mark - Helper
+
+- (NSArray<NSArray<NSNumber *> *> *)reorderingMovesOfDiff:(APPSDataSourceDiff *)diff;
+{
+    NSMutableArray *moves = [NSMutableArray array];
+    [diff enumerateReorderingMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+        [moves addObject:@[@(fromIndex), @(toIndex)]];
+    }];
+    return moves;
+}
+
+
+/// Apply the removals, insertions and reordering moves as a table view would: the items that neither leave nor move keep their order and fill the remaining rows.
+- (NSArray *)replayReorderingDiff:(APPSDataSourceDiff *)diff onItems:(NSArray *)oldItems newItems:(NSArray *)newItems;
+{
+    NSMutableIndexSet *leavingIndexes = [diff.removedIndexes mutableCopy];
+    NSMutableIndexSet *arrivingIndexes = [diff.insertedIndexes mutableCopy];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSUInteger index = 0; index < newItems.count; ++index)
+        [items addObject:[NSNull null]];
+
+    [diff.insertedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        items[index] = newItems[index];
+    }];
+    [diff enumerateReorderingMovesUsingBlock:^(NSUInteger fromIndex, NSUInteger toIndex) {
+        [leavingIndexes addIndex:fromIndex];
+        [arrivingIndexes addIndex:toIndex];
+        items[toIndex] = oldItems[fromIndex];
+    }];
+
+    NSUInteger index = 0;
+    for (NSUInteger oldIndex = 0; oldIndex < oldItems.count; ++oldIndex) {
+        if ([leavingIndexes containsIndex:oldIndex])
+            continue;
+        while ([arrivingIndexes containsIndex:index])
+            index++;
+        if (index >= items.count)
+            return nil;
+        items[index++] = oldItems[oldIndex];
+    }
+
+    return items;
+}
+
+@end
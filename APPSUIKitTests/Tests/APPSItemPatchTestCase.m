@@ -0,0 +1,338 @@
+//
+//  APPSItemPatchTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+#import "APPSIdentifiable.h"
+#import "APPSIdentityIndex.h"
+
+
+@interface APPSItemPatchTestItem : NSObject <APPSIdentifiable>
+@property (nonatomic, copy) NSNumber *itemIdentifier;
+@property (nonatomic) NSInteger value;
+@end
+
+@implementation APPSItemPatchTestItem
+
++ (instancetype)itemWithIdentifier:(NSNumber *)identifier value:(NSInteger)value;
+{
+    APPSItemPatchTestItem *item = [[self alloc] init];
+    item.itemIdentifier = identifier;
+    item.value = value;
+    return item;
+}
+
+
+- (NSUInteger)contentHash;
+{
+    return (NSUInteger)self.value;
+}
+
+@end
+
+
+
+/// Records the item changes of each batch the way a table view receives them.
+@interface APPSItemPatchRecorder : NSObject <APPSDataSourceDelegate>
+@property (nonatomic, strong) NSMutableIndexSet *removedRows;
+@property (nonatomic, strong) NSMutableIndexSet *insertedRows;
+@property (nonatomic, strong) NSMutableIndexSet *refreshedRows;
+/// Pairs of @[fromRow, toRow].
+@property (nonatomic, strong) NSMutableArray<NSArray<NSNumber *> *> *moves;
+@property (nonatomic) NSUInteger numberOfReloads;
+@end
+
+@implementation APPSItemPatchRecorder
+
+- (instancetype)init;
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    [self reset];
+    return self;
+}
+
+
+- (void)reset;
+{
+    _removedRows = [NSMutableIndexSet indexSet];
+    _insertedRows = [NSMutableIndexSet indexSet];
+    _refreshedRows = [NSMutableIndexSet indexSet];
+    _moves = [NSMutableArray array];
+    _numberOfReloads = 0;
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.insertedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.removedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.refreshedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath;
+{
+    [self.moves addObject:@[@(fromIndexPath.row), @(newIndexPath.row)]];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshSections:(NSIndexSet *)sections;
+{
+    self.numberOfReloads++;
+}
+
+
+- (void)dataSourceDidReloadData:(APPSDataSource *)dataSource;
+{
+    self.numberOfReloads++;
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource performBatchUpdate:(dispatch_block_t)update complete:(dispatch_block_t)complete;
+{
+    if (update)
+        update();
+    if (complete)
+        complete();
+}
+
+@end
+
+
+
+@interface APPSItemPatchTestCase : XCTestCase
+@end
+
+
+@implementation APPSItemPatchTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: -applyPatch:error:
+
+- (void)test_applyPatch__randomPatchesMatchReference;
+{
+    APPSBasicDataSource *dataSource = [[APPSBasicDataSource alloc] init];
+    NSMutableArray *reference = [NSMutableArray array];
+    __block NSUInteger lastIdentifier = 0;
+
+    for (NSUInteger index = 0; index < 40; ++index)
+        [reference addObject:[APPSItemPatchTestItem itemWithIdentifier:@(++lastIdentifier) value:index]];
+    [dataSource performUpdate:^{
+        dataSource.items = reference;
+    }];
+
+    APPSItemPatchRecorder *recorder = [[APPSItemPatchRecorder alloc] init];
+    dataSource.delegate = recorder;
+
+    srand48(40);
+    for (NSUInteger step = 0; step < 300; ++step) {
+        NSArray *oldItems = [reference copy];
+        APPSItemPatch *patch = [[APPSItemPatch alloc] initWithBaseGeneration:dataSource.itemsGeneration];
+        NSMutableArray<NSNumber *> *deletedIdentifiers = [NSMutableArray array];
+
+        // Record each operation in the patch and carry it out on the reference, so later operations see the result of earlier ones.
+        for (NSUInteger count = 1 + lrand48() % 8; count > 0; --count) {
+            NSUInteger numberOfItems = reference.count;
+            switch (lrand48() % 5) {
+                case 0: {
+                    // Sometimes bring back an identifier this patch deleted.
+                    NSNumber *identifier = (deletedIdentifiers.count && lrand48() % 2) ? deletedIdentifiers.lastObject : @(++lastIdentifier);
+                    [deletedIdentifiers removeObject:identifier];
+                    APPSItemPatchTestItem *item = [APPSItemPatchTestItem itemWithIdentifier:identifier value:lrand48() % 100];
+                    NSUInteger index = lrand48() % (numberOfItems + 1);
+                    [patch insertItem:item atIndex:index];
+                    [reference insertObject:item atIndex:index];
+                    break;
+                }
+                case 1: {
+                    if (!numberOfItems)
+                        break;
+                    APPSItemPatchTestItem *item = reference[lrand48() % numberOfItems];
+                    [patch deleteItemWithIdentifier:item.itemIdentifier];
+                    [deletedIdentifiers addObject:item.itemIdentifier];
+                    [reference removeObject:item];
+                    break;
+                }
+                case 2:
+                case 3: {
+                    if (!numberOfItems)
+                        break;
+                    APPSItemPatchTestItem *item = reference[lrand48() % numberOfItems];
+                    NSUInteger index = lrand48() % numberOfItems;
+                    [patch moveItemWithIdentifier:item.itemIdentifier toIndex:index];
+                    [reference removeObject:item];
+                    [reference insertObject:item atIndex:index];
+                    break;
+                }
+                default: {
+                    if (!numberOfItems)
+                        break;
+                    NSUInteger index = lrand48() % numberOfItems;
+                    APPSItemPatchTestItem *item = [APPSItemPatchTestItem itemWithIdentifier:[reference[index] itemIdentifier] value:lrand48() % 100];
+                    [patch updateItem:item];
+                    reference[index] = item;
+                    break;
+                }
+            }
+        }
+
+        [recorder reset];
+        __block BOOL applied = NO;
+        __block NSError *error = nil;
+        [dataSource performUpdate:^{
+            applied = [dataSource applyPatch:patch error:&error];
+        }];
+
+        XCTAssertTrue(applied, @"Step %lu's patch was refused: %@", (unsigned long)step, error);
+        XCTAssertEqualObjects(dataSource.items, reference, @"Step %lu's patch left different items.", (unsigned long)step);
+        XCTAssertEqual(recorder.numberOfReloads, (NSUInteger)0);
+        XCTAssertEqualObjects([self replayRecorder:recorder onItems:oldItems expectedItems:reference], reference, @"Step %lu's batch doesn't turn the old rows into the new ones.", (unsigned long)step);
+    }
+}
+
+
+- (void)test_applyPatch__invalidOperationLeavesItems;
+{
+    APPSBasicDataSource *dataSource = [[APPSBasicDataSource alloc] init];
+    NSArray *items = @[[APPSItemPatchTestItem itemWithIdentifier:@1 value:1], [APPSItemPatchTestItem itemWithIdentifier:@2 value:2]];
+    [dataSource performUpdate:^{
+        dataSource.items = items;
+    }];
+
+    APPSItemPatch *patch = [[APPSItemPatch alloc] initWithBaseGeneration:dataSource.itemsGeneration];
+    [patch deleteItemWithIdentifier:@1];
+    [patch moveItemWithIdentifier:@1 toIndex:0];
+
+    __block BOOL applied = YES;
+    __block NSError *error = nil;
+    [dataSource performUpdate:^{
+        applied = [dataSource applyPatch:patch error:&error];
+    }];
+
+    XCTAssertFalse(applied);
+    XCTAssertEqualObjects(error.domain, APPSItemPatchErrorDomain);
+    XCTAssertEqual(error.code, APPSItemPatchErrorInvalidOperation);
+    XCTAssertEqualObjects(dataSource.items, items);
+
+    // The index the failed patch touched is rebuilt, so a good patch still applies.
+    APPSItemPatch *goodPatch = [[APPSItemPatch alloc] initWithBaseGeneration:dataSource.itemsGeneration];
+    [goodPatch moveItemWithIdentifier:@1 toIndex:1];
+    [dataSource performUpdate:^{
+        applied = [dataSource applyPatch:goodPatch error:&error];
+    }];
+
+    XCTAssertTrue(applied);
+    XCTAssertEqualObjects(dataSource.items, (@[items[1], items[0]]));
+}
+
+
+
+#pragma mark * Class: APPSIdentityIndex
+
+- (void)test_identityIndex__randomEditsMatchArray;
+{
+    NSMutableArray<NSNumber *> *expected = [NSMutableArray array];
+    for (NSUInteger identifier = 0; identifier < 100; ++identifier)
+        [expected addObject:@(identifier)];
+    APPSIdentityIndex *identityIndex = [[APPSIdentityIndex alloc] initWithIdentifiers:expected];
+
+    srand48(41);
+    NSUInteger lastIdentifier = expected.count;
+    for (NSUInteger step = 0; step < 2000; ++step) {
+        NSUInteger count = expected.count;
+        if (!count || lrand48() % 2) {
+            NSNumber *identifier = @(lastIdentifier++);
+            NSUInteger index = lrand48() % (count + 1);
+            [expected insertObject:identifier atIndex:index];
+            [identityIndex insertIdentifier:identifier atIndex:index];
+        }
+        else {
+            NSUInteger index = lrand48() % count;
+            XCTAssertEqual([identityIndex removeIdentifier:expected[index]], index);
+            [expected removeObjectAtIndex:index];
+        }
+
+        XCTAssertEqual(identityIndex.count, expected.count);
+    }
+
+    [expected enumerateObjectsUsingBlock:^(NSNumber *identifier, NSUInteger index, BOOL *stop) {
+        XCTAssertEqual([identityIndex indexOfIdentifier:identifier], index);
+    }];
+    XCTAssertEqual([identityIndex indexOfIdentifier:@(lastIdentifier)], (NSUInteger)NSNotFound);
+    XCTAssertNil([[APPSIdentityIndex alloc] initWithIdentifiers:@[@1, @2, @1]]);
+}
+
+
+
+#pragma mark - Helper
+
+/// Apply the recorded batch to the old rows as a table view would: removals and move sources leave, insertions and move destinations land at their new rows, and the rest keep their order. Inserted and refreshed rows take the item the data source now has there, so an update the batch misses leaves the old item behind.
+- (NSArray *)replayRecorder:(APPSItemPatchRecorder *)recorder onItems:(NSArray *)oldItems expectedItems:(NSArray *)expectedItems;
+{
+    NSMutableIndexSet *leavingRows = [recorder.removedRows mutableCopy];
+    NSMutableIndexSet *arrivingRows = [recorder.insertedRows mutableCopy];
+    for (NSArray<NSNumber *> *move in recorder.moves) {
+        [leavingRows addIndex:move[0].unsignedIntegerValue];
+        [arrivingRows addIndex:move[1].unsignedIntegerValue];
+    }
+
+    // A table view can't refresh a row it's also removing or moving.
+    [recorder.refreshedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        XCTAssertFalse([leavingRows containsIndex:row]);
+    }];
+
+    NSUInteger count = oldItems.count - leavingRows.count + arrivingRows.count;
+    if (count != expectedItems.count || (arrivingRows.count && arrivingRows.lastIndex >= count))
+        return nil;
+
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger row = 0; row < count; ++row)
+        [items addObject:[NSNull null]];
+
+    [recorder.insertedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        items[row] = expectedItems[row];
+    }];
+    for (NSArray<NSNumber *> *move in recorder.moves)
+        items[move[1].unsignedIntegerValue] = oldItems[move[0].unsignedIntegerValue];
+
+    NSUInteger row = 0;
+    for (NSUInteger oldRow = 0; oldRow < oldItems.count; ++oldRow) {
+        if ([leavingRows containsIndex:oldRow])
+            continue;
+        while ([arrivingRows containsIndex:row])
+            row++;
+        if ([recorder.refreshedRows containsIndex:oldRow]) {
+            XCTAssertEqualObjects([expectedItems[row] itemIdentifier], [oldItems[oldRow] itemIdentifier], @"Row %lu was refreshed with another item.", (unsigned long)oldRow);
+            items[row] = expectedItems[row];
+        }
+        else
+            items[row] = oldItems[oldRow];
+        row++;
+    }
+
+    return items;
+}
+
+@end
@@ -0,0 +1,108 @@
+//
+//  APPSItemVectorTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+#import "APPSItemVector.h"
+
+
+@interface APPSItemVectorTestCase : XCTestCase
+@end
+
+
+@implementation APPSItemVectorTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: -vectorByInsertingObjects:atIndex:
+
+- (void)test_vectorByInsertingObjects__leavesOriginalUnchanged;
+{
+    NSArray *numbers = [self numbersFrom:0 count:100];
+    APPSItemVector *vector = [APPSItemVector vectorWithArray:numbers];
+
+    APPSItemVector *edited = [vector vectorByInsertingObjects:@[@-1, @-2] atIndex:50];
+
+    XCTAssertEqualObjects(vector, numbers);
+    XCTAssertEqual(edited.count, (NSUInteger)102);
+    XCTAssertEqualObjects(edited[50], @-1);
+    XCTAssertEqualObjects(edited[52], @50);
+}
+
+
+
+#pragma mark * Editing
+
+- (void)test_editing__matchesMutableArray;
+{
+    NSMutableArray *expected = [[self numbersFrom:0 count:500] mutableCopy];
+    APPSItemVector *vector = [APPSItemVector vectorWithArray:expected];
+
+    srand48(35);
+    for (NSUInteger step = 0; step < 2000; ++step) {
+        NSUInteger count = expected.count;
+        switch (lrand48() % 4) {
+            case 0: {
+                NSUInteger index = lrand48() % (count + 1);
+                NSArray *numbers = [self numbersFrom:1000 + step count:1 + lrand48() % 40];
+                [expected insertObjects:numbers atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(index, numbers.count)]];
+                vector = [vector vectorByInsertingObjects:numbers atIndex:index];
+                break;
+            }
+            case 1: {
+                if (!count)
+                    break;
+                NSUInteger location = lrand48() % count;
+                NSRange range = NSMakeRange(location, MIN(count - location, (NSUInteger)(1 + lrand48() % 40)));
+                [expected removeObjectsInRange:range];
+                vector = [vector vectorByRemovingObjectsInRange:range];
+                break;
+            }
+            case 2: {
+                if (!count)
+                    break;
+                NSUInteger index = lrand48() % count;
+                expected[index] = @(-(NSInteger)step);
+                vector = [vector vectorByReplacingObjectAtIndex:index withObject:@(-(NSInteger)step)];
+                break;
+            }
+            default: {
+                if (!count)
+                    break;
+                NSUInteger fromIndex = lrand48() % count;
+                NSUInteger toIndex = lrand48() % count;
+                id object = expected[fromIndex];
+                [expected removeObjectAtIndex:fromIndex];
+                [expected insertObject:object atIndex:toIndex];
+                vector = [vector vectorByMovingObjectAtIndex:fromIndex toIndex:toIndex];
+                break;
+            }
+        }
+    }
+
+    XCTAssertEqualObjects(vector, expected);
+
+    NSMutableArray *enumerated = [NSMutableArray array];
+    for (id object in vector)
+        [enumerated addObject:object];
+    XCTAssertEqualObjects(enumerated, expected);
+}
+
+
+
+#pragma mark - Helper
+
+- (NSArray *)numbersFrom:(NSInteger)first count:(NSUInteger)count;
+{
+    NSMutableArray *numbers = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; ++index)
+        [numbers addObject:@(first + (NSInteger)index)];
+    return numbers;
+}
+
+@end
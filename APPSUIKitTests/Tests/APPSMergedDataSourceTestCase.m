@@ -0,0 +1,317 @@
+//
+//  APPSMergedDataSourceTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+#import "APPSIdentifiable.h"
+
+
+@interface APPSMergedDataSourceTestItem : NSObject <APPSIdentifiable>
+@property (nonatomic, copy) NSNumber *itemIdentifier;
+@property (nonatomic) NSInteger value;
+@end
+
+@implementation APPSMergedDataSourceTestItem
+
++ (instancetype)itemWithValue:(NSInteger)value;
+{
+    static NSUInteger lastIdentifier = 0;
+
+    APPSMergedDataSourceTestItem *item = [[self alloc] init];
+    item.itemIdentifier = @(++lastIdentifier);
+    item.value = value;
+    return item;
+}
+
+
+- (NSUInteger)contentHash;
+{
+    return (NSUInteger)self.value;
+}
+
+@end
+
+
+
+/// Records the item changes of each batch the way a table view receives them.
+@interface APPSMergedDataSourceRecorder : NSObject <APPSDataSourceDelegate>
+@property (nonatomic, strong) NSMutableIndexSet *removedRows;
+@property (nonatomic, strong) NSMutableIndexSet *insertedRows;
+@property (nonatomic, strong) NSMutableIndexSet *refreshedRows;
+/// Pairs of @[fromRow, toRow].
+@property (nonatomic, strong) NSMutableArray<NSArray<NSNumber *> *> *moves;
+@property (nonatomic) NSUInteger numberOfReloads;
+@end
+
+@implementation APPSMergedDataSourceRecorder
+
+- (instancetype)init;
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    [self reset];
+    return self;
+}
+
+
+- (void)reset;
+{
+    _removedRows = [NSMutableIndexSet indexSet];
+    _insertedRows = [NSMutableIndexSet indexSet];
+    _refreshedRows = [NSMutableIndexSet indexSet];
+    _moves = [NSMutableArray array];
+    _numberOfReloads = 0;
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didInsertItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.insertedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRemoveItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.removedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshItemsAtIndexPaths:(NSArray *)indexPaths;
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [self.refreshedRows addIndex:indexPath.row];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didMoveItemAtIndexPath:(NSIndexPath *)fromIndexPath toIndexPath:(NSIndexPath *)newIndexPath;
+{
+    [self.moves addObject:@[@(fromIndexPath.row), @(newIndexPath.row)]];
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource didRefreshSections:(NSIndexSet *)sections;
+{
+    self.numberOfReloads++;
+}
+
+
+- (void)dataSourceDidReloadData:(APPSDataSource *)dataSource;
+{
+    self.numberOfReloads++;
+}
+
+
+- (void)dataSource:(APPSDataSource *)dataSource performBatchUpdate:(dispatch_block_t)update complete:(dispatch_block_t)complete;
+{
+    if (update)
+        update();
+    if (complete)
+        complete();
+}
+
+@end
+
+
+
+@interface APPSMergedDataSourceTestCase : XCTestCase
+@end
+
+
+@implementation APPSMergedDataSourceTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: -dataSource:performBatchUpdate:complete:
+
+- (void)test_performBatchUpdate__reKeyedItemsAcrossChildren;
+{
+    APPSMergedDataSource *mergedDataSource = [self mergedDataSource];
+    APPSSortedDataSource *evens = [self sortedDataSource];
+    APPSSortedDataSource *odds = [self sortedDataSource];
+    [mergedDataSource addDataSource:evens];
+    [mergedDataSource addDataSource:odds];
+
+    NSArray *evenItems = [self itemsWithValues:@[@0, @2, @4, @6, @8]];
+    [evens performUpdate:^{
+        evens.items = evenItems;
+    }];
+    [odds performUpdate:^{
+        odds.items = [self itemsWithValues:@[@1, @3, @5, @7, @9]];
+    }];
+
+    APPSMergedDataSourceRecorder *recorder = [[APPSMergedDataSourceRecorder alloc] init];
+    mergedDataSource.delegate = recorder;
+    NSArray *oldItems = [self itemsInDataSource:mergedDataSource];
+
+    // Re-keying 2 past 9 and 8 to the front reorders the child, and removing 4 shifts its other rows, all in one batch.
+    [evenItems[1] setValue:10];
+    [evenItems[4] setValue:-1];
+    [evens performUpdate:^{
+        [evens setItems:@[evenItems[0], evenItems[1], evenItems[3], evenItems[4], [APPSMergedDataSourceTestItem itemWithValue:5]] animated:YES];
+    }];
+
+    NSArray *newItems = [self itemsInDataSource:mergedDataSource];
+    XCTAssertEqualObjects([self valuesOfItems:newItems], (@[@-1, @0, @1, @3, @5, @5, @6, @7, @9, @10]));
+    XCTAssertEqual(recorder.numberOfReloads, (NSUInteger)0);
+    XCTAssertEqualObjects([self replayRecorder:recorder onItems:oldItems expectedItems:newItems], newItems);
+}
+
+
+- (void)test_performBatchUpdate__randomBatchesReplayOntoMergedItems;
+{
+    APPSMergedDataSource *mergedDataSource = [self mergedDataSource];
+    NSArray<APPSSortedDataSource *> *children = @[[self sortedDataSource], [self sortedDataSource], [self sortedDataSource]];
+    for (APPSSortedDataSource *child in children)
+        [mergedDataSource addDataSource:child];
+
+    APPSMergedDataSourceRecorder *recorder = [[APPSMergedDataSourceRecorder alloc] init];
+    mergedDataSource.delegate = recorder;
+
+    srand48(36);
+    for (NSUInteger step = 0; step < 300; ++step) {
+        APPSSortedDataSource *child = children[lrand48() % children.count];
+        NSMutableArray *items = [NSMutableArray array];
+
+        for (APPSMergedDataSourceTestItem *item in child.items) {
+            switch (lrand48() % 5) {
+                case 0:
+                    // Removed.
+                    break;
+                case 1:
+                    item.value = lrand48() % 100;
+                    // Fall through: the same item, re-keyed.
+                default:
+                    [items addObject:item];
+                    break;
+            }
+        }
+
+        for (NSUInteger count = lrand48() % 6; count > 0; --count)
+            [items addObject:[APPSMergedDataSourceTestItem itemWithValue:lrand48() % 100]];
+
+        NSArray *oldItems = [self itemsInDataSource:mergedDataSource];
+        [recorder reset];
+
+        [child performUpdate:^{
+            [child setItems:items animated:YES];
+        }];
+
+        NSArray *newItems = [self itemsInDataSource:mergedDataSource];
+        NSArray *sortedValues = [[self valuesOfItems:newItems] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects([self valuesOfItems:newItems], sortedValues, @"Step %lu left the merged rows out of order.", (unsigned long)step);
+
+        if (recorder.numberOfReloads)
+            continue;
+
+        XCTAssertEqualObjects([self replayRecorder:recorder onItems:oldItems expectedItems:newItems], newItems, @"Step %lu's batch doesn't turn the old rows into the new ones.", (unsigned long)step);
+    }
+}
+
+
+
+#pragma mark - Helper
+
+- (APPSMergedDataSource *)mergedDataSource;
+{
+    return [[APPSMergedDataSource alloc] initWithComparator:[self comparator]];
+}
+
+
+- (APPSSortedDataSource *)sortedDataSource;
+{
+    return [[APPSSortedDataSource alloc] initWithComparator:[self comparator]];
+}
+
+
+- (NSComparator)comparator;
+{
+    return ^NSComparisonResult(APPSMergedDataSourceTestItem *item1, APPSMergedDataSourceTestItem *item2) {
+        return [@(item1.value) compare:@(item2.value)];
+    };
+}
+
+
+- (NSArray *)itemsWithValues:(NSArray<NSNumber *> *)values;
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:values.count];
+    for (NSNumber *value in values)
+        [items addObject:[APPSMergedDataSourceTestItem itemWithValue:value.integerValue]];
+    return items;
+}
+
+
+- (NSArray<NSNumber *> *)valuesOfItems:(NSArray<APPSMergedDataSourceTestItem *> *)items;
+{
+    return [items valueForKey:@"value"];
+}
+
+
+- (NSArray *)itemsInDataSource:(APPSDataSource *)dataSource;
+{
+    NSMutableArray *items = [NSMutableArray array];
+    NSInteger numberOfRows = dataSource.numberOfSections ? [dataSource numberOfRowsInSection:0] : 0;
+    for (NSInteger row = 0; row < numberOfRows; ++row)
+        [items addObject:[dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]]];
+    return items;
+}
+
+
+/// Apply the recorded batch to the old rows as a table view would: removals and move sources leave, insertions and move destinations land at their new rows, and the rest keep their order. Inserted rows take the item the data source now has there.
+- (NSArray *)replayRecorder:(APPSMergedDataSourceRecorder *)recorder onItems:(NSArray *)oldItems expectedItems:(NSArray *)expectedItems;
+{
+    NSMutableIndexSet *leavingRows = [recorder.removedRows mutableCopy];
+    NSMutableIndexSet *arrivingRows = [recorder.insertedRows mutableCopy];
+    for (NSArray<NSNumber *> *move in recorder.moves) {
+        [leavingRows addIndex:move[0].unsignedIntegerValue];
+        [arrivingRows addIndex:move[1].unsignedIntegerValue];
+    }
+
+    // A table view can't refresh a row it's also removing or moving.
+    XCTAssertFalse([self indexSet:recorder.refreshedRows intersectsIndexSet:leavingRows]);
+
+    NSUInteger count = oldItems.count - leavingRows.count + arrivingRows.count;
+    if (count != expectedItems.count || (arrivingRows.count && arrivingRows.lastIndex >= count))
+        return nil;
+
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger row = 0; row < count; ++row)
+        [items addObject:[NSNull null]];
+
+    [recorder.insertedRows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        items[row] = expectedItems[row];
+    }];
+    for (NSArray<NSNumber *> *move in recorder.moves)
+        items[move[1].unsignedIntegerValue] = oldItems[move[0].unsignedIntegerValue];
+
+    NSUInteger row = 0;
+    for (NSUInteger oldRow = 0; oldRow < oldItems.count; ++oldRow) {
+        if ([leavingRows containsIndex:oldRow])
+            continue;
+        while ([arrivingRows containsIndex:row])
+            row++;
+        items[row++] = oldItems[oldRow];
+    }
+
+    return items;
+}
+
+
+- (BOOL)indexSet:(NSIndexSet *)indexSet intersectsIndexSet:(NSIndexSet *)otherIndexSet;
+{
+    __block BOOL intersects = NO;
+    [indexSet enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        intersects = *stop = [otherIndexSet containsIndex:index];
+    }];
+    return intersects;
+}
+
+@end
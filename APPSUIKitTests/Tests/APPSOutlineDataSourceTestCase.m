@@ -0,0 +1,92 @@
+//
+//  APPSOutlineDataSourceTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+#import "APPSOutlineDataSource.h"
+
+
+@interface APPSOutlineDataSourceTestCase : XCTestCase
+@property (nonatomic, strong) APPSOutlineDataSource *dataSource;
+@end
+
+
+@implementation APPSOutlineDataSourceTestCase
+
+#pragma mark - Lifecycle
+
+- (void)setUp;
+{
+    [super setUp];
+
+    // a ─┬─ a1 ─── a1x
+    //    └─ a2
+    // b
+    NSDictionary *children = @{ @"a" : @[@"a1", @"a2"], @"a1" : @[@"a1x"] };
+    self.dataSource = [[APPSOutlineDataSource alloc] initWithChildrenBlock:^NSArray *(id item) {
+        return children[item];
+    }];
+
+    [self.dataSource performUpdate:^{
+        self.dataSource.rootItems = @[@"a", @"b"];
+    }];
+}
+
+
+- (void)tearDown;
+{
+    self.dataSource = nil;
+    [super tearDown];
+}
+
+
+
+#pragma mark - Tests
+
+#pragma mark * Method: -expandItem:
+
+- (void)test_expandItem__revealsChildrenInOrder;
+{
+    [self.dataSource expandItem:@"a"];
+
+    XCTAssertEqual([self.dataSource numberOfRowsInSection:0], 4);
+    XCTAssertEqualObjects([self visibleItems], (@[@"a", @"a1", @"a2", @"b"]));
+    XCTAssertEqualObjects([self.dataSource indexPathForItem:@"b"], [NSIndexPath indexPathForRow:3 inSection:0]);
+    XCTAssertNil([self.dataSource indexPathForItem:@"a1x"], @"A child of a collapsed item should not have a row.");
+}
+
+
+- (void)test_expandItem__restoresExpandedDescendants;
+{
+    [self.dataSource expandItem:@"a"];
+    [self.dataSource expandItem:@"a1"];
+    [self.dataSource collapseItem:@"a"];
+
+    XCTAssertEqualObjects([self visibleItems], (@[@"a", @"b"]));
+
+    [self.dataSource expandItem:@"a"];
+
+    XCTAssertEqualObjects([self visibleItems], (@[@"a", @"a1", @"a1x", @"a2", @"b"]));
+    XCTAssertEqual([self.dataSource depthOfItemAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]], (NSUInteger)2);
+}
+
+
+
+#pragma mark - Helper
+
+- (NSArray *)visibleItems;
+{
+    NSMutableArray *items = [NSMutableArray array];
+    NSInteger numberOfRows = [self.dataSource numberOfRowsInSection:0];
+    for (NSInteger row = 0; row < numberOfRows; ++row) {
+        [items addObject:[self.dataSource itemAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]]];
+    }
+    return items;
+}
+
+@end
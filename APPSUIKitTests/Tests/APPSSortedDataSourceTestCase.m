@@ -0,0 +1,127 @@
+//
+//  APPSSortedDataSourceTestCase.m
+//  APPSUIKit
+//
+//  Copyright © 2026 Appstronomy, LLC. All rights reserved.
+//
+
+@import XCTest;
+@import APPSUIKit;
+
+
+/// An item sorted by a value that can change. Equality is identity, so items with equal values stay distinguishable.
+@interface APPSSortedTestItem : NSObject
+@property (nonatomic) NSInteger value;
+@end
+
+@implementation APPSSortedTestItem
+
++ (instancetype)itemWithValue:(NSInteger)value;
+{
+    APPSSortedTestItem *item = [[self alloc] init];
+    item.value = value;
+    return item;
+}
+
+
+- (NSString *)description;
+{
+    return [NSString stringWithFormat:@"<%p %ld>", self, (long)self.value];
+}
+
+@end
+
+
+
+@interface APPSSortedDataSourceTestCase : XCTestCase
+@end
+
+
+@implementation APPSSortedDataSourceTestCase
+
+#pragma mark - Tests
+
+#pragma mark * Method: -addItem:, -addItems:, -repositionItemAtIndex:
+
+- (void)test_sortedChanges__randomChangesMatchReference;
+{
+    NSComparator comparator = [self valueComparator];
+    APPSSortedDataSource *dataSource = [[APPSSortedDataSource alloc] initWithComparator:comparator];
+    NSMutableArray *reference = [NSMutableArray array];
+
+    // Few distinct values, so most searches land in a run of equal items.
+    srand48(32);
+    for (NSUInteger step = 0; step < 300; ++step) {
+        NSUInteger count = reference.count;
+        switch (lrand48() % 4) {
+            case 0: {
+                APPSSortedTestItem *item = [APPSSortedTestItem itemWithValue:lrand48() % 10];
+                __block NSUInteger index = NSNotFound;
+                [dataSource performUpdate:^{
+                    index = [dataSource addItem:item];
+                }];
+                [self addItems:@[item] toReference:reference comparator:comparator];
+                XCTAssertEqual(index, [reference indexOfObjectIdenticalTo:item], @"Step %lu inserted at the wrong index.", (unsigned long)step);
+                break;
+            }
+            case 1: {
+                NSMutableArray *items = [NSMutableArray array];
+                for (NSUInteger itemCount = lrand48() % 12; itemCount > 0; --itemCount)
+                    [items addObject:[APPSSortedTestItem itemWithValue:lrand48() % 10]];
+                [dataSource performUpdate:^{
+                    [dataSource addItems:items];
+                }];
+                [self addItems:items toReference:reference comparator:comparator];
+                break;
+            }
+            case 2: {
+                if (!count)
+                    break;
+                NSUInteger index = lrand48() % count;
+                APPSSortedTestItem *item = reference[index];
+                item.value = lrand48() % 10;
+                [dataSource performUpdate:^{
+                    [dataSource repositionItemAtIndex:index];
+                }];
+                [reference removeObjectAtIndex:index];
+                [self addItems:@[item] toReference:reference comparator:comparator];
+                break;
+            }
+            default: {
+                if (!count)
+                    break;
+                APPSSortedTestItem *item = reference[lrand48() % count];
+                [dataSource performUpdate:^{
+                    [dataSource removeItem:item];
+                }];
+                [reference removeObjectIdenticalTo:item];
+                break;
+            }
+        }
+
+        XCTAssertEqualObjects(dataSource.items, reference, @"Step %lu left different items.", (unsigned long)step);
+    }
+}
+
+
+
+#pragma mark - Helper
+
+- (NSComparator)valueComparator;
+{
+    return ^NSComparisonResult(APPSSortedTestItem *item1, APPSSortedTestItem *item2) {
+        if (item1.value < item2.value)
+            return NSOrderedAscending;
+        return item1.value > item2.value ? NSOrderedDescending : NSOrderedSame;
+    };
+}
+
+
+/// Append items and stable-sort with the data source's comparator, so new items follow the existing items they compare equal to, in the order they were given.
+- (void)addItems:(NSArray *)items toReference:(NSMutableArray *)reference comparator:(NSComparator)comparator;
+{
+    [reference addObjectsFromArray:items];
+    [reference setArray:[reference sortedArrayWithOptions:NSSortStable usingComparator:comparator]];
+}
+
+@end